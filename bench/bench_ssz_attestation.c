@@ -10,6 +10,7 @@
 #include "ssz_constants.h"
 #include "yaml_parser.h"
 #include "ssz_merkle.h"
+#include "ssz_schema.h"
 #include "ssz_utils.h"
 
 #define YAML_FILE_PATH "./bench/data/Attestation/ssz_random/case_0/attestation.yaml"
@@ -52,6 +53,17 @@ typedef struct
     size_t capacity;
 } DynamicBuffer;
 
+static const ssz_type_desc_t bytes32_type = {SSZ_TYPE_VECTOR, 0, 32, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t signature_type = {SSZ_TYPE_VECTOR, 0, 96, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t aggregation_bits_type = {SSZ_TYPE_BITLIST, 0, MAX_VALIDATORS_PER_COMMITTEE, NULL, NULL};
+static const ssz_type_desc_t *const checkpoint_fields[] = {&ssz_type_uint64, &bytes32_type};
+static const ssz_type_desc_t checkpoint_type = {SSZ_TYPE_CONTAINER, 0, 2, NULL, checkpoint_fields};
+static const ssz_type_desc_t *const attestation_data_fields[] = {
+    &ssz_type_uint64, &ssz_type_uint64, &bytes32_type, &checkpoint_type, &checkpoint_type};
+static const ssz_type_desc_t attestation_data_type = {SSZ_TYPE_CONTAINER, 0, 5, NULL, attestation_data_fields};
+static const ssz_type_desc_t *const attestation_fields[] = {&aggregation_bits_type, &attestation_data_type, &signature_type};
+static const ssz_type_desc_t attestation_type = {SSZ_TYPE_CONTAINER, 0, 3, NULL, attestation_fields};
+
 static void db_init(DynamicBuffer *db)
 {
     db->data = NULL;
@@ -609,6 +621,26 @@ static ssz_error_t hash_tree_root_attestation(const Attestation *att, uint8_t *o
     return ssz_merkleize((uint8_t *)nodes, 3, 0, out_root);
 }
 
+static void attestation_bench_func_name_deserialize_root(void *user_data)
+{
+    (void)user_data;
+    Attestation tmp;
+    memset(&tmp, 0, sizeof(tmp));
+    if (deserialize_attestation(g_serialized, g_serialized_size, &tmp) == SSZ_SUCCESS)
+    {
+        uint8_t root[32];
+        hash_tree_root_attestation(&tmp, root);
+        free(tmp.aggregation_bits.data);
+    }
+}
+
+static void attestation_bench_func_name_root_serialized(void *user_data)
+{
+    (void)user_data;
+    uint8_t root[32];
+    ssz_hash_tree_root_serialized(&attestation_type, g_serialized, g_serialized_size, root);
+}
+
 static void print_attestation_tree(const Attestation *att)
 {
     uint8_t root_agg[32], root_data[32], root_signature[32], final_root[32];
@@ -664,6 +696,8 @@ int main(void)
     init_attestation_data_from_yaml();
     bench_stats_t stats_serialize = bench_run_benchmark(attestation_bench_func_name_serialize, NULL, BENCH_ITER_WARMUP, BENCH_ITER_MEASURED);
     bench_stats_t stats_deserialize = bench_run_benchmark(attestation_bench_func_name_deserialize, NULL, BENCH_ITER_WARMUP, BENCH_ITER_MEASURED);
+    bench_stats_t stats_deserialize_root = bench_run_benchmark(attestation_bench_func_name_deserialize_root, NULL, BENCH_ITER_WARMUP, BENCH_ITER_MEASURED);
+    bench_stats_t stats_root_serialized = bench_run_benchmark(attestation_bench_func_name_root_serialized, NULL, BENCH_ITER_WARMUP, BENCH_ITER_MEASURED);
     print_attestation(&g_original);
     uint8_t merkle_root[32];
     if (hash_tree_root_attestation(&g_original, merkle_root) == SSZ_SUCCESS)
@@ -675,9 +709,21 @@ int main(void)
     {
         printf("Failed to compute hash tree root\n");
     }
+    uint8_t serialized_root[32];
+    if (ssz_hash_tree_root_serialized(&attestation_type, g_serialized, g_serialized_size, serialized_root) == SSZ_SUCCESS &&
+        memcmp(serialized_root, merkle_root, 32) == 0)
+    {
+        printf("Root from serialized bytes matches\n");
+    }
+    else
+    {
+        printf("Root from serialized bytes does not match\n");
+    }
     printf("\nSerialized form:\n0x");
     print_hex(g_serialized, g_serialized_size);
     bench_print_stats("SSZ Attestation serialization", &stats_serialize);
     bench_print_stats("SSZ Attestation deserialization", &stats_deserialize);
+    bench_print_stats("SSZ Attestation deserialize + hash_tree_root", &stats_deserialize_root);
+    bench_print_stats("SSZ Attestation hash_tree_root from serialized bytes", &stats_root_serialized);
     return 0;
 }
\ No newline at end of file
@@ -1,19 +1,38 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "bench.h"
 #include "ssz_constants.h"
 #include "ssz_merkle.h"
+#include "ssz_merkle_tree.h"
+#include "ssz_hash.h"
 
 #define BENCH_ITER_WARMUP_MERKLEIZE 5000
 #define BENCH_ITER_MEASURED_MERKLEIZE 10000
+#define BENCH_ITER_WARMUP_MERKLEIZE_WIDE 20
+#define BENCH_ITER_MEASURED_MERKLEIZE_WIDE 200
+#define BENCH_MERKLEIZE_WIDE_CHUNKS 65536
+#define BENCH_ITER_WARMUP_MERKLE_TREE 500
+#define BENCH_ITER_MEASURED_MERKLE_TREE 5000
+#define BENCH_MERKLE_TREE_UPDATES 16
+#define BENCH_ITER_WARMUP_VERIFY_PROOFS 20
+#define BENCH_ITER_MEASURED_VERIFY_PROOFS 200
+#define BENCH_VERIFY_PROOFS_COUNT 4096
+#define BENCH_ITER_WARMUP_BASIC_LIST 50
+#define BENCH_ITER_MEASURED_BASIC_LIST 500
+#define BENCH_BASIC_LIST_VALUES 65536
+#define BENCH_ITER_WARMUP_MERKLEIZER 5000
+#define BENCH_ITER_MEASURED_MERKLEIZER 10000
 #define BENCH_ITER_WARMUP_PACK 5000
 #define BENCH_ITER_MEASURED_PACK 10000
 #define BENCH_ITER_WARMUP_PACK_BITS 5000
 #define BENCH_ITER_MEASURED_PACK_BITS 10000
 #define BENCH_ITER_WARMUP_MIX_LENGTH 5000
 #define BENCH_ITER_MEASURED_MIX_LENGTH 10000
+#define BENCH_ITER_WARMUP_HASH_PAIR 5000
+#define BENCH_ITER_MEASURED_HASH_PAIR 10000
 #define BENCH_ITER_WARMUP_MIX_SELECTOR 5000
 #define BENCH_ITER_MEASURED_MIX_SELECTOR 10000
 
@@ -23,6 +42,40 @@ typedef struct {
     size_t limit;
 } ssz_merkleize_test_t;
 
+typedef struct {
+    uint8_t *chunks;
+    size_t chunk_count;
+    unsigned int thread_count;
+} ssz_merkleize_wide_test_t;
+
+typedef struct {
+    ssz_merkle_tree_t tree;
+    uint8_t chunk[SSZ_BYTES_PER_CHUNK];
+    uint32_t state;
+} ssz_merkle_tree_test_t;
+
+typedef struct {
+    ssz_merkle_tree_t a;
+    ssz_merkle_tree_t b;
+    const uint8_t *chunks_a;
+    const uint8_t *chunks_b;
+    size_t chunk_count;
+    size_t changed;
+} ssz_merkle_tree_diff_test_t;
+
+typedef struct {
+    ssz_merkle_proof_t *proofs;
+    ssz_proof_batch_item_t *items;
+    bool *valid;
+    size_t count;
+} ssz_verify_proofs_test_t;
+
+typedef struct {
+    uint64_t *values;
+    uint8_t *chunks;
+    size_t count;
+} ssz_basic_list_test_t;
+
 typedef struct {
     uint8_t values[1024];
     size_t value_size;
@@ -50,6 +103,87 @@ static void test_merkleize(void *user_data) {
     ssz_merkleize(test->chunks, test->chunk_count, test->limit, out_root);
 }
 
+static void test_merkleize_wide(void *user_data) {
+    ssz_merkleize_wide_test_t *test = (ssz_merkleize_wide_test_t *)user_data;
+    uint8_t out_root[SSZ_BYTES_PER_CHUNK];
+    ssz_merkleize(test->chunks, test->chunk_count, test->chunk_count, out_root);
+}
+
+static void test_merkleize_parallel(void *user_data) {
+    ssz_merkleize_wide_test_t *test = (ssz_merkleize_wide_test_t *)user_data;
+    uint8_t out_root[SSZ_BYTES_PER_CHUNK];
+    ssz_merkleize_parallel(test->chunks, test->chunk_count, test->chunk_count, test->thread_count, out_root);
+}
+
+static void test_merkle_tree_update(void *user_data) {
+    ssz_merkle_tree_test_t *test = (ssz_merkle_tree_test_t *)user_data;
+    uint8_t out_root[SSZ_BYTES_PER_CHUNK];
+    for (int i = 0; i < BENCH_MERKLE_TREE_UPDATES; i++) {
+        test->state = test->state * 1103515245u + 12345u;
+        test->chunk[0] = (uint8_t)(test->state >> 24);
+        ssz_merkle_tree_set_chunk(&test->tree, test->state % test->tree.chunk_count, test->chunk);
+    }
+    ssz_merkle_tree_root(&test->tree, out_root);
+}
+
+static void count_diff(size_t chunk_index, void *user_data) {
+    (void)chunk_index;
+    (*(size_t *)user_data)++;
+}
+
+static void test_merkle_tree_diff(void *user_data) {
+    ssz_merkle_tree_diff_test_t *test = (ssz_merkle_tree_diff_test_t *)user_data;
+    test->changed = 0;
+    ssz_merkle_tree_diff(&test->a, &test->b, count_diff, &test->changed);
+}
+
+static void test_chunk_compare(void *user_data) {
+    ssz_merkle_tree_diff_test_t *test = (ssz_merkle_tree_diff_test_t *)user_data;
+    test->changed = 0;
+    for (size_t i = 0; i < test->chunk_count; i++) {
+        if (memcmp(test->chunks_a + i * SSZ_BYTES_PER_CHUNK, test->chunks_b + i * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK) != 0) {
+            test->changed++;
+        }
+    }
+}
+
+static void test_verify_proofs_sequential(void *user_data) {
+    ssz_verify_proofs_test_t *test = (ssz_verify_proofs_test_t *)user_data;
+    for (size_t i = 0; i < test->count; i++) {
+        const ssz_proof_batch_item_t *item = &test->items[i];
+        test->valid[i] = ssz_verify_proof(item->leaf, item->branch, item->depth, item->gindex, item->root);
+    }
+}
+
+static void test_verify_proofs_batch(void *user_data) {
+    ssz_verify_proofs_test_t *test = (ssz_verify_proofs_test_t *)user_data;
+    ssz_verify_proofs_batch(test->items, test->count, test->valid);
+}
+
+static void test_basic_list_pack_merkleize(void *user_data) {
+    ssz_basic_list_test_t *test = (ssz_basic_list_test_t *)user_data;
+    uint8_t out_root[SSZ_BYTES_PER_CHUNK];
+    size_t chunk_count = 0;
+    ssz_pack((const uint8_t *)test->values, sizeof(uint64_t), test->count, test->chunks, &chunk_count);
+    ssz_merkleize(test->chunks, chunk_count, ((size_t)1 << 40) / 4, out_root);
+    ssz_mix_in_length(out_root, test->count, out_root);
+}
+
+static void test_basic_list_fused(void *user_data) {
+    ssz_basic_list_test_t *test = (ssz_basic_list_test_t *)user_data;
+    uint8_t out_root[SSZ_BYTES_PER_CHUNK];
+    ssz_hash_tree_root_basic_list(test->values, sizeof(uint64_t), test->count, (size_t)1 << 40, out_root);
+}
+
+static void test_merkleizer(void *user_data) {
+    ssz_merkleize_test_t *test = (ssz_merkleize_test_t *)user_data;
+    uint8_t out_root[SSZ_BYTES_PER_CHUNK];
+    ssz_merkleizer_t m;
+    ssz_merkleizer_init(&m, test->limit);
+    ssz_merkleizer_push_chunks(&m, test->chunks, test->chunk_count);
+    ssz_merkleizer_finalize(&m, out_root);
+}
+
 static void test_pack(void *user_data) {
     ssz_pack_test_t *test = (ssz_pack_test_t *)user_data;
     uint8_t out_chunks[2048];
@@ -64,6 +198,19 @@ static void test_pack_bits(void *user_data) {
     ssz_pack_bits(test->bits, test->bit_count, out_chunks, &out_chunk_count);
 }
 
+static void test_hash_pair(void *user_data) {
+    ssz_mix_length_test_t *test = (ssz_mix_length_test_t *)user_data;
+    ssz_hash_pair(test->root, test->root, test->root);
+}
+
+static void test_sha256_64(void *user_data) {
+    ssz_mix_length_test_t *test = (ssz_mix_length_test_t *)user_data;
+    uint8_t pair[2 * SSZ_BYTES_PER_CHUNK];
+    memcpy(pair, test->root, SSZ_BYTES_PER_CHUNK);
+    memcpy(pair + SSZ_BYTES_PER_CHUNK, test->root, SSZ_BYTES_PER_CHUNK);
+    ssz_sha256(pair, sizeof(pair), test->root);
+}
+
 static void test_mix_in_length(void *user_data) {
     ssz_mix_length_test_t *test = (ssz_mix_length_test_t *)user_data;
     uint8_t out_root[SSZ_BYTES_PER_CHUNK];
@@ -83,6 +230,151 @@ static void run_merkleize_benchmarks(void) {
     test_data.limit = 64;
     bench_stats_t stats = bench_run_benchmark(test_merkleize, &test_data, BENCH_ITER_WARMUP_MERKLEIZE, BENCH_ITER_MEASURED_MERKLEIZE);
     bench_print_stats("Benchmark ssz_merkleize", &stats);
+
+    ssz_hash_backend_t selected = ssz_hash_get_backend();
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT; b++) {
+        if (ssz_hash_set_backend((ssz_hash_backend_t)b) != SSZ_SUCCESS) {
+            continue;
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "Benchmark ssz_merkleize (%s)", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        stats = bench_run_benchmark(test_merkleize, &test_data, BENCH_ITER_WARMUP_MERKLEIZE, BENCH_ITER_MEASURED_MERKLEIZE);
+        bench_print_stats(label, &stats);
+    }
+    ssz_hash_set_backend(selected);
+}
+
+static void run_merkleize_wide_benchmarks(void) {
+    ssz_merkleize_wide_test_t test_data;
+    test_data.chunk_count = BENCH_MERKLEIZE_WIDE_CHUNKS;
+    test_data.chunks = malloc(test_data.chunk_count * SSZ_BYTES_PER_CHUNK);
+    if (!test_data.chunks) {
+        return;
+    }
+    for (size_t i = 0; i < test_data.chunk_count * SSZ_BYTES_PER_CHUNK; i++) {
+        test_data.chunks[i] = (uint8_t)(i * 31 + 7);
+    }
+    ssz_hash_backend_t selected = ssz_hash_get_backend();
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT; b++) {
+        if (ssz_hash_set_backend((ssz_hash_backend_t)b) != SSZ_SUCCESS) {
+            continue;
+        }
+        char label[96];
+        snprintf(label, sizeof(label), "Benchmark ssz_merkleize 65536 chunks (%s)", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        bench_stats_t stats = bench_run_benchmark(test_merkleize_wide, &test_data, BENCH_ITER_WARMUP_MERKLEIZE_WIDE, BENCH_ITER_MEASURED_MERKLEIZE_WIDE);
+        bench_print_stats(label, &stats);
+    }
+    ssz_hash_set_backend(selected);
+
+    static const unsigned int thread_counts[] = {2, 4, 8};
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        char label[96];
+        test_data.thread_count = thread_counts[i];
+        snprintf(label, sizeof(label), "Benchmark ssz_merkleize_parallel 65536 chunks (%u threads)", thread_counts[i]);
+        bench_stats_t stats = bench_run_benchmark(test_merkleize_parallel, &test_data, BENCH_ITER_WARMUP_MERKLEIZE_WIDE, BENCH_ITER_MEASURED_MERKLEIZE_WIDE);
+        bench_print_stats(label, &stats);
+    }
+    free(test_data.chunks);
+}
+
+static void run_merkle_tree_benchmarks(void) {
+    size_t chunk_count = BENCH_MERKLEIZE_WIDE_CHUNKS;
+    uint8_t *chunks = malloc(chunk_count * SSZ_BYTES_PER_CHUNK);
+    if (!chunks) {
+        return;
+    }
+    memset(chunks, 0x5A, chunk_count * SSZ_BYTES_PER_CHUNK);
+    ssz_merkle_tree_test_t test_data;
+    memset(test_data.chunk, 0x33, sizeof(test_data.chunk));
+    test_data.state = 1;
+    if (ssz_merkle_tree_init(&test_data.tree, chunks, chunk_count, chunk_count) == SSZ_SUCCESS) {
+        bench_stats_t stats = bench_run_benchmark(test_merkle_tree_update, &test_data, BENCH_ITER_WARMUP_MERKLE_TREE, BENCH_ITER_MEASURED_MERKLE_TREE);
+        bench_print_stats("Benchmark ssz_merkle_tree 16 updates + root, 65536 chunks", &stats);
+        ssz_merkle_tree_free(&test_data.tree);
+    }
+
+    uint8_t *changed_chunks = malloc(chunk_count * SSZ_BYTES_PER_CHUNK);
+    if (changed_chunks) {
+        memcpy(changed_chunks, chunks, chunk_count * SSZ_BYTES_PER_CHUNK);
+        for (size_t i = 0; i < BENCH_MERKLE_TREE_UPDATES; i++) {
+            changed_chunks[(i * 4099 % chunk_count) * SSZ_BYTES_PER_CHUNK] ^= 0xFF;
+        }
+        ssz_merkle_tree_diff_test_t diff_data = {.chunks_a = chunks, .chunks_b = changed_chunks, .chunk_count = chunk_count};
+        if (ssz_merkle_tree_init(&diff_data.a, chunks, chunk_count, chunk_count) == SSZ_SUCCESS) {
+            if (ssz_merkle_tree_init(&diff_data.b, changed_chunks, chunk_count, chunk_count) == SSZ_SUCCESS) {
+                bench_stats_t stats_diff = bench_run_benchmark(test_merkle_tree_diff, &diff_data, BENCH_ITER_WARMUP_MERKLE_TREE, BENCH_ITER_MEASURED_MERKLE_TREE);
+                bench_stats_t stats_compare = bench_run_benchmark(test_chunk_compare, &diff_data, BENCH_ITER_WARMUP_MERKLE_TREE, BENCH_ITER_MEASURED_MERKLE_TREE);
+                bench_print_stats("Benchmark ssz_merkle_tree_diff, 16 of 65536 chunks changed", &stats_diff);
+                bench_print_stats("Benchmark chunk-by-chunk memcmp, 16 of 65536 chunks changed", &stats_compare);
+                ssz_merkle_tree_free(&diff_data.b);
+            }
+            ssz_merkle_tree_free(&diff_data.a);
+        }
+        free(changed_chunks);
+    }
+    free(chunks);
+}
+
+static void run_verify_proofs_benchmarks(void) {
+    size_t chunk_count = BENCH_MERKLEIZE_WIDE_CHUNKS;
+    uint8_t *chunks = malloc(chunk_count * SSZ_BYTES_PER_CHUNK);
+    ssz_verify_proofs_test_t test_data;
+    test_data.count = BENCH_VERIFY_PROOFS_COUNT;
+    test_data.proofs = malloc(test_data.count * sizeof(ssz_merkle_proof_t));
+    test_data.items = malloc(test_data.count * sizeof(ssz_proof_batch_item_t));
+    test_data.valid = malloc(test_data.count * sizeof(bool));
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    if (chunks && test_data.proofs && test_data.items && test_data.valid) {
+        for (size_t i = 0; i < chunk_count * SSZ_BYTES_PER_CHUNK; i++) {
+            chunks[i] = (uint8_t)(i * 31 + 7);
+        }
+        ssz_merkleize(chunks, chunk_count, chunk_count, root);
+        uint32_t state = 1;
+        for (size_t i = 0; i < test_data.count; i++) {
+            state = state * 1103515245u + 12345u;
+            ssz_generate_proof(chunks, chunk_count, chunk_count, chunk_count + (state >> 8) % chunk_count, &test_data.proofs[i]);
+            test_data.items[i].leaf = test_data.proofs[i].leaf;
+            test_data.items[i].branch = &test_data.proofs[i].branch[0][0];
+            test_data.items[i].depth = test_data.proofs[i].depth;
+            test_data.items[i].gindex = test_data.proofs[i].gindex;
+            test_data.items[i].root = root;
+        }
+        bench_stats_t stats = bench_run_benchmark(test_verify_proofs_sequential, &test_data, BENCH_ITER_WARMUP_VERIFY_PROOFS, BENCH_ITER_MEASURED_VERIFY_PROOFS);
+        bench_print_stats("Benchmark ssz_verify_proof x4096, 65536-chunk tree", &stats);
+        stats = bench_run_benchmark(test_verify_proofs_batch, &test_data, BENCH_ITER_WARMUP_VERIFY_PROOFS, BENCH_ITER_MEASURED_VERIFY_PROOFS);
+        bench_print_stats("Benchmark ssz_verify_proofs_batch 4096, 65536-chunk tree", &stats);
+    }
+    free(chunks);
+    free(test_data.proofs);
+    free(test_data.items);
+    free(test_data.valid);
+}
+
+static void run_basic_list_benchmarks(void) {
+    ssz_basic_list_test_t test_data;
+    test_data.count = BENCH_BASIC_LIST_VALUES;
+    test_data.values = malloc(test_data.count * sizeof(uint64_t));
+    test_data.chunks = malloc(test_data.count * sizeof(uint64_t) + SSZ_BYTES_PER_CHUNK);
+    if (test_data.values && test_data.chunks) {
+        for (size_t i = 0; i < test_data.count; i++) {
+            test_data.values[i] = 32000000000ULL + i * 7919;
+        }
+        bench_stats_t stats = bench_run_benchmark(test_basic_list_pack_merkleize, &test_data, BENCH_ITER_WARMUP_BASIC_LIST, BENCH_ITER_MEASURED_BASIC_LIST);
+        bench_print_stats("Benchmark uint64 list root via ssz_pack + ssz_merkleize, 65536 values", &stats);
+        stats = bench_run_benchmark(test_basic_list_fused, &test_data, BENCH_ITER_WARMUP_BASIC_LIST, BENCH_ITER_MEASURED_BASIC_LIST);
+        bench_print_stats("Benchmark ssz_hash_tree_root_basic_list, 65536 uint64 values", &stats);
+    }
+    free(test_data.values);
+    free(test_data.chunks);
+}
+
+static void run_merkleizer_benchmarks(void) {
+    ssz_merkleize_test_t test_data;
+    memset(test_data.chunks, 0xAA, sizeof(test_data.chunks));
+    test_data.chunk_count = 64;
+    test_data.limit = 64;
+    bench_stats_t stats = bench_run_benchmark(test_merkleizer, &test_data, BENCH_ITER_WARMUP_MERKLEIZER, BENCH_ITER_MEASURED_MERKLEIZER);
+    bench_print_stats("Benchmark ssz_merkleizer", &stats);
 }
 
 static void run_pack_benchmarks(void) {
@@ -104,6 +396,25 @@ static void run_pack_bits_benchmarks(void) {
     bench_print_stats("Benchmark ssz_pack_bits", &stats);
 }
 
+static void run_hash_pair_benchmarks(void) {
+    ssz_mix_length_test_t test_data;
+    memset(test_data.root, 0xBB, sizeof(test_data.root));
+    ssz_hash_backend_t selected = ssz_hash_get_backend();
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT; b++) {
+        if (ssz_hash_set_backend((ssz_hash_backend_t)b) != SSZ_SUCCESS) {
+            continue;
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "Benchmark ssz_sha256 64 bytes (%s)", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        bench_stats_t stats = bench_run_benchmark(test_sha256_64, &test_data, BENCH_ITER_WARMUP_HASH_PAIR, BENCH_ITER_MEASURED_HASH_PAIR);
+        bench_print_stats(label, &stats);
+        snprintf(label, sizeof(label), "Benchmark ssz_hash_pair (%s)", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        stats = bench_run_benchmark(test_hash_pair, &test_data, BENCH_ITER_WARMUP_HASH_PAIR, BENCH_ITER_MEASURED_HASH_PAIR);
+        bench_print_stats(label, &stats);
+    }
+    ssz_hash_set_backend(selected);
+}
+
 static void run_mix_in_length_benchmarks(void) {
     ssz_mix_length_test_t test_data;
     memset(test_data.root, 0xBB, sizeof(test_data.root));
@@ -122,8 +433,14 @@ static void run_mix_in_selector_benchmarks(void) {
 
 static void run_all_benchmarks(void) {
     run_merkleize_benchmarks();
+    run_merkleize_wide_benchmarks();
+    run_merkle_tree_benchmarks();
+    run_verify_proofs_benchmarks();
+    run_basic_list_benchmarks();
+    run_merkleizer_benchmarks();
     run_pack_benchmarks();
     run_pack_bits_benchmarks();
+    run_hash_pair_benchmarks();
     run_mix_in_length_benchmarks();
     run_mix_in_selector_benchmarks();
 }
@@ -1,9 +1,12 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "bench.h"
 #include "ssz_serialize.h"
+#include "ssz_deserialize.h"
+#include "ssz_bits.h"
 
 #define BENCH_ITER_WARMUP_UINTN 50000
 #define BENCH_ITER_MEASURED_UINTN 100000
@@ -17,6 +20,10 @@
 #define BENCH_ITER_MEASURED_VECTOR 10000
 #define BENCH_ITER_WARMUP_LIST 5000
 #define BENCH_ITER_MEASURED_LIST 10000
+#define BENCH_ITER_WARMUP_BITS_KERNEL_SMALL 50000
+#define BENCH_ITER_MEASURED_BITS_KERNEL_SMALL 100000
+#define BENCH_ITER_WARMUP_BITS_KERNEL_LARGE 100
+#define BENCH_ITER_MEASURED_BITS_KERNEL_LARGE 1000
 
 typedef struct
 {
@@ -192,6 +199,26 @@ static void test_bitlist_serialize(void *user_data)
     ssz_serialize_bitlist(test_data->bits, test_data->num_bits, out_buf, &out_size);
 }
 
+typedef struct
+{
+    bool *bits;
+    uint8_t *bytes;
+    size_t num_bits;
+} ssz_bits_kernel_test_t;
+
+static void test_bits_kernel_pack(void *user_data)
+{
+    ssz_bits_kernel_test_t *test_data = (ssz_bits_kernel_test_t *)user_data;
+    size_t out_size = (test_data->num_bits + 7) / 8;
+    ssz_serialize_bitvector(test_data->bits, test_data->num_bits, test_data->bytes, &out_size);
+}
+
+static void test_bits_kernel_unpack(void *user_data)
+{
+    ssz_bits_kernel_test_t *test_data = (ssz_bits_kernel_test_t *)user_data;
+    ssz_deserialize_bitvector(test_data->bytes, (test_data->num_bits + 7) / 8, test_data->num_bits, test_data->bits);
+}
+
 static void test_vector_uint8_serialize(void *user_data)
 {
     ssz_vector_test_uint8 *test_data = (ssz_vector_test_uint8 *)user_data;
@@ -381,6 +408,50 @@ static void run_bitlist_benchmarks(void)
     bench_print_stats("Benchmark ssz_serialize_bitlist", &stats);
 }
 
+static void run_bits_kernel_benchmarks(void)
+{
+    static const size_t sizes[] = {2048, 1 << 20};
+    ssz_bits_backend_t selected = ssz_bits_get_backend();
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        ssz_bits_kernel_test_t test_data;
+        test_data.num_bits = sizes[s];
+        test_data.bits = malloc(test_data.num_bits * sizeof(bool));
+        test_data.bytes = malloc((test_data.num_bits + 7) / 8);
+        if (!test_data.bits || !test_data.bytes)
+        {
+            free(test_data.bits);
+            free(test_data.bytes);
+            continue;
+        }
+        for (size_t i = 0; i < test_data.num_bits; i++)
+        {
+            test_data.bits[i] = (i * 7 + i / 3) % 5 < 2;
+        }
+        unsigned long warmup = s == 0 ? BENCH_ITER_WARMUP_BITS_KERNEL_SMALL : BENCH_ITER_WARMUP_BITS_KERNEL_LARGE;
+        unsigned long measured = s == 0 ? BENCH_ITER_MEASURED_BITS_KERNEL_SMALL : BENCH_ITER_MEASURED_BITS_KERNEL_LARGE;
+        for (int b = 0; b < SSZ_BITS_BACKEND_COUNT; b++)
+        {
+            if (ssz_bits_set_backend((ssz_bits_backend_t)b) != SSZ_SUCCESS)
+            {
+                continue;
+            }
+            char label[128];
+            bench_stats_t stats = bench_run_benchmark(test_bits_kernel_pack, &test_data, warmup, measured);
+            snprintf(label, sizeof(label), "Benchmark ssz_serialize_bitvector %zu bits (%s)",
+                     test_data.num_bits, ssz_bits_backend_name((ssz_bits_backend_t)b));
+            bench_print_stats(label, &stats);
+            stats = bench_run_benchmark(test_bits_kernel_unpack, &test_data, warmup, measured);
+            snprintf(label, sizeof(label), "Benchmark ssz_deserialize_bitvector %zu bits (%s)",
+                     test_data.num_bits, ssz_bits_backend_name((ssz_bits_backend_t)b));
+            bench_print_stats(label, &stats);
+        }
+        free(test_data.bits);
+        free(test_data.bytes);
+    }
+    ssz_bits_set_backend(selected);
+}
+
 static void run_vector_benchmarks(void)
 {
     ssz_vector_test_uint8 test_u8;
@@ -539,6 +610,7 @@ static void run_all_benchmarks(void)
     run_boolean_benchmarks();
     run_bitvector_benchmarks();
     run_bitlist_benchmarks();
+    run_bits_kernel_benchmarks();
     run_vector_benchmarks();
     run_list_benchmarks();
 }
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "bench.h"
+#include "ssz_serialize.h"
+#include "ssz_constants.h"
+#include "ssz_generator.h"
+
+#define BENCH_VALIDATOR_COUNT 1000000
+#define BENCH_ITER_WARMUP_VALIDATORS 2
+#define BENCH_ITER_MEASURED_VALIDATORS 10
+
+#define SIZE_BLS_PUBKEY 48
+#define SIZE_ROOT 32
+#define SIZE_VALIDATOR (SIZE_BLS_PUBKEY + SIZE_ROOT + 5 * SSZ_BYTE_SIZE_OF_UINT64 + 1)
+
+typedef struct
+{
+    uint8_t pubkey[SIZE_BLS_PUBKEY];
+    uint8_t withdrawal_credentials[SIZE_ROOT];
+    uint64_t effective_balance;
+    bool slashed;
+    uint64_t activation_eligibility_epoch;
+    uint64_t activation_epoch;
+    uint64_t exit_epoch;
+    uint64_t withdrawable_epoch;
+} Validator;
+
+typedef struct
+{
+    uint64_t length;
+    Validator *data;
+} Validators;
+
+#define SERIALIZE_VALIDATOR_FIELD                                                                                    \
+    SERIALIZE_VECTOR_FIELD(obj, offset, pubkey, SIZE_BLS_PUBKEY, ssz_serialize_vector_uint8);                        \
+    SERIALIZE_VECTOR_FIELD(obj, offset, withdrawal_credentials, SIZE_ROOT, ssz_serialize_vector_uint8);              \
+    SERIALIZE_BASIC_FIELD(obj, offset, effective_balance, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);            \
+    SERIALIZE_BASIC_FIELD(obj, offset, slashed, 1, ssz_serialize_boolean);                                           \
+    SERIALIZE_BASIC_FIELD(obj, offset, activation_eligibility_epoch, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64); \
+    SERIALIZE_BASIC_FIELD(obj, offset, activation_epoch, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);             \
+    SERIALIZE_BASIC_FIELD(obj, offset, exit_epoch, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);                   \
+    SERIALIZE_BASIC_FIELD(obj, offset, withdrawable_epoch, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);
+DEFINE_SERIALIZE_CONTAINER(Validator, SERIALIZE_VALIDATOR_FIELD);
+DEFINE_SERIALIZE_LIST(Validators, Validator, SIZE_VALIDATOR, serialize_Validator);
+DEFINE_SERIALIZE_LIST_PARALLEL(Validators, Validator, SIZE_VALIDATOR, serialize_Validator);
+
+typedef struct
+{
+    Validators validators;
+    uint8_t *out_buf;
+    size_t out_size;
+    unsigned int thread_count;
+} validators_test_t;
+
+static void test_validators_serialize(void *user_data)
+{
+    validators_test_t *test = (validators_test_t *)user_data;
+    size_t out_size = test->out_size;
+    serialize_Validators(&test->validators, test->out_buf, &out_size);
+}
+
+static void test_validators_serialize_parallel(void *user_data)
+{
+    validators_test_t *test = (validators_test_t *)user_data;
+    size_t out_size = test->out_size;
+    serialize_Validators_parallel(&test->validators, test->thread_count, test->out_buf, &out_size);
+}
+
+static void run_validators_benchmarks(void)
+{
+    validators_test_t test_data;
+    test_data.validators.length = BENCH_VALIDATOR_COUNT;
+    test_data.validators.data = malloc((size_t)BENCH_VALIDATOR_COUNT * sizeof(Validator));
+    test_data.out_size = (size_t)BENCH_VALIDATOR_COUNT * SIZE_VALIDATOR;
+    test_data.out_buf = malloc(test_data.out_size);
+    uint8_t *reference = malloc(test_data.out_size);
+    if (!test_data.validators.data || !test_data.out_buf || !reference)
+    {
+        free(test_data.validators.data);
+        free(test_data.out_buf);
+        free(reference);
+        return;
+    }
+    for (size_t i = 0; i < BENCH_VALIDATOR_COUNT; i++)
+    {
+        Validator *v = &test_data.validators.data[i];
+        memset(v->pubkey, (int)(i * 7), sizeof(v->pubkey));
+        memset(v->withdrawal_credentials, (int)(i * 11), sizeof(v->withdrawal_credentials));
+        v->effective_balance = 32000000000ull;
+        v->slashed = (i % 101) == 0;
+        v->activation_eligibility_epoch = i;
+        v->activation_epoch = i + 1;
+        v->exit_epoch = UINT64_MAX;
+        v->withdrawable_epoch = UINT64_MAX;
+    }
+
+    bench_stats_t baseline = bench_run_benchmark(test_validators_serialize, &test_data, BENCH_ITER_WARMUP_VALIDATORS, BENCH_ITER_MEASURED_VALIDATORS);
+    bench_print_stats("Benchmark serialize_Validators 1M validators", &baseline);
+    memcpy(reference, test_data.out_buf, test_data.out_size);
+
+    static const unsigned int thread_counts[] = {1, 2, 4, 8, 16};
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++)
+    {
+        char label[96];
+        test_data.thread_count = thread_counts[i];
+        memset(test_data.out_buf, 0, test_data.out_size);
+        snprintf(label, sizeof(label), "Benchmark serialize_Validators_parallel 1M validators (%u threads)", thread_counts[i]);
+        bench_stats_t stats = bench_run_benchmark(test_validators_serialize_parallel, &test_data, BENCH_ITER_WARMUP_VALIDATORS, BENCH_ITER_MEASURED_VALIDATORS);
+        bench_print_stats(label, &stats);
+        printf("Speedup over serialize_Validators: %.2fx, output %s\n", baseline.avg_time_ns / stats.avg_time_ns,
+               memcmp(test_data.out_buf, reference, test_data.out_size) == 0 ? "identical" : "DIFFERS");
+    }
+
+    free(test_data.validators.data);
+    free(test_data.out_buf);
+    free(reference);
+}
+
+int main(void)
+{
+    run_validators_benchmarks();
+    return 0;
+}
@@ -0,0 +1,165 @@
+#ifndef SSZ_BITFIELD_H
+#define SSZ_BITFIELD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+#include "ssz_constants.h"
+
+/** Number of bits held by one word of an ssz_bitfield_t. */
+#define SSZ_BITFIELD_WORD_BITS 64
+
+/** Number of words needed to hold a given number of bits. */
+#define SSZ_BITFIELD_WORDS(bits) (((size_t)(bits) + SSZ_BITFIELD_WORD_BITS - 1) / SSZ_BITFIELD_WORD_BITS)
+
+/**
+ * Represents a bitvector or bitlist packed into 64-bit words.
+ *
+ * Bit i is bit i % 64 of words[i / 64], so on little-endian hosts the words hold exactly the
+ * SSZ encoding of the bits (without the bitlist delimiter) and serialization is a memcpy. Bits
+ * past length are always zero. This takes one eighth of the memory of a bool per bit.
+ */
+typedef struct
+{
+    uint64_t *words;    /**< SSZ_BITFIELD_WORDS(length) words, or NULL when length is 0. */
+    size_t length;      /**< Number of bits. */
+} ssz_bitfield_t;
+
+/**
+ * Initializes a bitfield of a given length with every bit cleared.
+ *
+ * @param bf Pointer to the bitfield to initialize.
+ * @param length Number of bits.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if allocation fails.
+ */
+ssz_error_t ssz_bitfield_init(
+    ssz_bitfield_t *bf,
+    size_t length);
+
+/**
+ * Releases the memory held by a bitfield and sets its length to 0.
+ *
+ * @param bf Pointer to the bitfield.
+ */
+void ssz_bitfield_free(ssz_bitfield_t *bf);
+
+/**
+ * Reads one bit of a bitfield.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param index Index of the bit; must be below bf->length.
+ * @return The value of the bit.
+ */
+static inline bool ssz_bitfield_get(const ssz_bitfield_t *bf, size_t index)
+{
+    return (bf->words[index / SSZ_BITFIELD_WORD_BITS] >> (index % SSZ_BITFIELD_WORD_BITS)) & 1;
+}
+
+/**
+ * Writes one bit of a bitfield.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param index Index of the bit; must be below bf->length.
+ * @param value The new value of the bit.
+ */
+static inline void ssz_bitfield_set(ssz_bitfield_t *bf, size_t index, bool value)
+{
+    uint64_t mask = 1ULL << (index % SSZ_BITFIELD_WORD_BITS);
+    if (value)
+    {
+        bf->words[index / SSZ_BITFIELD_WORD_BITS] |= mask;
+    }
+    else
+    {
+        bf->words[index / SSZ_BITFIELD_WORD_BITS] &= ~mask;
+    }
+}
+
+/**
+ * Serializes a bitfield as a bitvector of bf->length bits.
+ *
+ * @param bf Pointer to the bitfield; its length must be non-zero.
+ * @param out_buf Pointer to the output buffer to write the serialized data.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes written.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on failure.
+ */
+ssz_error_t ssz_serialize_bitfield_vector(
+    const ssz_bitfield_t *bf,
+    uint8_t *out_buf,
+    size_t *out_size);
+
+/**
+ * Serializes a bitfield as a bitlist, appending the delimiter bit.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param out_buf Pointer to the output buffer to write the serialized data.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes written.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on failure.
+ */
+ssz_error_t ssz_serialize_bitfield_list(
+    const ssz_bitfield_t *bf,
+    uint8_t *out_buf,
+    size_t *out_size);
+
+/**
+ * Deserializes a bitvector of a specified length into a newly allocated bitfield.
+ *
+ * @param buffer Pointer to the input buffer containing the serialized data.
+ * @param buffer_size The size of the input buffer in bytes; must be ceil(num_bits / 8).
+ * @param num_bits The number of bits in the bitvector; must be non-zero.
+ * @param out_bf Pointer to the bitfield to initialize; free it with ssz_bitfield_free.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the size is wrong, padding
+ *         bits are set or allocation fails.
+ */
+ssz_error_t ssz_deserialize_bitfield_vector(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t num_bits,
+    ssz_bitfield_t *out_bf);
+
+/**
+ * Deserializes a bitlist into a newly allocated bitfield, dropping the delimiter bit.
+ *
+ * Only the words needed for the actual length are allocated, not max_bits.
+ *
+ * @param buffer Pointer to the input buffer containing the serialized data.
+ * @param buffer_size The size of the input buffer in bytes.
+ * @param max_bits The maximum number of bits in the bitlist.
+ * @param out_bf Pointer to the bitfield to initialize; free it with ssz_bitfield_free.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the delimiter is missing,
+ *         the bitlist is longer than max_bits or allocation fails.
+ */
+ssz_error_t ssz_deserialize_bitfield_list(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t max_bits,
+    ssz_bitfield_t *out_bf);
+
+/**
+ * Computes the hash tree root of a bitfield as a bitvector of bf->length bits.
+ *
+ * On little-endian hosts full chunks are merkleized straight from the words.
+ *
+ * @param bf Pointer to the bitfield; its length must be non-zero.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on failure.
+ */
+ssz_error_t ssz_hash_tree_root_bitfield_vector(
+    const ssz_bitfield_t *bf,
+    uint8_t *out_root);
+
+/**
+ * Computes the hash tree root of a bitfield as a bitlist, mixing in its length.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param max_bits Maximum number of bits in the bitlist; must be at least bf->length.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on failure.
+ */
+ssz_error_t ssz_hash_tree_root_bitfield_list(
+    const ssz_bitfield_t *bf,
+    size_t max_bits,
+    uint8_t *out_root);
+
+#endif /* SSZ_BITFIELD_H */
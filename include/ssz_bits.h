@@ -0,0 +1,154 @@
+#ifndef SSZ_BITS_H
+#define SSZ_BITS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+
+/**
+ * Enumerates the kernels available for converting between bool arrays and packed bits and for
+ * the bitwise bitlist operations. The scalar kernel is portable C and is always available; the
+ * SIMD kernels pack with a byte compare and movemask and unpack with a broadcast, bit mask and
+ * compare.
+ */
+typedef enum
+{
+    SSZ_BITS_BACKEND_SCALAR,    /**< Portable C, eight bits per step. */
+    SSZ_BITS_BACKEND_SSE2,      /**< x86 SSE2, sixteen bits per step. */
+    SSZ_BITS_BACKEND_AVX2,      /**< x86 AVX2, thirty-two bits per step. */
+    SSZ_BITS_BACKEND_NEON,      /**< AArch64 NEON, sixteen bits per step. */
+    SSZ_BITS_BACKEND_COUNT      /**< Number of backends; not a valid backend. */
+} ssz_bits_backend_t;
+
+/**
+ * Packs an array of booleans into bytes, least significant bit first.
+ *
+ * Exactly ceil(num_bits / 8) bytes are written and the unused high bits of the last byte are
+ * cleared. On first use the fastest kernel supported by the running CPU is selected.
+ *
+ * @param bits Pointer to num_bits booleans.
+ * @param num_bits Number of bits to pack.
+ * @param out_bytes Output buffer of at least ceil(num_bits / 8) bytes.
+ */
+void ssz_bits_pack(
+    const bool *bits,
+    size_t num_bits,
+    uint8_t *out_bytes);
+
+/**
+ * Unpacks bytes into an array of booleans, least significant bit first.
+ *
+ * Exactly num_bits booleans are written; bits of the last byte past num_bits are ignored.
+ *
+ * @param bytes Pointer to at least ceil(num_bits / 8) bytes.
+ * @param num_bits Number of bits to unpack.
+ * @param out_bits Output buffer of at least num_bits booleans.
+ */
+void ssz_bits_unpack(
+    const uint8_t *bytes,
+    size_t num_bits,
+    bool *out_bits);
+
+/**
+ * Computes the union (bitwise OR) of two serialized bitlists of the same length.
+ *
+ * The bitlists stay in wire format: both delimiters sit at the same bit, so the result is a
+ * valid serialized bitlist of the same length. This is the aggregation of attestation bits.
+ *
+ * @param a Pointer to the first serialized bitlist.
+ * @param b Pointer to the second serialized bitlist.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out Output buffer of byte_count bytes; may alias a or b.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+ssz_error_t ssz_bitlist_union(
+    const uint8_t *a,
+    const uint8_t *b,
+    size_t byte_count,
+    uint8_t *out);
+
+/**
+ * Tests whether two serialized bitlists of the same length have a data bit set in both.
+ *
+ * The delimiter is not counted as a common bit.
+ *
+ * @param a Pointer to the first serialized bitlist.
+ * @param b Pointer to the second serialized bitlist.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out_result Pointer to store true if the bitlists overlap.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+ssz_error_t ssz_bitlist_intersects(
+    const uint8_t *a,
+    const uint8_t *b,
+    size_t byte_count,
+    bool *out_result);
+
+/**
+ * Tests whether every bit set in one serialized bitlist is also set in another of the same length.
+ *
+ * @param a Pointer to the candidate subset.
+ * @param b Pointer to the candidate superset.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out_result Pointer to store true if a is a subset of b.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+ssz_error_t ssz_bitlist_is_subset(
+    const uint8_t *a,
+    const uint8_t *b,
+    size_t byte_count,
+    bool *out_result);
+
+/**
+ * Counts the set data bits of a serialized bitlist; the delimiter is not counted.
+ *
+ * @param bytes Pointer to the serialized bitlist.
+ * @param byte_count Number of serialized bytes.
+ * @param out_count Pointer to store the number of set bits.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the delimiter is missing.
+ */
+ssz_error_t ssz_bitlist_popcount(
+    const uint8_t *bytes,
+    size_t byte_count,
+    size_t *out_count);
+
+/**
+ * Checks whether a kernel is compiled in and supported by the running CPU.
+ *
+ * @param backend The backend to check.
+ * @return true if the backend can be selected, otherwise false.
+ */
+bool ssz_bits_backend_available(ssz_bits_backend_t backend);
+
+/**
+ * Returns the kernel currently used by the ssz_bits and ssz_bitlist functions.
+ *
+ * @return The active backend.
+ */
+ssz_bits_backend_t ssz_bits_get_backend(void);
+
+/**
+ * Overrides the kernel selected at startup.
+ *
+ * This is intended for tests and benchmarks that compare kernels. The default kernel is
+ * selected once in a thread-safe way on first use; an override is not synchronized, so it must
+ * be made before, not while, other threads use the kernels.
+ *
+ * @param backend The backend to use.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if the backend is not available.
+ */
+ssz_error_t ssz_bits_set_backend(ssz_bits_backend_t backend);
+
+/**
+ * Returns a human-readable name for a kernel.
+ *
+ * @param backend The backend.
+ * @return A static string naming the backend.
+ */
+const char *ssz_bits_backend_name(ssz_bits_backend_t backend);
+
+#endif /* SSZ_BITS_H */
@@ -14,6 +14,7 @@
 #define SSZ_BYTE_SIZE_OF_UINT256    32
 #define SSZ_BYTE_SIZE_OF_BOOL       1
 #define SSZ_SMALL_BUFFER_SIZE       256
+#define SSZ_MAX_MERKLE_DEPTH        64
 
 /**
  * Provides a lookup table to find the highest set bit for each byte value (0-255).
@@ -21,4 +22,11 @@
  */
 extern const int8_t highest_bit_table[256];
 
+/**
+ * Provides the roots of all-zero Merkle subtrees for every depth (0-SSZ_MAX_MERKLE_DEPTH).
+ * Entry 0 is the zero chunk and entry d is SHA256(entry d-1 || entry d-1), so a subtree of
+ * 2^d zero chunks can be folded into a root without hashing any of its leaves.
+ */
+extern const uint8_t zero_hash_table[SSZ_MAX_MERKLE_DEPTH + 1][SSZ_BYTES_PER_CHUNK];
+
 #endif /* SSZ_CONSTANTS_H */
\ No newline at end of file
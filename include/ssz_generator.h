@@ -7,6 +7,14 @@
 #include <string.h>
 #include <stdbool.h>
 #include "ssz_types.h"
+#include "ssz_serialize.h"
+#include "ssz_merkle.h"
+#include "ssz_root_cache.h"
+#include "ssz_bitfield.h"
+#include "ssz_bits.h"
+#include "ssz_inline.h"
+#include "ssz_writer.h"
+#include "ssz_iov.h"
 
 /*
  * Note: To improve portability for extremely large serializations, we use a 64-bit
@@ -92,11 +100,59 @@ typedef uint64_t ssz_offset_t;
         return SSZ_SUCCESS;                                                                    \
     }
 
+/*
+ * DEFINE_SERIALIZE_LIST_PARALLEL defines serialize_<ListType>_parallel for a list of fixed-size
+ * elements. Every element serializes to ElementSize bytes, so ssz_serialize_list_parallel can
+ * hand each worker thread a range of elements and its precomputed slice of out_buf; the
+ * generated serialize_<ListType>_range serializes one such range. The output is identical to
+ * serialize_<ListType> from DEFINE_SERIALIZE_LIST.
+ */
+#define DEFINE_SERIALIZE_LIST_PARALLEL(ListType, ElementType, ElementSize, ser_func)                \
+    static ssz_error_t serialize_##ListType##_range(const void *elements, size_t element_count,     \
+                                                    uint8_t *out_buf)                               \
+    {                                                                                               \
+        const ElementType *src = (const ElementType *)elements;                                     \
+        for (size_t i = 0; i < element_count; i++)                                                  \
+        {                                                                                           \
+            size_t tmp_size = (ElementSize);                                                        \
+            ssz_error_t err = ser_func(&src[i], out_buf + i * (size_t)(ElementSize), &tmp_size);    \
+            if (err != SSZ_SUCCESS || tmp_size != (size_t)(ElementSize))                            \
+            {                                                                                       \
+                return SSZ_ERROR_SERIALIZATION;                                                     \
+            }                                                                                       \
+        }                                                                                           \
+        return SSZ_SUCCESS;                                                                         \
+    }                                                                                               \
+                                                                                                    \
+    ssz_error_t serialize_##ListType##_parallel(const ListType *list, unsigned int thread_count,    \
+                                                uint8_t *out_buf, size_t *out_size)                 \
+    {                                                                                               \
+        if (list->length == 0 || list->data == NULL)                                                \
+        {                                                                                           \
+            *out_size = 0;                                                                          \
+            return SSZ_SUCCESS;                                                                     \
+        }                                                                                           \
+        if ((uint64_t)list->length > SIZE_MAX)                                                      \
+        {                                                                                           \
+            return SSZ_ERROR_SERIALIZATION;                                                         \
+        }                                                                                           \
+        return ssz_serialize_list_parallel(list->data, (size_t)list->length, sizeof(ElementType),  \
+                                           (ElementSize), serialize_##ListType##_range,             \
+                                           thread_count, out_buf, out_size);                        \
+    }
+
+/*
+ * The BASIC and VECTOR field macros substitute the header-only codec from ssz_inline.h when
+ * ser_func or deserialize_func is the matching library function, e.g. ssz_serialize_uint64 for a
+ * uint64_t field. Any other function, such as ssz_serialize_uint32 for a field stored in a wider
+ * C type or a custom codec, is called as given.
+ */
 #define SERIALIZE_BASIC_FIELD(obj, offset, field, field_size, ser_func)                 \
     do                                                                                  \
     {                                                                                   \
         size_t tmp_size = (field_size);                                                 \
-        ssz_error_t err_local = ser_func(&(obj)->field, out_buf + (size_t)(offset), &tmp_size); \
+        ssz_error_t err_local = SSZ_INLINE_SERIALIZE((obj)->field, ser_func,            \
+                                                     out_buf + (size_t)(offset), &tmp_size); \
         if (err_local != SSZ_SUCCESS)                                                   \
         {                                                                               \
             return SSZ_ERROR_SERIALIZATION;                                             \
@@ -109,8 +165,8 @@ typedef uint64_t ssz_offset_t;
     {                                                                            \
         size_t element_count = sizeof((obj)->field) / sizeof(((obj)->field)[0]); \
         size_t tmp_size = (field_size);                                          \
-        ssz_error_t err_local = ser_func((obj)->field, element_count,            \
-                                         out_buf + (size_t)(offset), &tmp_size);   \
+        ssz_error_t err_local = SSZ_INLINE_SERIALIZE_VECTOR((obj)->field, element_count, ser_func, \
+                                                            out_buf + (size_t)(offset), &tmp_size); \
         if (err_local != SSZ_SUCCESS)                                            \
         {                                                                        \
             return SSZ_ERROR_SERIALIZATION;                                      \
@@ -165,12 +221,44 @@ typedef uint64_t ssz_offset_t;
         (offset) += tmp_size;                                                   \
     } while (0)
 
+#define SERIALIZE_BITFIELD_VECTOR_FIELD(obj, offset, field)                                  \
+    do                                                                                      \
+    {                                                                                       \
+        size_t tmp_size = ((obj)->field.length + 7) / SSZ_BITS_PER_BYTE;                    \
+        ssz_error_t err_local = ssz_serialize_bitfield_vector(&(obj)->field,                \
+                                                              out_buf + (size_t)(offset),   \
+                                                              &tmp_size);                   \
+        if (err_local != SSZ_SUCCESS)                                                       \
+        {                                                                                   \
+            return SSZ_ERROR_SERIALIZATION;                                                 \
+        }                                                                                   \
+        (offset) += tmp_size;                                                               \
+    } while (0)
+
+#define SERIALIZE_BITFIELD_LIST_FIELD(obj, offset, field, max_bits)                         \
+    do                                                                                      \
+    {                                                                                       \
+        if ((uint64_t)(obj)->field.length > (uint64_t)(max_bits))                           \
+        {                                                                                   \
+            return SSZ_ERROR_SERIALIZATION;                                                 \
+        }                                                                                   \
+        size_t tmp_size = ((obj)->field.length / SSZ_BITS_PER_BYTE) + 1;                    \
+        ssz_error_t err_local = ssz_serialize_bitfield_list(&(obj)->field,                  \
+                                                            out_buf + (size_t)(offset),     \
+                                                            &tmp_size);                     \
+        if (err_local != SSZ_SUCCESS)                                                       \
+        {                                                                                   \
+            return SSZ_ERROR_SERIALIZATION;                                                 \
+        }                                                                                   \
+        (offset) += tmp_size;                                                               \
+    } while (0)
+
 #define SERIALIZE_OFFSET_FIELD(var, base, offset, field_size)                              \
     do                                                                                     \
     {                                                                                      \
         var = (uint32_t)(base);                                                            \
         size_t tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                         \
-        ssz_error_t err_local = ssz_serialize_uint32(&var, out_buf + (size_t)(offset), &tmp_size); \
+        ssz_error_t err_local = ssz_inline_serialize_uint32(&var, out_buf + (size_t)(offset), &tmp_size); \
         if (err_local != SSZ_SUCCESS)                                                      \
         {                                                                                  \
             return SSZ_ERROR_SERIALIZATION;                                                \
@@ -220,7 +308,7 @@ typedef uint64_t ssz_offset_t;
         fixed_var = (uint32_t)(base);                                                                                                    \
         {                                                                                                                                \
             size_t _tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                                                                  \
-            ssz_error_t _err_local = ssz_serialize_uint32(&fixed_var, out_buf + (size_t)(fixed_offset), &_tmp_size);                             \
+            ssz_error_t _err_local = ssz_inline_serialize_uint32(&fixed_var, out_buf + (size_t)(fixed_offset), &_tmp_size);                             \
             if (_err_local != SSZ_SUCCESS)                                                                                               \
             {                                                                                                                            \
                 return SSZ_ERROR_SERIALIZATION;                                                                                          \
@@ -236,7 +324,7 @@ typedef uint64_t ssz_offset_t;
         size_t _offset_table_start = base;                                                                                               \
         uint32_t _table_size = _num_elements * SSZ_BYTE_SIZE_OF_UINT32;                                                                  \
         size_t _tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                                                                      \
-        ssz_error_t _err = ssz_serialize_uint32(&_table_size, out_buf + (size_t)(_offset_table_start), &_tmp_size);                                \
+        ssz_error_t _err = ssz_inline_serialize_uint32(&_table_size, out_buf + (size_t)(_offset_table_start), &_tmp_size);                                \
         if (_err != SSZ_SUCCESS)                                                                                                         \
         {                                                                                                                                \
             return SSZ_ERROR_SERIALIZATION;                                                                                              \
@@ -246,7 +334,7 @@ typedef uint64_t ssz_offset_t;
         {                                                                                                                                \
             uint32_t zero_val = 0;                                                                                                       \
             _tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                                                                         \
-            _err = ssz_serialize_uint32(&zero_val, out_buf + (size_t)(_current_pos), &_tmp_size);                                                  \
+            _err = ssz_inline_serialize_uint32(&zero_val, out_buf + (size_t)(_current_pos), &_tmp_size);                                                  \
             if (_err != SSZ_SUCCESS)                                                                                                     \
             {                                                                                                                            \
                 return SSZ_ERROR_SERIALIZATION;                                                                                          \
@@ -264,7 +352,7 @@ typedef uint64_t ssz_offset_t;
         {                                                                                                                                \
             uint32_t _this_elem_offset = (uint32_t)(_current_sub_offset - _offset_table_start);                                          \
             _tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                                                                         \
-            _err = ssz_serialize_uint32(&_this_elem_offset, out_buf + (size_t)(_offset_table_start + (_i * SSZ_BYTE_SIZE_OF_UINT32)), &_tmp_size); \
+            _err = ssz_inline_serialize_uint32(&_this_elem_offset, out_buf + (size_t)(_offset_table_start + (_i * SSZ_BYTE_SIZE_OF_UINT32)), &_tmp_size); \
             if (_err != SSZ_SUCCESS)                                                                                                     \
             {                                                                                                                            \
                 free(_temp_buf);                                                                                                         \
@@ -296,7 +384,7 @@ typedef uint64_t ssz_offset_t;
         {                                                                                                           \
             uint32_t zero_val = 0;                                                                                  \
             size_t _tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                                             \
-            ssz_error_t _err = ssz_serialize_uint32(&zero_val,                                                      \
+            ssz_error_t _err = ssz_inline_serialize_uint32(&zero_val,                                                      \
                                                     out_buf + (size_t)(_offset_table_start + (_i * SSZ_BYTE_SIZE_OF_UINT32)), \
                                                     &_tmp_size);                                                    \
             if (_err != SSZ_SUCCESS)                                                                                \
@@ -318,7 +406,7 @@ typedef uint64_t ssz_offset_t;
             }                                                                                                       \
             uint32_t _elem_offset = (uint32_t)(_cur_offset - _offset_table_start);                                  \
             size_t _tmp_size = SSZ_BYTE_SIZE_OF_UINT32;                                                             \
-            _err = ssz_serialize_uint32(&_elem_offset,                                                              \
+            _err = ssz_inline_serialize_uint32(&_elem_offset,                                                              \
                                         out_buf + (size_t)(_offset_table_start + (_i * SSZ_BYTE_SIZE_OF_UINT32)),             \
                                         &_tmp_size);                                                                \
             if (_err != SSZ_SUCCESS)                                                                                \
@@ -424,7 +512,8 @@ typedef uint64_t ssz_offset_t;
 #define DESERIALIZE_BASIC_FIELD(obj, offset, field, deserialize_func)                                   \
     do                                                                                                  \
     {                                                                                                   \
-        ssz_error_t err_local = deserialize_func(data + (size_t)(offset), sizeof((obj)->field), &(obj)->field); \
+        ssz_error_t err_local = SSZ_INLINE_DESERIALIZE(data + (size_t)(offset), sizeof((obj)->field),   \
+                                                       (obj)->field, deserialize_func);                 \
         if (err_local != SSZ_SUCCESS)                                                                   \
         {                                                                                               \
             return SSZ_ERROR_DESERIALIZATION;                                                           \
@@ -435,8 +524,9 @@ typedef uint64_t ssz_offset_t;
 #define DESERIALIZE_VECTOR_FIELD(obj, offset, field, deserialize_func)                                              \
     do                                                                                                              \
     {                                                                                                               \
-        ssz_error_t err_local = deserialize_func(data + (size_t)(offset), sizeof((obj)->field),                             \
-                                                 (sizeof((obj)->field) / sizeof(((obj)->field)[0])), (obj)->field); \
+        ssz_error_t err_local = SSZ_INLINE_DESERIALIZE_VECTOR(                                                      \
+            data + (size_t)(offset), sizeof((obj)->field),                                                          \
+            (sizeof((obj)->field) / sizeof(((obj)->field)[0])), (obj)->field, deserialize_func);                    \
         if (err_local != SSZ_SUCCESS)                                                                               \
         {                                                                                                           \
             return SSZ_ERROR_DESERIALIZATION;                                                                       \
@@ -490,6 +580,33 @@ typedef uint64_t ssz_offset_t;
         (offset_start) += (field_size);                                           \
     } while (0)
 
+#define DESERIALIZE_BITFIELD_VECTOR_FIELD(obj, offset, field, bits)                                       \
+    do                                                                                                   \
+    {                                                                                                    \
+        size_t byte_size = ((bits) + 7) / SSZ_BITS_PER_BYTE;                                             \
+        ssz_error_t err_local = ssz_deserialize_bitfield_vector(data + (size_t)(offset), byte_size,      \
+                                                                (bits), &(obj)->field);                  \
+        if (err_local != SSZ_SUCCESS)                                                                    \
+        {                                                                                                \
+            return SSZ_ERROR_DESERIALIZATION;                                                            \
+        }                                                                                                \
+        (offset) += byte_size;                                                                           \
+    } while (0)
+
+#define DESERIALIZE_BITFIELD_LIST_FIELD(obj, offset_start, field_size, field, max_bits)  \
+    do                                                                                  \
+    {                                                                                   \
+        ssz_error_t err_local = ssz_deserialize_bitfield_list(data + (size_t)(offset_start), \
+                                                              (field_size),             \
+                                                              (max_bits),               \
+                                                              &(obj)->field);           \
+        if (err_local != SSZ_SUCCESS)                                                   \
+        {                                                                               \
+            return SSZ_ERROR_DESERIALIZATION;                                           \
+        }                                                                               \
+        (offset_start) += (field_size);                                                 \
+    } while (0)
+
 #define DESERIALIZE_LIST_FIELD(obj, offset_start, list_size, field, max_length, deserialize_func)                                     \
     do                                                                                                                                \
     {                                                                                                                                 \
@@ -511,7 +628,7 @@ typedef uint64_t ssz_offset_t;
 #define DESERIALIZE_OFFSET_FIELD(var, offset)                                                      \
     do                                                                                             \
     {                                                                                              \
-        ssz_error_t err_local = ssz_deserialize_uint32(data + (size_t)(offset), sizeof(uint32_t), &(var)); \
+        ssz_error_t err_local = ssz_inline_deserialize_uint32(data + (size_t)(offset), sizeof(uint32_t), &(var)); \
         if (err_local != SSZ_SUCCESS)                                                              \
         {                                                                                          \
             return SSZ_ERROR_DESERIALIZATION;                                                      \
@@ -545,8 +662,7 @@ typedef uint64_t ssz_offset_t;
     {                                                                                                                 \
         const unsigned char *const _base_ptr = data + (size_t)(field_offset);                                                 \
         const size_t _field_size = (field_size);                                                                      \
-        const uint32_t *const _offsets = (const uint32_t *)_base_ptr;                                                 \
-        const uint32_t _num_elements = _offsets[0] / SSZ_BYTES_PER_LENGTH_OFFSET;                                     \
+        const uint32_t _num_elements = ssz_load_le32(_base_ptr) / SSZ_BYTES_PER_LENGTH_OFFSET;                        \
         if (_num_elements > (max_length))                                                                             \
         {                                                                                                             \
             return SSZ_ERROR_DESERIALIZATION;                                                                         \
@@ -560,8 +676,10 @@ typedef uint64_t ssz_offset_t;
         const uint32_t _last_index = _num_elements - 1;                                                               \
         for (uint32_t _i = 0; _i < _num_elements; _i++)                                                               \
         {                                                                                                             \
-            const uint32_t _elem_rel_offset = _offsets[_i];                                                           \
-            const uint32_t _next_rel_offset = (_i < _last_index) ? _offsets[_i + 1] : _field_size;                    \
+            const uint32_t _elem_rel_offset = ssz_load_le32(_base_ptr + (size_t)_i * SSZ_BYTES_PER_LENGTH_OFFSET);    \
+            const uint32_t _next_rel_offset = (_i < _last_index)                                                      \
+                                                  ? ssz_load_le32(_base_ptr + (size_t)(_i + 1) * SSZ_BYTES_PER_LENGTH_OFFSET) \
+                                                  : _field_size;                                                      \
             const uint32_t _elem_total_size = _next_rel_offset - _elem_rel_offset;                                    \
             ssz_error_t _err = deserialize_func(_base_ptr + _elem_rel_offset, _elem_total_size,                       \
                                                 &((obj)->field.data[_i]));                                            \
@@ -573,4 +691,401 @@ typedef uint64_t ssz_offset_t;
         }                                                                                                             \
     } while (0)
 
+/*
+ * Serialized size generation. DEFINE_SSZ_SIZE_CONTAINER defines ssz_size_<ContainerType>, which
+ * returns the exact number of bytes serialize_<ContainerType> writes for obj, so a caller can
+ * allocate the output once. FixedSize is the compile-time size of the fixed part: every
+ * fixed-size field plus a 4-byte offset per variable-size field. The SIZE_*_FIELD macros add
+ * the runtime size of each variable-size field; a fixed-size container passes no fields.
+ */
+#define DEFINE_SSZ_SIZE_CONTAINER(ContainerType, FixedSize, CONTAINER_VARIABLE_FIELDS) \
+    size_t ssz_size_##ContainerType(const ContainerType *obj)                          \
+    {                                                                                  \
+        (void)obj;                                                                     \
+        size_t size = (FixedSize);                                                     \
+        CONTAINER_VARIABLE_FIELDS                                                      \
+        return size;                                                                   \
+    }
+
+#define SIZE_LIST_FIELD(obj, size, field, element_size)                  \
+    do                                                                   \
+    {                                                                    \
+        (size) += (size_t)(obj)->field.length * (size_t)(element_size);  \
+    } while (0)
+
+#define SIZE_BITLIST_FIELD(obj, size, field)                             \
+    do                                                                   \
+    {                                                                    \
+        (size) += (size_t)((obj)->field.length / SSZ_BITS_PER_BYTE) + 1; \
+    } while (0)
+
+#define SIZE_CONTAINER_FIELD(obj, size, field, size_func) \
+    do                                                    \
+    {                                                     \
+        (size) += size_func(&(obj)->field);               \
+    } while (0)
+
+#define SIZE_LIST_VARIABLE_CONTAINER_FIELD(obj, size, field, size_func)                \
+    do                                                                                 \
+    {                                                                                  \
+        (size) += (size_t)(obj)->field.length * SSZ_BYTES_PER_LENGTH_OFFSET;           \
+        for (size_t _i = 0; _i < (size_t)(obj)->field.length; _i++)                    \
+        {                                                                              \
+            (size) += size_func(&(obj)->field.data[_i]);                               \
+        }                                                                              \
+    } while (0)
+
+/*
+ * DEFINE_SERIALIZE_WRITER defines serialize_<ContainerType>_to_writer, which reserves exactly
+ * size_func(obj) bytes in an ssz_writer_t and runs ser_func into them, so any container with a
+ * generated size function can be written to a growable or chunked writer without a retry.
+ */
+#define DEFINE_SERIALIZE_WRITER(ContainerType, ser_func, size_func)                                      \
+    ssz_error_t serialize_##ContainerType##_to_writer(const ContainerType *obj, ssz_writer_t *writer) \
+    {                                                                                                  \
+        size_t size = size_func(obj);                                                                  \
+        uint8_t *out_buf = ssz_writer_reserve(writer, size);                                           \
+        if (out_buf == NULL)                                                                           \
+        {                                                                                              \
+            return SSZ_ERROR_SERIALIZATION;                                                            \
+        }                                                                                              \
+        ssz_error_t err = ser_func(obj, out_buf, &size);                                               \
+        if (err != SSZ_SUCCESS)                                                                        \
+        {                                                                                              \
+            return err;                                                                                \
+        }                                                                                              \
+        ssz_writer_advance(writer, size);                                                              \
+        return SSZ_SUCCESS;                                                                            \
+    }
+
+/*
+ * Field-by-field serialization. DEFINE_SERIALIZE_IOV defines serialize_<ContainerType>_to_iov,
+ * which appends the serialized form of obj to an ssz_iov_t scatter-gather list, and
+ * DEFINE_SERIALIZE_STREAM defines serialize_<ContainerType>_to_stream, which writes it to an
+ * ssz_writer_t one field at a time. Both take the same list of EMIT_*_FIELD macros, which write
+ * to the implicit sink. EMIT_VECTOR_FIELD and EMIT_LIST_FIELD pass fields whose memory already
+ * has the wire layout straight through, so an iov references large root and balance vectors in
+ * place and a stream writer copies them chunk by chunk; the other macros serialize one field or
+ * list element at a time into a reservation of the sink. Fields are emitted in wire order: the
+ * fixed part with an EMIT_OFFSET_FIELD per variable-size field, then the variable-size fields,
+ * so each offset is computed up front from the sizes of the fields before it (see the
+ * SIZE_*_FIELD macros). With a stream writer the largest reservation is one field or list
+ * element, so the writer's buffer bounds the memory used however large obj is. For
+ * EMIT_VECTOR_FIELD, element_size is the size of one basic value in host byte order (1 for byte
+ * arrays); for the list macros it is the serialized size of one list element, as in
+ * SERIALIZE_LIST_FIELD.
+ */
+#define DEFINE_SERIALIZE_IOV(ContainerType, CONTAINER_FIELDS)                                   \
+    ssz_error_t serialize_##ContainerType##_to_iov(const ContainerType *obj, ssz_iov_t *sink) \
+    {                                                                                          \
+        CONTAINER_FIELDS                                                                       \
+        return SSZ_SUCCESS;                                                                    \
+    }
+
+#define DEFINE_SERIALIZE_STREAM(ContainerType, CONTAINER_FIELDS)                                      \
+    ssz_error_t serialize_##ContainerType##_to_stream(const ContainerType *obj, ssz_writer_t *sink) \
+    {                                                                                                \
+        CONTAINER_FIELDS                                                                             \
+        return SSZ_SUCCESS;                                                                          \
+    }
+
+static inline ssz_error_t ssz_emit_writer_advance(ssz_writer_t *writer, size_t size)
+{
+    ssz_writer_advance(writer, size);
+    return SSZ_SUCCESS;
+}
+
+#define SSZ_EMIT_RESERVE(sink, size) \
+    _Generic((sink), ssz_iov_t *: ssz_iov_reserve, ssz_writer_t *: ssz_writer_reserve)((sink), (size))
+
+#define SSZ_EMIT_ADVANCE(sink, size) \
+    _Generic((sink), ssz_iov_t *: ssz_iov_advance, ssz_writer_t *: ssz_emit_writer_advance)((sink), (size))
+
+#define SSZ_EMIT_APPEND_LE(sink, values, count, value_size)                                 \
+    _Generic((sink), ssz_iov_t *: ssz_iov_append_le, ssz_writer_t *: ssz_writer_append_le)( \
+        (sink), (values), (count), (value_size))
+
+#define SSZ_EMIT_PUT_UINT32(sink, value) \
+    _Generic((sink), ssz_iov_t *: ssz_iov_put_uint32, ssz_writer_t *: ssz_writer_put_uint32)((sink), (value))
+
+#define EMIT_SERIALIZED(size, ser_call)                                      \
+    do                                                                       \
+    {                                                                        \
+        size_t tmp_size = (size);                                            \
+        uint8_t *out_buf = SSZ_EMIT_RESERVE(sink, tmp_size);                 \
+        if (out_buf == NULL || (ser_call) != SSZ_SUCCESS ||                  \
+            SSZ_EMIT_ADVANCE(sink, tmp_size) != SSZ_SUCCESS)                 \
+        {                                                                    \
+            return SSZ_ERROR_SERIALIZATION;                                  \
+        }                                                                    \
+    } while (0)
+
+#define EMIT_BASIC_FIELD(obj, field, field_size, ser_func)                                \
+    EMIT_SERIALIZED((field_size),                                                         \
+                    SSZ_INLINE_SERIALIZE((obj)->field, ser_func, out_buf, &tmp_size))
+
+#define EMIT_CONTAINER_FIELD(obj, field, container_ser_func, field_size) \
+    EMIT_SERIALIZED((field_size), container_ser_func(&(obj)->field, out_buf, &tmp_size))
+
+#define EMIT_BITVECTOR_FIELD(obj, field, bits)                                               \
+    EMIT_SERIALIZED(((bits) + 7) / SSZ_BITS_PER_BYTE,                                        \
+                    ssz_serialize_bitvector((obj)->field, (bits), out_buf, &tmp_size))
+
+#define EMIT_VECTOR_FIELD(obj, field, element_size)                                            \
+    do                                                                                         \
+    {                                                                                          \
+        if (SSZ_EMIT_APPEND_LE(sink, (obj)->field, sizeof((obj)->field) / (element_size),      \
+                               (element_size)) != SSZ_SUCCESS)                                 \
+        {                                                                                      \
+            return SSZ_ERROR_SERIALIZATION;                                                    \
+        }                                                                                      \
+    } while (0)
+
+#define EMIT_LIST_FIELD(obj, field, element_size)                                                  \
+    do                                                                                             \
+    {                                                                                              \
+        size_t _value_size = sizeof(*(obj)->field.data);                                           \
+        if (SSZ_EMIT_APPEND_LE(sink, (obj)->field.data,                                            \
+                               (size_t)(obj)->field.length * (element_size) / _value_size,         \
+                               _value_size) != SSZ_SUCCESS)                                        \
+        {                                                                                          \
+            return SSZ_ERROR_SERIALIZATION;                                                        \
+        }                                                                                          \
+    } while (0)
+
+#define EMIT_OFFSET_FIELD(base, field_size)                              \
+    do                                                                   \
+    {                                                                    \
+        if (SSZ_EMIT_PUT_UINT32(sink, (uint32_t)(base)) != SSZ_SUCCESS)  \
+        {                                                                \
+            return SSZ_ERROR_SERIALIZATION;                              \
+        }                                                                \
+        (base) += (field_size);                                          \
+    } while (0)
+
+#define EMIT_LIST_CONTAINER_FIELD(obj, field, container_ser_func, element_size)                 \
+    do                                                                                          \
+    {                                                                                           \
+        for (size_t _i = 0; _i < (size_t)(obj)->field.length; _i++)                             \
+        {                                                                                       \
+            EMIT_SERIALIZED((element_size),                                                     \
+                            container_ser_func(&(obj)->field.data[_i], out_buf, &tmp_size));    \
+        }                                                                                       \
+    } while (0)
+
+#define EMIT_LIST_VARIABLE_CONTAINER_FIELD(obj, field, container_ser_func, size_func)           \
+    do                                                                                          \
+    {                                                                                           \
+        size_t _elem_offset = (size_t)(obj)->field.length * SSZ_BYTES_PER_LENGTH_OFFSET;        \
+        for (size_t _i = 0; _i < (size_t)(obj)->field.length; _i++)                             \
+        {                                                                                       \
+            EMIT_OFFSET_FIELD(_elem_offset, size_func(&(obj)->field.data[_i]));                 \
+        }                                                                                       \
+        for (size_t _i = 0; _i < (size_t)(obj)->field.length; _i++)                             \
+        {                                                                                       \
+            EMIT_SERIALIZED(size_func(&(obj)->field.data[_i]),                                  \
+                            container_ser_func(&(obj)->field.data[_i], out_buf, &tmp_size));    \
+        }                                                                                       \
+    } while (0)
+
+/*
+ * hash_tree_root generation. DEFINE_HASH_TREE_ROOT_CONTAINER declares a stack buffer of one
+ * 32-byte leaf per field; each HTR_*_FIELD macro writes the root of its field into the next
+ * leaf, and the container root is the Merkle root of the leaves. Packed vectors and lists go
+ * through ssz_hash_tree_root_basic_vector/_list, which hash straight from the field memory, and
+ * bitfields are streamed chunk by chunk through an ssz_merkleizer_t, so no field needs a heap
+ * buffer. element_size is the size of one basic value in host byte order (1 for byte arrays).
+ * ssz_bitfield_t fields go through the HTR_BITFIELD_* macros, which merkleize the words in place.
+ */
+#define DEFINE_HASH_TREE_ROOT_CONTAINER(ContainerType, FieldCount, CONTAINER_FIELDS)        \
+    ssz_error_t hash_tree_root_##ContainerType(const ContainerType *obj, uint8_t *out_root) \
+    {                                                                                       \
+        uint8_t leaves[(FieldCount) * SSZ_BYTES_PER_CHUNK];                                 \
+        size_t leaf = 0;                                                                    \
+        CONTAINER_FIELDS                                                                    \
+        if (leaf != (FieldCount))                                                           \
+        {                                                                                   \
+            return SSZ_ERROR_MERKLEIZATION;                                                 \
+        }                                                                                   \
+        return ssz_merkleize(leaves, leaf, 0, out_root);                                    \
+    }
+
+#define HTR_LEAF(leaf) (leaves + (size_t)(leaf) * SSZ_BYTES_PER_CHUNK)
+
+#define HTR_BITS_ROOT(bits, bit_count, chunk_limit, out_root)                                                            \
+    do                                                                                                                   \
+    {                                                                                                                    \
+        const bool *_bits = (bits);                                                                                      \
+        size_t _bit_count = (bit_count);                                                                                 \
+        ssz_merkleizer_t _m;                                                                                             \
+        ssz_merkleizer_init(&_m, (chunk_limit));                                                                         \
+        for (size_t _start = 0; _start < _bit_count; _start += SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE)                  \
+        {                                                                                                                \
+            uint8_t _chunk[SSZ_BYTES_PER_CHUNK] = {0};                                                                   \
+            size_t _n = _bit_count - _start;                                                                             \
+            if (_n > SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE)                                                            \
+            {                                                                                                            \
+                _n = SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE;                                                            \
+            }                                                                                                            \
+            ssz_bits_pack(_bits + _start, _n, _chunk);                                                                   \
+            if (ssz_merkleizer_push_chunk(&_m, _chunk) != SSZ_SUCCESS)                                                   \
+            {                                                                                                            \
+                return SSZ_ERROR_MERKLEIZATION;                                                                          \
+            }                                                                                                            \
+        }                                                                                                                \
+        ssz_merkleizer_finalize(&_m, (out_root));                                                                        \
+    } while (0)
+
+#define HTR_BASIC_FIELD(obj, leaf, field)                    \
+    do                                                       \
+    {                                                        \
+        uint8_t *_leaf = HTR_LEAF(leaf);                     \
+        memset(_leaf, 0, SSZ_BYTES_PER_CHUNK);               \
+        ssz_store_le64(_leaf, (uint64_t)(obj)->field);       \
+        (leaf)++;                                            \
+    } while (0)
+
+#define HTR_VECTOR_FIELD(obj, leaf, field, element_size)                           \
+    do                                                                             \
+    {                                                                              \
+        if (ssz_hash_tree_root_basic_vector((obj)->field, (element_size),          \
+                                            sizeof((obj)->field) / (element_size), \
+                                            HTR_LEAF(leaf)) != SSZ_SUCCESS)        \
+        {                                                                          \
+            return SSZ_ERROR_MERKLEIZATION;                                        \
+        }                                                                          \
+        (leaf)++;                                                                  \
+    } while (0)
+
+#define HTR_LIST_FIELD(obj, leaf, field, element_size, max_length)                           \
+    do                                                                                       \
+    {                                                                                        \
+        if ((uint64_t)(obj)->field.length > (uint64_t)(max_length) ||                        \
+            ssz_hash_tree_root_basic_list((obj)->field.data, (element_size),                 \
+                                          (size_t)(obj)->field.length, (size_t)(max_length), \
+                                          HTR_LEAF(leaf)) != SSZ_SUCCESS)                    \
+        {                                                                                    \
+            return SSZ_ERROR_MERKLEIZATION;                                                  \
+        }                                                                                    \
+        (leaf)++;                                                                            \
+    } while (0)
+
+#define HTR_BITVECTOR_FIELD(obj, leaf, field, bits)                                                                                 \
+    do                                                                                                                              \
+    {                                                                                                                               \
+        HTR_BITS_ROOT((obj)->field, (bits),                                                                                         \
+                      ((uint64_t)(bits) + SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE - 1) / (SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE), \
+                      HTR_LEAF(leaf));                                                                                              \
+        (leaf)++;                                                                                                                   \
+    } while (0)
+
+#define HTR_BITLIST_FIELD(obj, leaf, field, max_bits)                                                                                   \
+    do                                                                                                                                  \
+    {                                                                                                                                   \
+        if ((uint64_t)(obj)->field.length > (uint64_t)(max_bits))                                                                       \
+        {                                                                                                                               \
+            return SSZ_ERROR_MERKLEIZATION;                                                                                             \
+        }                                                                                                                               \
+        HTR_BITS_ROOT((obj)->field.data, (size_t)(obj)->field.length,                                                                   \
+                      ((uint64_t)(max_bits) + SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE - 1) / (SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE), \
+                      HTR_LEAF(leaf));                                                                                                  \
+        ssz_mix_in_length(HTR_LEAF(leaf), (uint64_t)(obj)->field.length, HTR_LEAF(leaf));                                               \
+        (leaf)++;                                                                                                                       \
+    } while (0)
+
+#define HTR_BITFIELD_VECTOR_FIELD(obj, leaf, field)                                              \
+    do                                                                                          \
+    {                                                                                           \
+        if (ssz_hash_tree_root_bitfield_vector(&(obj)->field, HTR_LEAF(leaf)) != SSZ_SUCCESS)   \
+        {                                                                                       \
+            return SSZ_ERROR_MERKLEIZATION;                                                     \
+        }                                                                                       \
+        (leaf)++;                                                                               \
+    } while (0)
+
+#define HTR_BITFIELD_LIST_FIELD(obj, leaf, field, max_bits)                                                   \
+    do                                                                                                        \
+    {                                                                                                         \
+        if (ssz_hash_tree_root_bitfield_list(&(obj)->field, (max_bits), HTR_LEAF(leaf)) != SSZ_SUCCESS)       \
+        {                                                                                                     \
+            return SSZ_ERROR_MERKLEIZATION;                                                                   \
+        }                                                                                                     \
+        (leaf)++;                                                                                             \
+    } while (0)
+
+#define HTR_CONTAINER_FIELD(obj, leaf, field, htr_func)             \
+    do                                                              \
+    {                                                               \
+        if (htr_func(&(obj)->field, HTR_LEAF(leaf)) != SSZ_SUCCESS) \
+        {                                                           \
+            return SSZ_ERROR_MERKLEIZATION;                         \
+        }                                                           \
+        (leaf)++;                                                   \
+    } while (0)
+
+#define HTR_LIST_CONTAINER_FIELD(obj, leaf, field, htr_func, max_length)                  \
+    do                                                                                    \
+    {                                                                                     \
+        if ((uint64_t)(obj)->field.length > (uint64_t)(max_length))                       \
+        {                                                                                 \
+            return SSZ_ERROR_MERKLEIZATION;                                               \
+        }                                                                                 \
+        ssz_merkleizer_t _m;                                                              \
+        ssz_merkleizer_init(&_m, (uint64_t)(max_length));                                 \
+        for (size_t _i = 0; _i < (size_t)(obj)->field.length; _i++)                       \
+        {                                                                                 \
+            uint8_t _root[SSZ_BYTES_PER_CHUNK];                                           \
+            if (htr_func(&(obj)->field.data[_i], _root) != SSZ_SUCCESS ||                 \
+                ssz_merkleizer_push_chunk(&_m, _root) != SSZ_SUCCESS)                     \
+            {                                                                             \
+                return SSZ_ERROR_MERKLEIZATION;                                           \
+            }                                                                             \
+        }                                                                                 \
+        ssz_merkleizer_finalize(&_m, HTR_LEAF(leaf));                                     \
+        ssz_mix_in_length(HTR_LEAF(leaf), (uint64_t)(obj)->field.length, HTR_LEAF(leaf)); \
+        (leaf)++;                                                                         \
+    } while (0)
+
+/*
+ * Like HTR_LIST_CONTAINER_FIELD for fixed-size elements, but the root of each element is first
+ * looked up in an ssz_root_cache_t keyed by its serialization (element_size bytes, produced by
+ * ser_func into a stack buffer); only elements whose content is not cached are merkleized.
+ */
+#define HTR_LIST_CONTAINER_FIELD_CACHED(obj, leaf, field, htr_func, ser_func, element_size, max_length, cache) \
+    do                                                                                                         \
+    {                                                                                                          \
+        if ((uint64_t)(obj)->field.length > (uint64_t)(max_length) || (cache)->key_size != (element_size))     \
+        {                                                                                                      \
+            return SSZ_ERROR_MERKLEIZATION;                                                                    \
+        }                                                                                                      \
+        ssz_merkleizer_t _m;                                                                                   \
+        ssz_merkleizer_init(&_m, (uint64_t)(max_length));                                                      \
+        for (size_t _i = 0; _i < (size_t)(obj)->field.length; _i++)                                            \
+        {                                                                                                      \
+            uint8_t _key[(element_size)];                                                                      \
+            size_t _key_size = (element_size);                                                                 \
+            uint8_t _root[SSZ_BYTES_PER_CHUNK];                                                                \
+            if (ser_func(&(obj)->field.data[_i], _key, &_key_size) != SSZ_SUCCESS ||                           \
+                _key_size != (element_size))                                                                   \
+            {                                                                                                  \
+                return SSZ_ERROR_MERKLEIZATION;                                                                \
+            }                                                                                                  \
+            if (!ssz_root_cache_lookup((cache), _key, _root))                                                  \
+            {                                                                                                  \
+                if (htr_func(&(obj)->field.data[_i], _root) != SSZ_SUCCESS)                                    \
+                {                                                                                              \
+                    return SSZ_ERROR_MERKLEIZATION;                                                            \
+                }                                                                                              \
+                ssz_root_cache_insert((cache), _key, _root);                                                   \
+            }                                                                                                  \
+            if (ssz_merkleizer_push_chunk(&_m, _root) != SSZ_SUCCESS)                                          \
+            {                                                                                                  \
+                return SSZ_ERROR_MERKLEIZATION;                                                                \
+            }                                                                                                  \
+        }                                                                                                      \
+        ssz_merkleizer_finalize(&_m, HTR_LEAF(leaf));                                                          \
+        ssz_mix_in_length(HTR_LEAF(leaf), (uint64_t)(obj)->field.length, HTR_LEAF(leaf));                      \
+        (leaf)++;                                                                                              \
+    } while (0)
+
 #endif /* SSZ_GENERATOR_H */
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef SSZ_HASH_H
+#define SSZ_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+
+/**
+ * Enumerates the SHA-256 implementations available to the library.
+ * The generic backend is portable C (mincrypt for arbitrary lengths) and is always available.
+ * The multi-buffer backends only accelerate ssz_sha256_64B_xN; single messages are
+ * hashed with SHA-NI when the CPU has it, otherwise with the generic code.
+ */
+typedef enum
+{
+    SSZ_HASH_BACKEND_GENERIC,   /**< Portable C implementation. */
+    SSZ_HASH_BACKEND_SHA_NI,    /**< x86 SHA extensions (SHA-NI). */
+    SSZ_HASH_BACKEND_ARMV8,     /**< ARMv8 SHA2 cryptographic extension. */
+    SSZ_HASH_BACKEND_AVX2,      /**< 8-lane multi-buffer AVX2 for 64-byte batches. */
+    SSZ_HASH_BACKEND_AVX512,    /**< 16-lane multi-buffer AVX-512 for 64-byte batches. */
+    SSZ_HASH_BACKEND_COUNT      /**< Number of backends; not a valid backend. */
+} ssz_hash_backend_t;
+
+/**
+ * Computes the SHA-256 digest of a byte array using the active backend.
+ *
+ * On first use the fastest backend supported by the running CPU is selected.
+ *
+ * @param data Pointer to the input bytes.
+ * @param len Number of input bytes.
+ * @param out_digest Output buffer to write the digest (32 bytes).
+ */
+void ssz_sha256(
+    const uint8_t *data,
+    size_t len,
+    uint8_t *out_digest);
+
+/**
+ * Computes the SHA-256 digests of consecutive 64-byte messages using the active backend.
+ *
+ * This is the shape of every Merkle tree level: message i is the sibling pair at
+ * in + 64 * i and its digest is written to out + 32 * i. Multi-buffer backends hash
+ * 8 or 16 messages per pass in SIMD lanes. The output may alias the input (out == in),
+ * which allows a tree level to be reduced in place.
+ *
+ * @param in Pointer to count consecutive 64-byte messages.
+ * @param count Number of messages.
+ * @param out Output buffer to write count consecutive 32-byte digests.
+ */
+void ssz_sha256_64B_xN(
+    const uint8_t *in,
+    size_t count,
+    uint8_t *out);
+
+/**
+ * Computes the SHA-256 digest of the 64-byte concatenation of two 32-byte nodes.
+ *
+ * This is the Merkle node hash. It runs exactly two compressions and takes the message
+ * schedule of the second, constant padding block from a precomputed table instead of
+ * going through the general streaming hash.
+ *
+ * @param left Pointer to the left node (32 bytes).
+ * @param right Pointer to the right node (32 bytes).
+ * @param out Output buffer to write the digest (32 bytes); may alias left or right.
+ */
+void ssz_hash_pair(
+    const uint8_t *left,
+    const uint8_t *right,
+    uint8_t *out);
+
+/**
+ * Checks whether a backend is compiled in and supported by the running CPU.
+ *
+ * @param backend The backend to check.
+ * @return true if the backend can be selected, otherwise false.
+ */
+bool ssz_hash_backend_available(ssz_hash_backend_t backend);
+
+/**
+ * Returns the backend currently used by ssz_sha256.
+ *
+ * @return The active backend.
+ */
+ssz_hash_backend_t ssz_hash_get_backend(void);
+
+/**
+ * Overrides the backend selected at startup.
+ *
+ * This is intended for tests and benchmarks that compare backends. The default backend is
+ * selected once in a thread-safe way on first use; an override is not synchronized, so it must
+ * be made before, not while, other threads hash.
+ *
+ * @param backend The backend to use.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if the backend is not available.
+ */
+ssz_error_t ssz_hash_set_backend(ssz_hash_backend_t backend);
+
+/**
+ * Returns a human-readable name for a backend.
+ *
+ * @param backend The backend.
+ * @return A static string naming the backend.
+ */
+const char *ssz_hash_backend_name(ssz_hash_backend_t backend);
+
+#endif /* SSZ_HASH_H */
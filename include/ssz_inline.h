@@ -0,0 +1,329 @@
+#ifndef SSZ_INLINE_H
+#define SSZ_INLINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ssz_constants.h"
+#include "ssz_types.h"
+#include "ssz_serialize.h"
+#include "ssz_deserialize.h"
+
+/*
+ * Header-only little-endian codec for SSZ basic values. The byte order of the target is known
+ * at compile time, so on little-endian hosts every load and store below is a single unaligned
+ * move and on big-endian hosts a move plus a byte swap. The ssz_inline_* functions have the
+ * signatures of the ssz_serialize_uint* and ssz_deserialize_uint* library functions, so the
+ * generator macros can call them per field and let the compiler flatten a whole container into
+ * straight-line code.
+ */
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#define SSZ_HOST_LITTLE_ENDIAN (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#elif defined(__LITTLE_ENDIAN__) || defined(_WIN32)
+#define SSZ_HOST_LITTLE_ENDIAN 1
+#elif defined(__BIG_ENDIAN__)
+#define SSZ_HOST_LITTLE_ENDIAN 0
+#else
+#error "Unable to determine the byte order of the target"
+#endif
+
+static inline uint16_t ssz_load_le16(const uint8_t *p)
+{
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+#if !SSZ_HOST_LITTLE_ENDIAN
+    v = __builtin_bswap16(v);
+#endif
+    return v;
+}
+
+static inline uint32_t ssz_load_le32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if !SSZ_HOST_LITTLE_ENDIAN
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline uint64_t ssz_load_le64(const uint8_t *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if !SSZ_HOST_LITTLE_ENDIAN
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline void ssz_store_le16(uint8_t *p, uint16_t v)
+{
+#if !SSZ_HOST_LITTLE_ENDIAN
+    v = __builtin_bswap16(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline void ssz_store_le32(uint8_t *p, uint32_t v)
+{
+#if !SSZ_HOST_LITTLE_ENDIAN
+    v = __builtin_bswap32(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline void ssz_store_le64(uint8_t *p, uint64_t v)
+{
+#if !SSZ_HOST_LITTLE_ENDIAN
+    v = __builtin_bswap64(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+/*
+ * Copies a host-order integer of size bytes (16 or 32 for uint128/uint256) to or from its
+ * little-endian encoding. The copy is symmetric, so the same helper serves both directions.
+ */
+static inline void ssz_copy_le_bytes(uint8_t *dst, const uint8_t *src, size_t size)
+{
+#if SSZ_HOST_LITTLE_ENDIAN
+    memcpy(dst, src, size);
+#else
+    for (size_t i = 0; i < size; i++)
+    {
+        dst[i] = src[size - 1 - i];
+    }
+#endif
+}
+
+static inline ssz_error_t ssz_inline_serialize_uint8(const void *value, uint8_t *out_buf, size_t *out_size)
+{
+    if (out_buf == NULL || *out_size < SSZ_BYTE_SIZE_OF_UINT8)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    out_buf[0] = *(const uint8_t *)value;
+    *out_size = SSZ_BYTE_SIZE_OF_UINT8;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_serialize_uint16(const void *value, uint8_t *out_buf, size_t *out_size)
+{
+    if (out_buf == NULL || *out_size < SSZ_BYTE_SIZE_OF_UINT16)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    uint16_t v;
+    memcpy(&v, value, sizeof(v));
+    ssz_store_le16(out_buf, v);
+    *out_size = SSZ_BYTE_SIZE_OF_UINT16;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_serialize_uint32(const void *value, uint8_t *out_buf, size_t *out_size)
+{
+    if (out_buf == NULL || *out_size < SSZ_BYTE_SIZE_OF_UINT32)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    uint32_t v;
+    memcpy(&v, value, sizeof(v));
+    ssz_store_le32(out_buf, v);
+    *out_size = SSZ_BYTE_SIZE_OF_UINT32;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_serialize_uint64(const void *value, uint8_t *out_buf, size_t *out_size)
+{
+    if (out_buf == NULL || *out_size < SSZ_BYTE_SIZE_OF_UINT64)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    uint64_t v;
+    memcpy(&v, value, sizeof(v));
+    ssz_store_le64(out_buf, v);
+    *out_size = SSZ_BYTE_SIZE_OF_UINT64;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_serialize_boolean(const bool *value, uint8_t *out_buf, size_t *out_size)
+{
+    if (out_buf == NULL || *out_size < SSZ_BYTE_SIZE_OF_BOOL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    out_buf[0] = (uint8_t)(*value);
+    *out_size = SSZ_BYTE_SIZE_OF_BOOL;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_deserialize_uint8(const uint8_t *buffer, size_t buffer_size, void *out_value)
+{
+    if (buffer == NULL || buffer_size != SSZ_BYTE_SIZE_OF_UINT8)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    *(uint8_t *)out_value = buffer[0];
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_deserialize_uint16(const uint8_t *buffer, size_t buffer_size, void *out_value)
+{
+    if (buffer == NULL || buffer_size != SSZ_BYTE_SIZE_OF_UINT16)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    uint16_t v = ssz_load_le16(buffer);
+    memcpy(out_value, &v, sizeof(v));
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_deserialize_uint32(const uint8_t *buffer, size_t buffer_size, void *out_value)
+{
+    if (buffer == NULL || buffer_size != SSZ_BYTE_SIZE_OF_UINT32)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    uint32_t v = ssz_load_le32(buffer);
+    memcpy(out_value, &v, sizeof(v));
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_deserialize_uint64(const uint8_t *buffer, size_t buffer_size, void *out_value)
+{
+    if (buffer == NULL || buffer_size != SSZ_BYTE_SIZE_OF_UINT64)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    uint64_t v = ssz_load_le64(buffer);
+    memcpy(out_value, &v, sizeof(v));
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_deserialize_boolean(const uint8_t *buffer, size_t buffer_size, bool *out_value)
+{
+    if (buffer == NULL || buffer_size < SSZ_BYTE_SIZE_OF_BOOL || buffer[0] > 1)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    *out_value = buffer[0] == 1;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_serialize_vector_uint8(
+    const uint8_t *restrict elements,
+    size_t element_count,
+    uint8_t *restrict out_buf,
+    size_t *restrict out_size)
+{
+    if (out_buf == NULL || element_count == 0 || *out_size < element_count)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    memcpy(out_buf, elements, element_count);
+    *out_size = element_count;
+    return SSZ_SUCCESS;
+}
+
+static inline ssz_error_t ssz_inline_deserialize_vector_uint8(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t element_count,
+    uint8_t *out_elements)
+{
+    if (buffer == NULL || element_count == 0 || buffer_size != element_count)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    memcpy(out_elements, buffer, element_count);
+    return SSZ_SUCCESS;
+}
+
+/*
+ * Select the inline codec function for a basic field from the field's type, or for a vector
+ * field from its element type. Types without an inline codec (uint128/uint256 byte arrays,
+ * wider vectors, custom types) resolve to the fallback function. The selection looks at the
+ * type only; SSZ_INLINE_SERIALIZE and friends below also check the fallback before using it.
+ */
+#define SSZ_INLINE_SERIALIZER(field, fallback)      \
+    _Generic((field),                               \
+             uint8_t: ssz_inline_serialize_uint8,   \
+             uint16_t: ssz_inline_serialize_uint16, \
+             uint32_t: ssz_inline_serialize_uint32, \
+             uint64_t: ssz_inline_serialize_uint64, \
+             bool: ssz_inline_serialize_boolean,    \
+             default: fallback)
+
+#define SSZ_INLINE_DESERIALIZER(field, fallback)      \
+    _Generic((field),                                 \
+             uint8_t: ssz_inline_deserialize_uint8,   \
+             uint16_t: ssz_inline_deserialize_uint16, \
+             uint32_t: ssz_inline_deserialize_uint32, \
+             uint64_t: ssz_inline_deserialize_uint64, \
+             bool: ssz_inline_deserialize_boolean,    \
+             default: fallback)
+
+#define SSZ_INLINE_VECTOR_SERIALIZER(element, fallback)         \
+    _Generic((element),                                         \
+             uint8_t: ssz_inline_serialize_vector_uint8,        \
+             default: fallback)
+
+#define SSZ_INLINE_VECTOR_DESERIALIZER(element, fallback)       \
+    _Generic((element),                                         \
+             uint8_t: ssz_inline_deserialize_vector_uint8,      \
+             default: fallback)
+
+/*
+ * Tests whether a codec argument is a given library function. Both operands are function
+ * addresses, so the comparison folds at compile time; the casts let codecs of different
+ * signatures be compared.
+ */
+#define SSZ_INLINE_SAME_CODEC(func, lib) ((void (*)(void))(func) == (void (*)(void))(lib))
+
+/*
+ * Call a codec for a field, substituting the inline codec only when the caller passed the
+ * library function it replaces. Any other function, e.g. ssz_serialize_uint32 for a uint64_t
+ * field or a custom codec, is called exactly as given.
+ */
+#define SSZ_INLINE_SERIALIZE(field, ser_func, out_buf, out_size)                  \
+    (_Generic((field),                                                            \
+              uint8_t: SSZ_INLINE_SAME_CODEC(ser_func, ssz_serialize_uint8),      \
+              uint16_t: SSZ_INLINE_SAME_CODEC(ser_func, ssz_serialize_uint16),    \
+              uint32_t: SSZ_INLINE_SAME_CODEC(ser_func, ssz_serialize_uint32),    \
+              uint64_t: SSZ_INLINE_SAME_CODEC(ser_func, ssz_serialize_uint64),    \
+              bool: SSZ_INLINE_SAME_CODEC(ser_func, ssz_serialize_boolean),       \
+              default: 0)                                                         \
+         ? SSZ_INLINE_SERIALIZER(field, ser_func)(&(field), (out_buf), (out_size)) \
+         : (ser_func)(&(field), (out_buf), (out_size)))
+
+#define SSZ_INLINE_DESERIALIZE(buffer, buffer_size, field, deser_func)                  \
+    (_Generic((field),                                                                  \
+              uint8_t: SSZ_INLINE_SAME_CODEC(deser_func, ssz_deserialize_uint8),        \
+              uint16_t: SSZ_INLINE_SAME_CODEC(deser_func, ssz_deserialize_uint16),      \
+              uint32_t: SSZ_INLINE_SAME_CODEC(deser_func, ssz_deserialize_uint32),      \
+              uint64_t: SSZ_INLINE_SAME_CODEC(deser_func, ssz_deserialize_uint64),      \
+              bool: SSZ_INLINE_SAME_CODEC(deser_func, ssz_deserialize_boolean),         \
+              default: 0)                                                               \
+         ? SSZ_INLINE_DESERIALIZER(field, deser_func)((buffer), (buffer_size), &(field)) \
+         : (deser_func)((buffer), (buffer_size), &(field)))
+
+#define SSZ_INLINE_SERIALIZE_VECTOR(elements, element_count, ser_func, out_buf, out_size)    \
+    (_Generic(((elements)[0]),                                                               \
+              uint8_t: SSZ_INLINE_SAME_CODEC(ser_func, ssz_serialize_vector_uint8),          \
+              default: 0)                                                                    \
+         ? SSZ_INLINE_VECTOR_SERIALIZER(((elements)[0]), ser_func)((elements), (element_count), \
+                                                                 (out_buf), (out_size))      \
+         : (ser_func)((elements), (element_count), (out_buf), (out_size)))
+
+#define SSZ_INLINE_DESERIALIZE_VECTOR(buffer, buffer_size, element_count, elements, deser_func) \
+    (_Generic(((elements)[0]),                                                                  \
+              uint8_t: SSZ_INLINE_SAME_CODEC(deser_func, ssz_deserialize_vector_uint8),         \
+              default: 0)                                                                       \
+         ? SSZ_INLINE_VECTOR_DESERIALIZER(((elements)[0]), deser_func)((buffer), (buffer_size), \
+                                                                       (element_count), (elements)) \
+         : (deser_func)((buffer), (buffer_size), (element_count), (elements)))
+
+#endif /* SSZ_INLINE_H */
@@ -0,0 +1,131 @@
+#ifndef SSZ_IOV_H
+#define SSZ_IOV_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+#include "ssz_writer.h"
+
+#ifndef _WIN32
+#include <sys/uio.h>
+/** One entry of a scatter-gather list; the POSIX struct iovec, so it can be passed to writev. */
+typedef struct iovec ssz_iovec_t;
+#else
+/** One entry of a scatter-gather list, laid out like the POSIX struct iovec. */
+typedef struct
+{
+    void *iov_base;
+    size_t iov_len;
+} ssz_iovec_t;
+#endif
+
+/**
+ * Represents a serialized object as a scatter-gather list.
+ *
+ * Fields whose in-memory layout already equals their wire layout, such as byte vectors or, on
+ * little-endian hosts, vectors and lists of integers, are referenced in place. Everything else
+ * (offsets, integers, small containers) is serialized into scratch memory from an arena.
+ * Adjacent entries are merged, so a two-dimensional byte array or consecutive scratch pieces
+ * take a single entry. Referenced fields must stay alive and unchanged until the list is written.
+ */
+typedef struct
+{
+    ssz_iovec_t *entries;     /**< The scatter-gather list. */
+    size_t count;             /**< Number of entries. */
+    size_t capacity;          /**< Number of entries allocated. */
+    size_t size;              /**< Total number of bytes. */
+    uint8_t *scratch;         /**< Current scratch region. */
+    size_t scratch_used;      /**< Bytes used in the current scratch region. */
+    size_t scratch_capacity;  /**< Size of the current scratch region. */
+    size_t scratch_size;      /**< Minimum size of a new scratch region. */
+    ssz_arena_t *arena;       /**< Arena providing the entries and scratch memory. */
+} ssz_iov_t;
+
+/**
+ * Initializes an empty scatter-gather list.
+ *
+ * @param iov Pointer to the list to initialize.
+ * @param arena Arena providing the entries and scratch memory.
+ * @param scratch_size Minimum size of each scratch region; 0 selects a default.
+ */
+void ssz_iov_init(ssz_iov_t *iov, ssz_arena_t *arena, size_t scratch_size);
+
+/**
+ * Appends bytes by reference.
+ *
+ * @param iov Pointer to the list.
+ * @param data Bytes to reference; must outlive the list.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_append_ref(ssz_iov_t *iov, const void *data, size_t size);
+
+/**
+ * Appends an array of unsigned integers in little-endian order.
+ *
+ * On little-endian hosts, and always for one-byte values, the array is referenced in place;
+ * otherwise each value is byte-swapped into scratch memory.
+ *
+ * @param iov Pointer to the list.
+ * @param values Pointer to count values of value_size bytes each.
+ * @param count Number of values.
+ * @param value_size Size of one value in bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_append_le(ssz_iov_t *iov, const void *values, size_t count, size_t value_size);
+
+/**
+ * Returns size bytes of scratch memory to serialize into. The bytes become part of the list
+ * only after ssz_iov_advance.
+ *
+ * @param iov Pointer to the list.
+ * @param size Number of bytes needed.
+ * @return Pointer to the scratch bytes, or NULL on allocation failure.
+ */
+uint8_t *ssz_iov_reserve(ssz_iov_t *iov, size_t size);
+
+/**
+ * Appends scratch bytes filled in after ssz_iov_reserve to the list.
+ *
+ * @param iov Pointer to the list.
+ * @param size Number of bytes written, at most the size reserved.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_advance(ssz_iov_t *iov, size_t size);
+
+/**
+ * Appends a little-endian uint32, e.g. an SSZ offset, through scratch memory.
+ *
+ * @param iov Pointer to the list.
+ * @param value The value.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_put_uint32(ssz_iov_t *iov, uint32_t value);
+
+/**
+ * Copies the bytes of a list into a contiguous buffer.
+ *
+ * @param iov Pointer to the list.
+ * @param out_buf Output buffer of at least iov->size bytes.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes copied.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the buffer is too small.
+ */
+ssz_error_t ssz_iov_copy(const ssz_iov_t *iov, uint8_t *out_buf, size_t *out_size);
+
+#ifndef _WIN32
+/**
+ * Writes a list to a file descriptor with writev.
+ *
+ * The list is written in batches of at most IOV_MAX entries (1024 where it is not defined), and partial writes and EINTR are
+ * retried, so the whole list is written unless an error occurs. The entries are unchanged on
+ * return.
+ *
+ * @param iov Pointer to the list.
+ * @param fd File descriptor of a file, pipe or socket.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if a write fails.
+ */
+ssz_error_t ssz_iov_writev(ssz_iov_t *iov, int fd);
+#endif
+
+#endif /* SSZ_IOV_H */
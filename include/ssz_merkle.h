@@ -5,13 +5,51 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "ssz_types.h"
+#include "ssz_constants.h"
+
+/**
+ * Represents an incremental Merkleization context.
+ * Chunks are pushed one at a time (or in batches) and only a single pending node per
+ * tree level is retained, so a list of any length can be rooted in O(depth) memory.
+ */
+typedef struct
+{
+    uint8_t pending[SSZ_MAX_MERKLE_DEPTH + 1][SSZ_BYTES_PER_CHUNK]; /**< Left-hand node waiting for its sibling at each level. */
+    uint64_t count;                                                  /**< Number of chunks pushed so far. */
+    uint64_t limit;                                                  /**< Maximum number of chunks, or 0 for no limit. */
+} ssz_merkleizer_t;
+
+/**
+ * Represents a Merkle proof for a single node identified by its generalized index.
+ * The branch lists the sibling of every node on the path to the root, bottom first.
+ */
+typedef struct
+{
+    uint8_t leaf[SSZ_BYTES_PER_CHUNK];                         /**< The proven node. */
+    uint8_t branch[SSZ_MAX_MERKLE_DEPTH][SSZ_BYTES_PER_CHUNK]; /**< Sibling at each level, from the leaf up to the children of the root. */
+    unsigned int depth;                                        /**< Number of branch nodes, floor(log2(gindex)). */
+    uint64_t gindex;                                           /**< Generalized index of the proven node (1 for the root). */
+} ssz_merkle_proof_t;
+
+/**
+ * Describes one single-node proof in a batch passed to ssz_verify_proofs_batch.
+ * The pointed-to buffers are read only and may be shared between items.
+ */
+typedef struct
+{
+    const uint8_t *leaf;   /**< The proven node (SSZ_BYTES_PER_CHUNK bytes). */
+    const uint8_t *branch; /**< Sibling nodes, bottom first (depth * SSZ_BYTES_PER_CHUNK bytes). */
+    unsigned int depth;    /**< Number of branch nodes; must equal floor(log2(gindex)). */
+    uint64_t gindex;       /**< Generalized index of the proven node. */
+    const uint8_t *root;   /**< Expected Merkle root (SSZ_BYTES_PER_CHUNK bytes). */
+} ssz_proof_batch_item_t;
 
 /**
  * Computes the Merkle root from an array of chunks.
  *
- * This function constructs a Merkle tree by first copying the provided chunks
- * into leaf nodes, padding with zeros if necessary, and then iteratively hashing
- * pairs of nodes until a single root is obtained.
+ * This function hashes only the populated part of the tree and folds in precomputed
+ * zero-subtree hashes for the padding up to the limit, so the cost is O(chunk_count + depth)
+ * in time and memory regardless of the limit.
  *
  * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes).
  * @param chunk_count Number of chunks provided.
@@ -25,6 +63,81 @@ ssz_error_t ssz_merkleize(
     size_t limit,
     uint8_t *out_root);
 
+/**
+ * Computes the Merkle root from an array of chunks using several threads.
+ *
+ * The tree is split into independent power-of-two subtrees that are hashed concurrently,
+ * then the top levels are combined; the root is bit-identical to ssz_merkleize. Small inputs
+ * (a few thousand chunks or fewer) and a thread_count of 0 or 1 run on the calling thread.
+ *
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes).
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @param thread_count Maximum number of threads to use, including the calling thread.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkleize_parallel(
+    const uint8_t *chunks,
+    size_t chunk_count,
+    size_t limit,
+    unsigned int thread_count,
+    uint8_t *out_root);
+
+/**
+ * Initializes an incremental Merkleization context.
+ *
+ * @param m Pointer to the context to initialize.
+ * @param limit Maximum number of chunks that may be pushed; if zero, the tree depth is derived
+ *              from the final chunk count as in ssz_merkleize.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkleizer_init(
+    ssz_merkleizer_t *m,
+    uint64_t limit);
+
+/**
+ * Pushes a single chunk into an incremental Merkleization context.
+ *
+ * Completed subtrees are hashed as soon as both children are available, so at most one
+ * node per level is kept pending.
+ *
+ * @param m Pointer to the context.
+ * @param chunk Pointer to the chunk (SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code if the limit would be exceeded.
+ */
+ssz_error_t ssz_merkleizer_push_chunk(
+    ssz_merkleizer_t *m,
+    const uint8_t *chunk);
+
+/**
+ * Pushes a contiguous array of chunks into an incremental Merkleization context.
+ *
+ * @param m Pointer to the context.
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes).
+ * @param chunk_count Number of chunks provided.
+ * @return SSZ_SUCCESS on success, or an error code if the limit would be exceeded.
+ */
+ssz_error_t ssz_merkleizer_push_chunks(
+    ssz_merkleizer_t *m,
+    const uint8_t *chunks,
+    size_t chunk_count);
+
+/**
+ * Computes the Merkle root of all chunks pushed into an incremental Merkleization context.
+ *
+ * The missing right-hand side of the tree is filled in from the precomputed zero-subtree
+ * hashes. The result is identical to calling ssz_merkleize with the same chunks and limit.
+ * The context is left unchanged and can continue to receive chunks.
+ *
+ * @param m Pointer to the context.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkleizer_finalize(
+    const ssz_merkleizer_t *m,
+    uint8_t *out_root);
+
 /**
  * Packs a contiguous byte array into fixed-size chunks.
  *
@@ -96,4 +209,216 @@ ssz_error_t ssz_mix_in_selector(
     uint8_t selector,
     uint8_t *out_root);
 
+/**
+ * Computes the hash tree root of a vector of basic values.
+ *
+ * The values are merkleized straight from the caller's buffer: full chunks are hashed in place
+ * and only the last partial chunk is zero-padded on the stack, so neither ssz_pack's copy nor a
+ * heap allocation is needed. Values are read in host byte order and hashed as their
+ * little-endian SSZ encoding.
+ *
+ * @param values Pointer to the values; may be NULL if count is 0.
+ * @param value_size Size of one value in bytes (1, 2, 4, 8, 16 or 32).
+ * @param count Number of values; must be non-zero.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_hash_tree_root_basic_vector(
+    const void *values,
+    size_t value_size,
+    size_t count,
+    uint8_t *out_root);
+
+/**
+ * Computes the hash tree root of a list of basic values.
+ *
+ * Like ssz_hash_tree_root_basic_vector, the values are merkleized without copying them, up to
+ * the chunk count implied by the list limit, and the length is then mixed in.
+ *
+ * @param values Pointer to the values; may be NULL if count is 0.
+ * @param value_size Size of one value in bytes (1, 2, 4, 8, 16 or 32).
+ * @param count Number of values in the list.
+ * @param limit Maximum number of values in the list; if zero, the tree depth is derived from count.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_hash_tree_root_basic_list(
+    const void *values,
+    size_t value_size,
+    size_t count,
+    size_t limit,
+    uint8_t *out_root);
+
+/**
+ * Computes the hash tree root of a bitvector from its packed (serialized) bytes.
+ *
+ * Unlike ssz_pack_bits, no bool array is needed and nothing is copied or allocated; the bytes
+ * are merkleized where they lie.
+ *
+ * @param bytes Pointer to the packed bits, ceil(bit_count / 8) bytes, least significant bit first.
+ * @param bit_count Number of bits in the bitvector; must be non-zero.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if bits past bit_count are set,
+ *         or SSZ_ERROR_MERKLEIZATION on invalid arguments.
+ */
+ssz_error_t ssz_hash_tree_root_bitvector(
+    const uint8_t *bytes,
+    size_t bit_count,
+    uint8_t *out_root);
+
+/**
+ * Computes the hash tree root of a bitlist from its serialized bytes.
+ *
+ * The delimiter bit is stripped on the fly and the length mixed in, so wire bytes such as
+ * aggregation bits can be rooted without unpacking them or allocating.
+ *
+ * @param bytes Pointer to the serialized bitlist, including the delimiter bit.
+ * @param byte_count Number of serialized bytes; must be non-zero.
+ * @param max_bits Maximum number of bits in the bitlist.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @param out_bit_count Optional pointer to store the number of bits in the bitlist; may be NULL.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if the delimiter is missing or the
+ *         bitlist is longer than max_bits, or SSZ_ERROR_MERKLEIZATION on invalid arguments.
+ */
+ssz_error_t ssz_hash_tree_root_bitlist(
+    const uint8_t *bytes,
+    size_t byte_count,
+    size_t max_bits,
+    uint8_t *out_root,
+    size_t *out_bit_count);
+
+/**
+ * Generates a Merkle proof for the node at a generalized index.
+ *
+ * The node and its branch are recorded while the tree is hashed level by level, so the proof
+ * costs a single pass over the populated chunks; siblings inside the zero padding come from
+ * the precomputed zero-subtree hashes. The tree is the one rooted by ssz_merkleize with the same
+ * chunks and limit, and gindex may address a leaf chunk or an interior node.
+ *
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes); may be NULL if chunk_count is 0.
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @param gindex Generalized index of the node to prove (1 for the root, 2^depth + i for chunk i).
+ * @param out_proof Output proof holding the node, its branch, the branch depth and gindex.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_OUT_OF_RANGE if gindex lies below the leaf level,
+ *         or another error code on failure.
+ */
+ssz_error_t ssz_generate_proof(
+    const uint8_t *chunks,
+    size_t chunk_count,
+    size_t limit,
+    uint64_t gindex,
+    ssz_merkle_proof_t *out_proof);
+
+/**
+ * Verifies a Merkle proof for the node at a generalized index.
+ *
+ * The bits of gindex below its leading one select, level by level, whether the running node
+ * is the left or the right child.
+ *
+ * @param leaf The proven node (SSZ_BYTES_PER_CHUNK bytes).
+ * @param branch Sibling nodes, bottom first (depth * SSZ_BYTES_PER_CHUNK bytes).
+ * @param depth Number of branch nodes; must equal floor(log2(gindex)).
+ * @param gindex Generalized index of the proven node.
+ * @param root Expected Merkle root (SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the branch hashes the leaf up to root, false otherwise.
+ */
+bool ssz_verify_proof(
+    const uint8_t *leaf,
+    const uint8_t *branch,
+    unsigned int depth,
+    uint64_t gindex,
+    const uint8_t *root);
+
+/**
+ * Verifies many single-node proofs together.
+ *
+ * All proofs are advanced one level per round. Identical 64-byte inputs within a round, such
+ * as the shared upper branch of proofs for neighbouring leaves under the same root, are hashed
+ * only once, and the distinct inputs of a round are hashed as one ssz_sha256_64B_xN batch so
+ * multi-buffer SHA-256 backends can fill their lanes. Each result equals what ssz_verify_proof
+ * returns for the same item.
+ *
+ * @param items The proofs to verify.
+ * @param item_count Number of proofs.
+ * @param out_valid Output array receiving the verdict for each proof (item_count entries).
+ * @return SSZ_SUCCESS if every proof was checked (whatever the verdicts), or an error code on failure.
+ */
+ssz_error_t ssz_verify_proofs_batch(
+    const ssz_proof_batch_item_t *items,
+    size_t item_count,
+    bool *out_valid);
+
+/**
+ * Computes the helper indices of a multiproof for a set of generalized indices.
+ *
+ * The helpers are the siblings along the paths of all proven nodes, minus every node that lies
+ * on one of those paths (and so can be recomputed by the verifier). Shared upper branches are
+ * therefore sent once. Indices are written in descending order, which is the order in which
+ * ssz_generate_multiproof emits the helper nodes.
+ *
+ * @param gindices Generalized indices of the proven nodes; each must be non-zero.
+ * @param gindex_count Number of generalized indices.
+ * @param out_helper_indices Output array for the helper indices; may be NULL to query the count only.
+ * @param out_helper_count On input the capacity of out_helper_indices; on output the number of helper indices.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_get_helper_indices(
+    const uint64_t *gindices,
+    size_t gindex_count,
+    uint64_t *out_helper_indices,
+    size_t *out_helper_count);
+
+/**
+ * Generates a multiproof for several nodes of one tree.
+ *
+ * All proven nodes and helper nodes are copied out during a single level-by-level pass over
+ * the tree that ssz_merkleize roots with the same chunks and limit.
+ *
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes); may be NULL if chunk_count is 0.
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @param gindices Generalized indices of the proven nodes.
+ * @param gindex_count Number of generalized indices.
+ * @param helper_indices Helper indices as returned by ssz_get_helper_indices for gindices.
+ * @param helper_count Number of helper indices.
+ * @param out_leaves Output buffer for the proven nodes, in gindices order (gindex_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @param out_helpers Output buffer for the helper nodes, in helper_indices order (helper_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_OUT_OF_RANGE if an index lies below the leaf level,
+ *         or another error code on failure.
+ */
+ssz_error_t ssz_generate_multiproof(
+    const uint8_t *chunks,
+    size_t chunk_count,
+    size_t limit,
+    const uint64_t *gindices,
+    size_t gindex_count,
+    const uint64_t *helper_indices,
+    size_t helper_count,
+    uint8_t *out_leaves,
+    uint8_t *out_helpers);
+
+/**
+ * Verifies a multiproof for several nodes against a Merkle root.
+ *
+ * The helper indices are recomputed from gindices, then the tree is rebuilt bottom-up one level
+ * at a time. Every interior node is hashed exactly once, and the sibling pairs of each level
+ * are hashed as one batch.
+ *
+ * @param leaves The proven nodes, in gindices order (gindex_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @param gindices Generalized indices of the proven nodes.
+ * @param gindex_count Number of generalized indices.
+ * @param helpers The helper nodes, in descending helper index order (helper_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @param helper_count Number of helper nodes.
+ * @param root Expected Merkle root (SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the proof hashes up to root, false otherwise.
+ */
+bool ssz_verify_multiproof(
+    const uint8_t *leaves,
+    const uint64_t *gindices,
+    size_t gindex_count,
+    const uint8_t *helpers,
+    size_t helper_count,
+    const uint8_t *root);
+
 #endif /* SSZ_MERKLE_H */
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef SSZ_MERKLE_TREE_H
+#define SSZ_MERKLE_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+#include "ssz_constants.h"
+
+/**
+ * Represents a persistent Merkle tree over a list or vector of chunks.
+ *
+ * Every node of the populated subtree is kept in memory in generalized-index order, so after
+ * a few chunks change only their paths to the root are rehashed. The populated subtree covers
+ * the chunk count rounded up to a power of two; the padding up to the limit is folded in with
+ * zero-subtree hashes, so the root always equals ssz_merkleize over the same chunks and limit.
+ */
+typedef struct
+{
+    uint8_t *nodes;                               /**< 2 * capacity nodes; node g at nodes + g * SSZ_BYTES_PER_CHUNK, leaves from g = capacity. */
+    uint8_t *dirty_flags;                         /**< One flag per interior node (index 1 to capacity - 1) awaiting a rehash. */
+    size_t *dirty;                                /**< Dirty interior nodes; level l lists its nodes from offset capacity >> l. */
+    size_t dirty_count[SSZ_MAX_MERKLE_DEPTH + 1]; /**< Number of dirty nodes listed for each level. */
+    size_t capacity;                              /**< Number of leaves held, always a power of two. */
+    unsigned int capacity_depth;                  /**< log2(capacity). */
+    size_t chunk_count;                           /**< Number of populated leaves. */
+    size_t limit;                                 /**< Maximum number of chunks, or 0 for no limit. */
+} ssz_merkle_tree_t;
+
+/**
+ * Builds a persistent Merkle tree from an array of chunks.
+ *
+ * All interior nodes are hashed once, level by level.
+ *
+ * @param tree Pointer to the tree to initialize.
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes); may be NULL if chunk_count is 0.
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkle_tree_init(
+    ssz_merkle_tree_t *tree,
+    const uint8_t *chunks,
+    size_t chunk_count,
+    size_t limit);
+
+/**
+ * Replaces or appends a chunk and marks its path to the root dirty.
+ *
+ * No hashing happens here; the path is rehashed by the next ssz_merkle_tree_root call.
+ * An index equal to the chunk count appends a chunk, doubling the held subtree when it is full.
+ *
+ * @param tree Pointer to the tree.
+ * @param index Index of the chunk; at most the current chunk count.
+ * @param chunk Pointer to the new chunk (SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_OUT_OF_RANGE if the index is past the end or the limit,
+ *         or SSZ_ERROR_MERKLEIZATION if growing the tree fails.
+ */
+ssz_error_t ssz_merkle_tree_set_chunk(
+    ssz_merkle_tree_t *tree,
+    size_t index,
+    const uint8_t *chunk);
+
+/**
+ * Returns a pointer to a chunk held by the tree.
+ *
+ * @param tree Pointer to the tree.
+ * @param index Index of the chunk; must be less than the chunk count.
+ * @return Pointer to the chunk (SSZ_BYTES_PER_CHUNK bytes), or NULL if the index is out of range.
+ */
+const uint8_t *ssz_merkle_tree_get_chunk(
+    const ssz_merkle_tree_t *tree,
+    size_t index);
+
+/**
+ * Computes the Merkle root, rehashing only the paths of chunks changed since the last call.
+ *
+ * With k changed chunks in a tree of n leaves this costs O(k log n) hashes instead of O(n).
+ *
+ * @param tree Pointer to the tree.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkle_tree_root(
+    ssz_merkle_tree_t *tree,
+    uint8_t *out_root);
+
+/**
+ * Receives one changed chunk index from ssz_merkle_tree_diff.
+ *
+ * @param chunk_index Index of a chunk that differs between the two trees.
+ * @param user_data The pointer passed to ssz_merkle_tree_diff.
+ */
+typedef void (*ssz_merkle_tree_diff_fn)(size_t chunk_index, void *user_data);
+
+/**
+ * Reports the indices of the chunks that differ between two persistent Merkle trees.
+ *
+ * Both trees are walked from the root down, descending only into subtrees whose roots differ,
+ * so k changed chunks among n cost O(k log n) node comparisons and no hashing beyond flushing
+ * pending changes. The trees may hold different chunk counts; chunks past the end of one tree
+ * compare as zero chunks, so appended chunks are reported too. Indices are reported in
+ * ascending order.
+ *
+ * @param a Pointer to the first tree.
+ * @param b Pointer to the second tree.
+ * @param callback Function called once for each differing chunk index.
+ * @param user_data Pointer passed through to the callback.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on invalid arguments.
+ */
+ssz_error_t ssz_merkle_tree_diff(
+    ssz_merkle_tree_t *a,
+    ssz_merkle_tree_t *b,
+    ssz_merkle_tree_diff_fn callback,
+    void *user_data);
+
+/**
+ * Releases the memory held by a persistent Merkle tree.
+ *
+ * @param tree Pointer to the tree.
+ */
+void ssz_merkle_tree_free(ssz_merkle_tree_t *tree);
+
+#endif /* SSZ_MERKLE_TREE_H */
@@ -0,0 +1,101 @@
+#ifndef SSZ_ROOT_CACHE_H
+#define SSZ_ROOT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+#include "ssz_constants.h"
+
+/**
+ * Represents a cache of hash tree roots keyed by the serialized content of fixed-size objects.
+ *
+ * Most records of a large list, such as the validators of a state, are unchanged between two
+ * root computations; looking their roots up by content skips their merkleization. The table
+ * uses open addressing with a short bounded probe window: when the window is full, the entry at
+ * the home slot is replaced, so the cache never grows and never needs a rebuild. A 64-bit
+ * fingerprint is stored per slot and full keys are compared on a fingerprint match, so a hit
+ * always returns the root of identical content. The cache is not thread-safe.
+ */
+typedef struct
+{
+    uint64_t *tags;     /**< Fingerprint of the key in each slot, 0 for an empty slot. */
+    uint8_t *keys;      /**< key_size bytes per slot. */
+    uint8_t *roots;     /**< SSZ_BYTES_PER_CHUNK bytes per slot. */
+    size_t key_size;    /**< Size of every key in bytes (the serialized size of the object). */
+    size_t capacity;    /**< Number of slots, a power of two. */
+    size_t entries;     /**< Number of occupied slots. */
+    uint64_t hits;      /**< Number of lookups that found a root. */
+    uint64_t misses;    /**< Number of lookups that did not. */
+} ssz_root_cache_t;
+
+/**
+ * Initializes a root cache.
+ *
+ * Entries start being replaced before the table is full, so the capacity should be a few times
+ * the number of distinct objects expected, e.g. four times the validator count.
+ *
+ * @param cache Pointer to the cache to initialize.
+ * @param key_size Size of every key in bytes; must be non-zero.
+ * @param capacity Minimum number of slots; rounded up to a power of two.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on invalid arguments or allocation failure.
+ */
+ssz_error_t ssz_root_cache_init(
+    ssz_root_cache_t *cache,
+    size_t key_size,
+    size_t capacity);
+
+/**
+ * Looks up the root cached for a key and counts the lookup as a hit or a miss.
+ *
+ * @param cache Pointer to the cache.
+ * @param key Pointer to the key (key_size bytes).
+ * @param out_root Output buffer for the root on a hit (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the root was found, false otherwise.
+ */
+bool ssz_root_cache_lookup(
+    ssz_root_cache_t *cache,
+    const uint8_t *key,
+    uint8_t *out_root);
+
+/**
+ * Stores the root of a key, replacing an older entry if the probe window is full.
+ *
+ * @param cache Pointer to the cache.
+ * @param key Pointer to the key (key_size bytes).
+ * @param root Pointer to the root of the key (SSZ_BYTES_PER_CHUNK bytes).
+ */
+void ssz_root_cache_insert(
+    ssz_root_cache_t *cache,
+    const uint8_t *key,
+    const uint8_t *root);
+
+/**
+ * Reads the cache counters for monitoring.
+ *
+ * @param cache Pointer to the cache.
+ * @param out_hits Optional pointer to store the number of hits; may be NULL.
+ * @param out_misses Optional pointer to store the number of misses; may be NULL.
+ * @param out_entries Optional pointer to store the number of cached roots; may be NULL.
+ */
+void ssz_root_cache_stats(
+    const ssz_root_cache_t *cache,
+    uint64_t *out_hits,
+    uint64_t *out_misses,
+    size_t *out_entries);
+
+/**
+ * Removes every entry and resets the counters, keeping the allocated table.
+ *
+ * @param cache Pointer to the cache.
+ */
+void ssz_root_cache_clear(ssz_root_cache_t *cache);
+
+/**
+ * Releases the memory held by a root cache.
+ *
+ * @param cache Pointer to the cache.
+ */
+void ssz_root_cache_free(ssz_root_cache_t *cache);
+
+#endif /* SSZ_ROOT_CACHE_H */
@@ -0,0 +1,79 @@
+#ifndef SSZ_SCHEMA_H
+#define SSZ_SCHEMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+#include "ssz_constants.h"
+
+/**
+ * Enumerates the SSZ type kinds a type descriptor can describe.
+ */
+typedef enum
+{
+    SSZ_TYPE_UINT,      /**< Unsigned integer of 1, 2, 4, 8, 16 or 32 bytes. */
+    SSZ_TYPE_BOOLEAN,   /**< Boolean, one byte holding 0 or 1. */
+    SSZ_TYPE_VECTOR,    /**< Fixed-length sequence of one element type. */
+    SSZ_TYPE_LIST,      /**< Variable-length sequence of one element type, up to a limit. */
+    SSZ_TYPE_BITVECTOR, /**< Fixed-length sequence of bits. */
+    SSZ_TYPE_BITLIST,   /**< Variable-length sequence of bits, up to a limit. */
+    SSZ_TYPE_CONTAINER  /**< Ordered sequence of heterogeneous fields. */
+} ssz_type_kind_t;
+
+/**
+ * Describes the shape of an SSZ type so that serialized data can be walked without a C struct.
+ *
+ * Descriptors are plain constant data and nest through the element and fields pointers, e.g.
+ *
+ *     static const ssz_type_desc_t bytes32 = {SSZ_TYPE_VECTOR, 0, 32, &ssz_type_uint8, NULL};
+ *     static const ssz_type_desc_t *const checkpoint_fields[] = {&ssz_type_uint64, &bytes32};
+ *     static const ssz_type_desc_t checkpoint = {SSZ_TYPE_CONTAINER, 0, 2, NULL, checkpoint_fields};
+ */
+typedef struct ssz_type_desc
+{
+    ssz_type_kind_t kind;                      /**< Kind of the type. */
+    size_t size;                               /**< Byte size of a uint; unused for other kinds. */
+    uint64_t length;                           /**< Vector length, list limit, bit length or limit, or container field count. */
+    const struct ssz_type_desc *element;       /**< Element type of a vector or list. */
+    const struct ssz_type_desc *const *fields; /**< Field types of a container, in declaration order. */
+} ssz_type_desc_t;
+
+extern const ssz_type_desc_t ssz_type_uint8;
+extern const ssz_type_desc_t ssz_type_uint16;
+extern const ssz_type_desc_t ssz_type_uint32;
+extern const ssz_type_desc_t ssz_type_uint64;
+extern const ssz_type_desc_t ssz_type_uint128;
+extern const ssz_type_desc_t ssz_type_uint256;
+extern const ssz_type_desc_t ssz_type_boolean;
+
+/**
+ * Returns the serialized size of a fixed-size type.
+ *
+ * @param type Pointer to the type descriptor.
+ * @return The size in bytes, or 0 if the type is variable-size.
+ */
+size_t ssz_type_fixed_size(const ssz_type_desc_t *type);
+
+/**
+ * Computes the hash tree root of a value directly from its serialized bytes.
+ *
+ * The buffer is walked once following the descriptor and the offsets it contains; basic values,
+ * packed vectors and lists and bitfields are merkleized where they lie, so no C struct is built
+ * and nothing is allocated. The encoding is validated along the way (sizes, offsets, boolean
+ * values, bitlist delimiters and limits), so a buffer that would not deserialize has no root.
+ *
+ * @param type Pointer to the type descriptor.
+ * @param buf Pointer to the serialized value.
+ * @param len Size of the serialized value in bytes.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_INVALID_OFFSET or SSZ_ERROR_DESERIALIZATION if the
+ *         encoding is malformed, or SSZ_ERROR_MERKLEIZATION if the descriptor is invalid.
+ */
+ssz_error_t ssz_hash_tree_root_serialized(
+    const ssz_type_desc_t *type,
+    const uint8_t *buf,
+    size_t len,
+    uint8_t *out_root);
+
+#endif /* SSZ_SCHEMA_H */
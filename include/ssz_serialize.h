@@ -351,4 +351,44 @@ ssz_error_t ssz_serialize_list_bool(
     size_t *restrict out_size
 );
 
+/**
+ * Serializes a run of consecutive fixed-size list elements into consecutive bytes.
+ *
+ * @param elements Pointer to the first element.
+ * @param element_count Number of elements.
+ * @param out_buf Output buffer receiving exactly element_count serialized elements.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+typedef ssz_error_t (*ssz_serialize_range_fn)(const void *elements, size_t element_count, uint8_t *out_buf);
+
+/**
+ * Serializes a list of fixed-size elements using several threads.
+ *
+ * Every element has the same serialized size, so each one has a known position in out_buf.
+ * The list is split into contiguous ranges that range_func serializes concurrently, each into
+ * its own slice of the output; the result is identical to serializing the elements in order.
+ * Short lists (a few thousand elements or fewer) and a thread_count of 0 or 1 run on the
+ * calling thread.
+ *
+ * @param elements Pointer to the elements.
+ * @param element_count The number of elements in the list.
+ * @param element_stride Distance in bytes between consecutive elements in memory.
+ * @param element_size Serialized size of one element in bytes.
+ * @param range_func Function serializing a range of elements.
+ * @param thread_count Maximum number of threads to use, including the calling thread.
+ * @param out_buf Pointer to the output buffer to write the serialized data.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes written.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_serialize_list_parallel(
+    const void *elements,
+    size_t element_count,
+    size_t element_stride,
+    size_t element_size,
+    ssz_serialize_range_fn range_func,
+    unsigned int thread_count,
+    uint8_t *out_buf,
+    size_t *out_size
+);
+
 #endif /* SSZ_SERIALIZE_H */
\ No newline at end of file
@@ -23,6 +23,16 @@ bool is_zero(const uint8_t *ptr, size_t len);
  */
 uint64_t next_pow_of_two(uint64_t value);
 
+/**
+ * Computes the base-2 logarithm of the next power of two for the given value.
+ * This is the depth of a Merkle tree with the given number of leaves.
+ * If the input is zero or one, the result is 0.
+ *
+ * @param value The input value.
+ * @return The smallest d such that 2^d >= value (at most 64).
+ */
+unsigned int ceil_log2(uint64_t value);
+
 /**
  * Validates whether the provided offset is within the maximum allowed SSZ offset range.
  * This check is based on SSZ's fixed offset size of SSZ_BYTES_PER_LENGTH_OFFSET bytes.
@@ -0,0 +1,356 @@
+#ifndef SSZ_WRITER_H
+#define SSZ_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssz_types.h"
+#include "ssz_inline.h"
+
+/**
+ * One block of memory owned by an arena.
+ */
+typedef struct ssz_arena_block
+{
+    struct ssz_arena_block *next;  /**< Next block of the arena, or NULL. */
+    size_t capacity;               /**< Usable bytes after the block header. */
+    size_t used;                   /**< Bytes handed out since the last reset. */
+} ssz_arena_block_t;
+
+/**
+ * Represents a bump allocator that keeps its blocks across resets.
+ *
+ * Allocations are carved from the current block; when it is full the arena moves on to the next
+ * retained block, and only allocates a new block when no retained block is large enough. After
+ * ssz_arena_reset, the same sequence of allocations reuses the same blocks, so serializing one
+ * message after another reaches a steady state with no calls to malloc. Memory is released only
+ * by ssz_arena_free. The arena is not thread-safe.
+ */
+typedef struct
+{
+    ssz_arena_block_t *head;     /**< First block, or NULL. */
+    ssz_arena_block_t *current;  /**< Block allocations are carved from. */
+    size_t block_size;           /**< Minimum capacity of a new block. */
+    size_t block_count;          /**< Number of blocks allocated so far. */
+} ssz_arena_t;
+
+/**
+ * Initializes an empty arena. No memory is allocated until the first allocation.
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param block_size Minimum capacity of each block; larger requests get a block of their own size.
+ */
+void ssz_arena_init(ssz_arena_t *arena, size_t block_size);
+
+/**
+ * Allocates memory from an arena, aligned to 16 bytes.
+ *
+ * @param arena Pointer to the arena.
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the memory, or NULL if a new block could not be allocated.
+ */
+void *ssz_arena_alloc(ssz_arena_t *arena, size_t size);
+
+/**
+ * Grows an allocation of an arena.
+ *
+ * If ptr is the most recent allocation and its block has room, the allocation is extended in
+ * place; otherwise a new allocation is made and the old_size bytes are copied to it. The old
+ * memory is not reused until the next reset.
+ *
+ * @param arena Pointer to the arena.
+ * @param ptr Pointer returned by ssz_arena_alloc or ssz_arena_grow, or NULL.
+ * @param old_size Current size of the allocation.
+ * @param new_size Requested size, at least old_size.
+ * @return Pointer to the grown allocation, or NULL if a new block could not be allocated.
+ */
+void *ssz_arena_grow(ssz_arena_t *arena, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * Releases every allocation at once while keeping the blocks for reuse.
+ *
+ * @param arena Pointer to the arena.
+ */
+void ssz_arena_reset(ssz_arena_t *arena);
+
+/**
+ * Frees every block of an arena.
+ *
+ * @param arena Pointer to the arena.
+ */
+void ssz_arena_free(ssz_arena_t *arena);
+
+/**
+ * Enumerates the kinds of storage a writer can write to.
+ */
+typedef enum
+{
+    SSZ_WRITER_FIXED,      /**< Caller-provided buffer; writing past its end fails. */
+    SSZ_WRITER_GROWABLE,   /**< One contiguous arena buffer, doubled when full. */
+    SSZ_WRITER_CHUNKED,    /**< A list of arena chunks; earlier output is never moved. */
+    SSZ_WRITER_STREAM      /**< Caller-provided buffer handed to a write callback each time it fills. */
+} ssz_writer_kind_t;
+
+/**
+ * Callback receiving the output of a stream writer.
+ *
+ * @param ctx Context pointer given to ssz_writer_init_stream.
+ * @param bytes Bytes to consume.
+ * @param len Number of bytes, at most the writer's buffer size.
+ * @return SSZ_SUCCESS if every byte was consumed, or an error code, which the writer passes on.
+ */
+typedef ssz_error_t (*ssz_write_fn)(void *ctx, const uint8_t *bytes, size_t len);
+
+/**
+ * One chunk of the output of a chunked writer.
+ */
+typedef struct ssz_writer_chunk
+{
+    struct ssz_writer_chunk *next;  /**< Next chunk, or NULL. */
+    uint8_t *data;                  /**< Bytes of the chunk. */
+    size_t length;                  /**< Number of bytes written to the chunk. */
+    size_t capacity;                /**< Number of bytes the chunk can hold. */
+} ssz_writer_chunk_t;
+
+/**
+ * Represents an output sink for serialization.
+ *
+ * Serializers reserve a contiguous run of bytes at the write position, fill it and advance, so
+ * they never need to know how much room is left. A fixed writer fails with
+ * SSZ_ERROR_SERIALIZATION when the buffer is full; a growable writer keeps its output contiguous
+ * by doubling its buffer in the arena; a chunked writer appends new chunks instead of copying,
+ * which suits large outputs that are sent or written out piece by piece; a stream writer hands its
+ * buffer to a callback whenever it fills, so output of any size takes only the buffer's memory.
+ */
+typedef struct
+{
+    ssz_writer_kind_t kind;       /**< Kind of storage. */
+    uint8_t *buf;                 /**< Buffer of the current region (the current chunk if chunked). */
+    size_t length;                /**< Bytes written to the current region. */
+    size_t capacity;              /**< Capacity of the current region. */
+    size_t flushed;               /**< Bytes in the chunks before the current one. */
+    ssz_arena_t *arena;           /**< Arena backing growable and chunked writers, else NULL. */
+    ssz_writer_chunk_t *head;     /**< First chunk of a chunked writer. */
+    ssz_writer_chunk_t *tail;     /**< Current chunk of a chunked writer. */
+    size_t chunk_size;            /**< Minimum capacity of a new chunk. */
+    ssz_write_fn write;           /**< Callback of a stream writer, else NULL. */
+    void *ctx;                    /**< Context passed to the callback. */
+} ssz_writer_t;
+
+/**
+ * Initializes a writer over a caller-provided buffer.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param buf Output buffer.
+ * @param capacity Size of the output buffer in bytes.
+ */
+void ssz_writer_init_fixed(ssz_writer_t *writer, uint8_t *buf, size_t capacity);
+
+/**
+ * Initializes a writer whose output is one contiguous buffer allocated from an arena.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param arena Arena providing the buffer.
+ * @param initial_capacity Initial buffer size in bytes; 0 selects a small default.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_writer_init_growable(ssz_writer_t *writer, ssz_arena_t *arena, size_t initial_capacity);
+
+/**
+ * Initializes a writer whose output is a list of chunks allocated from an arena.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param arena Arena providing the chunks.
+ * @param chunk_size Minimum capacity of each chunk; 0 selects a default.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_writer_init_chunked(ssz_writer_t *writer, ssz_arena_t *arena, size_t chunk_size);
+
+/**
+ * Initializes a writer that streams its output through a callback.
+ *
+ * Bytes are collected in buf and passed to write whenever the next reservation does not fit, so
+ * no call receives more than capacity bytes and no other memory is used. ssz_writer_flush passes
+ * on the bytes still buffered once serialization is done.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param buf Buffer collecting the output; it must hold the largest single reservation.
+ * @param capacity Size of the buffer in bytes.
+ * @param write Callback receiving the output.
+ * @param ctx Context pointer passed to the callback.
+ */
+void ssz_writer_init_stream(ssz_writer_t *writer, uint8_t *buf, size_t capacity, ssz_write_fn write, void *ctx);
+
+/**
+ * Returns a pointer to size contiguous bytes at the write position, growing the output if
+ * needed. The bytes become part of the output only after ssz_writer_advance.
+ *
+ * @param writer Pointer to the writer.
+ * @param size Number of bytes needed.
+ * @return Pointer to the bytes, or NULL if a fixed writer is full, a stream writer's buffer is
+ *         smaller than size or its callback failed, or allocation failed.
+ */
+uint8_t *ssz_writer_reserve(ssz_writer_t *writer, size_t size);
+
+/**
+ * Appends bytes filled in after ssz_writer_reserve to the output.
+ *
+ * @param writer Pointer to the writer.
+ * @param size Number of bytes written, at most the size reserved.
+ */
+static inline void ssz_writer_advance(ssz_writer_t *writer, size_t size)
+{
+    writer->length += size;
+}
+
+/**
+ * Appends bytes to the output. A chunked or stream writer may split them across chunks.
+ *
+ * @param writer Pointer to the writer.
+ * @param data Bytes to append.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the writer is full.
+ */
+ssz_error_t ssz_writer_write(ssz_writer_t *writer, const uint8_t *data, size_t size);
+
+/**
+ * Appends an array of unsigned integers in little-endian order.
+ *
+ * @param writer Pointer to the writer.
+ * @param values Pointer to count values of value_size bytes each.
+ * @param count Number of values.
+ * @param value_size Size of one value in bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the writer is full.
+ */
+ssz_error_t ssz_writer_append_le(ssz_writer_t *writer, const void *values, size_t count, size_t value_size);
+
+/**
+ * Passes the bytes buffered by a stream writer to its callback. Other writers keep all of their
+ * output, so this does nothing for them.
+ *
+ * @param writer Pointer to the writer.
+ * @return SSZ_SUCCESS on success, or the error returned by the callback.
+ */
+ssz_error_t ssz_writer_flush(ssz_writer_t *writer);
+
+/**
+ * Overwrites bytes already written, e.g. an offset whose value was not known when it was
+ * written.
+ *
+ * @param writer Pointer to the writer.
+ * @param position Position of the first byte from the start of the output.
+ * @param data Replacement bytes.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if the range was not written yet or,
+ *         for a stream writer, was already passed to the callback.
+ */
+ssz_error_t ssz_writer_patch(ssz_writer_t *writer, size_t position, const uint8_t *data, size_t size);
+
+/**
+ * Returns the number of bytes written.
+ *
+ * @param writer Pointer to the writer.
+ * @return The size of the output.
+ */
+static inline size_t ssz_writer_size(const ssz_writer_t *writer)
+{
+    return writer->flushed + writer->length;
+}
+
+/**
+ * Returns the output of a fixed or growable writer, of a chunked writer with one chunk, or of a
+ * stream writer that has not flushed yet.
+ *
+ * @param writer Pointer to the writer.
+ * @return Pointer to the contiguous output, or NULL if it spans several chunks.
+ */
+const uint8_t *ssz_writer_data(const ssz_writer_t *writer);
+
+/**
+ * Copies the output of any writer into a contiguous buffer.
+ *
+ * @param writer Pointer to the writer.
+ * @param out_buf Output buffer of at least ssz_writer_size bytes.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes copied.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the buffer is too small or a
+ *         stream writer has already flushed part of its output.
+ */
+ssz_error_t ssz_writer_copy(const ssz_writer_t *writer, uint8_t *out_buf, size_t *out_size);
+
+/**
+ * Discards the output so the writer can be reused. A growable writer keeps its buffer; a chunked
+ * writer keeps its first chunk. Arena memory is reclaimed by ssz_arena_reset.
+ *
+ * @param writer Pointer to the writer.
+ */
+void ssz_writer_reset(ssz_writer_t *writer);
+
+/**
+ * Appends a little-endian uint32, e.g. an SSZ offset.
+ *
+ * @param writer Pointer to the writer.
+ * @param value The value.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the writer is full.
+ */
+static inline ssz_error_t ssz_writer_put_uint32(ssz_writer_t *writer, uint32_t value)
+{
+    uint8_t *p = ssz_writer_reserve(writer, SSZ_BYTE_SIZE_OF_UINT32);
+    if (p == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    ssz_store_le32(p, value);
+    ssz_writer_advance(writer, SSZ_BYTE_SIZE_OF_UINT32);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Appends a little-endian uint64.
+ *
+ * @param writer Pointer to the writer.
+ * @param value The value.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the writer is full.
+ */
+static inline ssz_error_t ssz_writer_put_uint64(ssz_writer_t *writer, uint64_t value)
+{
+    uint8_t *p = ssz_writer_reserve(writer, SSZ_BYTE_SIZE_OF_UINT64);
+    if (p == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    ssz_store_le64(p, value);
+    ssz_writer_advance(writer, SSZ_BYTE_SIZE_OF_UINT64);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Runs a serializer with the out_buf/out_size interface directly into a writer.
+ *
+ * size bytes are reserved at the write position, the serializer writes into them, and the writer
+ * advances by the size the serializer reports.
+ *
+ * @param writer Pointer to the writer.
+ * @param size Maximum number of bytes the serializer writes, e.g. from ssz_size_<Type>.
+ * @param ser_func Serializer taking (value, out_buf, out_size).
+ * @param value Value passed to the serializer.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on failure.
+ */
+ssz_error_t ssz_writer_serialize(
+    ssz_writer_t *writer,
+    size_t size,
+    ssz_error_t (*ser_func)(const void *, uint8_t *, size_t *),
+    const void *value);
+
+#ifndef _WIN32
+/**
+ * Stream writer callback that writes to a file descriptor, retrying partial writes and EINTR.
+ *
+ * @param ctx Pointer to the int file descriptor.
+ * @param bytes Bytes to write.
+ * @param len Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if a write fails.
+ */
+ssz_error_t ssz_write_fd(void *ctx, const uint8_t *bytes, size_t len);
+#endif
+
+#endif /* SSZ_WRITER_H */
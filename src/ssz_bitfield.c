@@ -0,0 +1,323 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ssz_bitfield.h"
+#include "ssz_merkle.h"
+#include "ssz_inline.h"
+
+/**
+ * Copies the first byte_count bytes of the SSZ encoding of a word array.
+ *
+ * On little-endian hosts this is a memcpy; otherwise each byte is extracted from its word.
+ *
+ * @param words Pointer to the words.
+ * @param byte_count Number of bytes to copy.
+ * @param out Output buffer of at least byte_count bytes.
+ */
+static void ssz_bitfield_store_bytes(const uint64_t *words, size_t byte_count, uint8_t *out)
+{
+    if (SSZ_HOST_LITTLE_ENDIAN)
+    {
+        memcpy(out, words, byte_count);
+        return;
+    }
+    for (size_t i = 0; i < byte_count; i++)
+    {
+        out[i] = (uint8_t)(words[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+/**
+ * Fills a word array from SSZ-encoded bytes.
+ *
+ * The words must be zeroed beforehand so bytes past byte_count stay zero.
+ *
+ * @param bytes Pointer to the bytes.
+ * @param byte_count Number of bytes to load.
+ * @param words Output words, SSZ_BITFIELD_WORDS(byte_count * 8) of them, zeroed.
+ */
+static void ssz_bitfield_load_bytes(const uint8_t *bytes, size_t byte_count, uint64_t *words)
+{
+    if (SSZ_HOST_LITTLE_ENDIAN)
+    {
+        memcpy(words, bytes, byte_count);
+        return;
+    }
+    for (size_t i = 0; i < byte_count; i++)
+    {
+        words[i / 8] |= (uint64_t)bytes[i] << (8 * (i % 8));
+    }
+}
+
+/**
+ * Merkleizes the bits of a bitfield into a streaming context of the given chunk limit.
+ *
+ * Four words make a chunk. On little-endian hosts full chunks are pushed from the words in
+ * place and only the last partial chunk is assembled on the stack.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param chunk_limit Maximum number of chunks of the tree.
+ * @param out_root Output buffer for the root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code if the limit would be exceeded.
+ */
+static ssz_error_t ssz_bitfield_merkleize(const ssz_bitfield_t *bf, uint64_t chunk_limit, uint8_t *out_root)
+{
+    const size_t words_per_chunk = SSZ_BYTES_PER_CHUNK / sizeof(uint64_t);
+    size_t word_count = SSZ_BITFIELD_WORDS(bf->length);
+    size_t full_chunks = word_count / words_per_chunk;
+    ssz_merkleizer_t m;
+    ssz_error_t err = ssz_merkleizer_init(&m, chunk_limit);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    size_t i = 0;
+    if (SSZ_HOST_LITTLE_ENDIAN)
+    {
+        err = ssz_merkleizer_push_chunks(&m, (const uint8_t *)bf->words, full_chunks);
+        i = full_chunks;
+    }
+    for (; i < full_chunks && err == SSZ_SUCCESS; i++)
+    {
+        uint8_t chunk[SSZ_BYTES_PER_CHUNK];
+        ssz_bitfield_store_bytes(bf->words + i * words_per_chunk, SSZ_BYTES_PER_CHUNK, chunk);
+        err = ssz_merkleizer_push_chunk(&m, chunk);
+    }
+    if (err == SSZ_SUCCESS && word_count % words_per_chunk != 0)
+    {
+        uint8_t chunk[SSZ_BYTES_PER_CHUNK] = {0};
+        ssz_bitfield_store_bytes(bf->words + full_chunks * words_per_chunk,
+                                 (word_count % words_per_chunk) * sizeof(uint64_t), chunk);
+        err = ssz_merkleizer_push_chunk(&m, chunk);
+    }
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    return ssz_merkleizer_finalize(&m, out_root);
+}
+
+/**
+ * Initializes a bitfield of a given length with every bit cleared.
+ *
+ * @param bf Pointer to the bitfield to initialize.
+ * @param length Number of bits.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if allocation fails.
+ */
+ssz_error_t ssz_bitfield_init(ssz_bitfield_t *bf, size_t length)
+{
+    if (!bf)
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    bf->length = length;
+    bf->words = NULL;
+    if (length == 0)
+    {
+        return SSZ_SUCCESS;
+    }
+    bf->words = calloc(SSZ_BITFIELD_WORDS(length), sizeof(uint64_t));
+    if (!bf->words)
+    {
+        bf->length = 0;
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Releases the memory held by a bitfield and sets its length to 0.
+ *
+ * @param bf Pointer to the bitfield.
+ */
+void ssz_bitfield_free(ssz_bitfield_t *bf)
+{
+    if (!bf)
+    {
+        return;
+    }
+    free(bf->words);
+    bf->words = NULL;
+    bf->length = 0;
+}
+
+/**
+ * Serializes a bitfield as a bitvector of bf->length bits.
+ *
+ * @param bf Pointer to the bitfield; its length must be non-zero.
+ * @param out_buf Pointer to the output buffer to write the serialized data.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes written.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on failure.
+ */
+ssz_error_t ssz_serialize_bitfield_vector(const ssz_bitfield_t *bf, uint8_t *out_buf, size_t *out_size)
+{
+    if (!bf || !out_buf || !out_size || bf->length == 0 || !bf->words)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t byte_count = (bf->length + 7) / SSZ_BITS_PER_BYTE;
+    if (*out_size < byte_count)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    ssz_bitfield_store_bytes(bf->words, byte_count, out_buf);
+    *out_size = byte_count;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Serializes a bitfield as a bitlist, appending the delimiter bit.
+ *
+ * The data bytes are copied as a block and the delimiter is ORed into the byte that holds
+ * bit bf->length, which is a fresh zero byte when the length is a multiple of 8.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param out_buf Pointer to the output buffer to write the serialized data.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes written.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on failure.
+ */
+ssz_error_t ssz_serialize_bitfield_list(const ssz_bitfield_t *bf, uint8_t *out_buf, size_t *out_size)
+{
+    if (!bf || !out_buf || !out_size || (bf->length != 0 && !bf->words))
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t byte_count = bf->length / SSZ_BITS_PER_BYTE + 1;
+    if (*out_size < byte_count)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t data_bytes = (bf->length + 7) / SSZ_BITS_PER_BYTE;
+    if (data_bytes != 0)
+    {
+        ssz_bitfield_store_bytes(bf->words, data_bytes, out_buf);
+    }
+    if (data_bytes < byte_count)
+    {
+        out_buf[byte_count - 1] = 0;
+    }
+    out_buf[byte_count - 1] |= (uint8_t)(1u << (bf->length % SSZ_BITS_PER_BYTE));
+    *out_size = byte_count;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Deserializes a bitvector of a specified length into a newly allocated bitfield.
+ *
+ * @param buffer Pointer to the input buffer containing the serialized data.
+ * @param buffer_size The size of the input buffer in bytes; must be ceil(num_bits / 8).
+ * @param num_bits The number of bits in the bitvector; must be non-zero.
+ * @param out_bf Pointer to the bitfield to initialize; free it with ssz_bitfield_free.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the size is wrong, padding
+ *         bits are set or allocation fails.
+ */
+ssz_error_t ssz_deserialize_bitfield_vector(const uint8_t *buffer, size_t buffer_size, size_t num_bits, ssz_bitfield_t *out_bf)
+{
+    if (!buffer || !out_bf || num_bits == 0)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    size_t byte_count = (num_bits + 7) / SSZ_BITS_PER_BYTE;
+    if (buffer_size != byte_count)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    if (num_bits % SSZ_BITS_PER_BYTE != 0 && (buffer[byte_count - 1] >> (num_bits % SSZ_BITS_PER_BYTE)) != 0)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    if (ssz_bitfield_init(out_bf, num_bits) != SSZ_SUCCESS)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    ssz_bitfield_load_bytes(buffer, byte_count, out_bf->words);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Deserializes a bitlist into a newly allocated bitfield, dropping the delimiter bit.
+ *
+ * @param buffer Pointer to the input buffer containing the serialized data.
+ * @param buffer_size The size of the input buffer in bytes.
+ * @param max_bits The maximum number of bits in the bitlist.
+ * @param out_bf Pointer to the bitfield to initialize; free it with ssz_bitfield_free.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the delimiter is missing,
+ *         the bitlist is longer than max_bits or allocation fails.
+ */
+ssz_error_t ssz_deserialize_bitfield_list(const uint8_t *buffer, size_t buffer_size, size_t max_bits, ssz_bitfield_t *out_bf)
+{
+    if (!buffer || !out_bf || buffer_size == 0)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    uint8_t last_byte = buffer[buffer_size - 1];
+    if (last_byte == 0 || buffer_size - 1 > max_bits / SSZ_BITS_PER_BYTE)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    unsigned int delimiter = 7;
+    while (!(last_byte & (1u << delimiter)))
+    {
+        delimiter--;
+    }
+    size_t num_bits = (buffer_size - 1) * SSZ_BITS_PER_BYTE + delimiter;
+    if (num_bits > max_bits)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    if (ssz_bitfield_init(out_bf, num_bits) != SSZ_SUCCESS)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    size_t data_bytes = (num_bits + 7) / SSZ_BITS_PER_BYTE;
+    if (data_bytes != 0)
+    {
+        ssz_bitfield_load_bytes(buffer, data_bytes, out_bf->words);
+        if (delimiter != 0)
+        {
+            out_bf->words[num_bits / SSZ_BITFIELD_WORD_BITS] &= ~(1ULL << (num_bits % SSZ_BITFIELD_WORD_BITS));
+        }
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Computes the hash tree root of a bitfield as a bitvector of bf->length bits.
+ *
+ * @param bf Pointer to the bitfield; its length must be non-zero.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on failure.
+ */
+ssz_error_t ssz_hash_tree_root_bitfield_vector(const ssz_bitfield_t *bf, uint8_t *out_root)
+{
+    if (!bf || !out_root || bf->length == 0 || !bf->words)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    uint64_t chunk_limit = ((uint64_t)bf->length + SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE - 1) /
+                           (SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE);
+    return ssz_bitfield_merkleize(bf, chunk_limit, out_root);
+}
+
+/**
+ * Computes the hash tree root of a bitfield as a bitlist, mixing in its length.
+ *
+ * @param bf Pointer to the bitfield.
+ * @param max_bits Maximum number of bits in the bitlist; must be at least bf->length.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on failure.
+ */
+ssz_error_t ssz_hash_tree_root_bitfield_list(const ssz_bitfield_t *bf, size_t max_bits, uint8_t *out_root)
+{
+    if (!bf || !out_root || bf->length > max_bits || (bf->length != 0 && !bf->words))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    uint64_t chunk_limit = ((uint64_t)max_bits + SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE - 1) /
+                           (SSZ_BYTES_PER_CHUNK * SSZ_BITS_PER_BYTE);
+    ssz_error_t err = ssz_bitfield_merkleize(bf, chunk_limit, out_root);
+    if (err != SSZ_SUCCESS)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    return ssz_mix_in_length(out_root, bf->length, out_root);
+}
@@ -0,0 +1,890 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include "ssz_bits.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SSZ_BITS_HAVE_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define SSZ_BITS_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ * Groups the kernels of one backend.
+ */
+typedef struct
+{
+    void (*pack)(const bool *bits, size_t num_bits, uint8_t *out_bytes);
+    void (*unpack)(const uint8_t *bytes, size_t num_bits, bool *out_bits);
+    void (*bytes_or)(const uint8_t *a, const uint8_t *b, size_t n, uint8_t *out);      /**< out = a | b. */
+    bool (*bytes_and_any)(const uint8_t *a, const uint8_t *b, size_t n);              /**< (a & b) != 0. */
+    bool (*bytes_andnot_any)(const uint8_t *a, const uint8_t *b, size_t n);           /**< (a & ~b) != 0. */
+    size_t (*bytes_popcount)(const uint8_t *a, size_t n);                             /**< Number of set bits. */
+} ssz_bits_kernels_t;
+
+/**
+ * Packs booleans eight at a time; also finishes the tail left by the SIMD kernels.
+ */
+static void bits_pack_scalar(const bool *bits, size_t num_bits, uint8_t *out_bytes)
+{
+    const size_t full_bytes = num_bits / 8;
+    for (size_t i = 0; i < full_bytes; i++)
+    {
+        const bool *b = bits + i * 8;
+        out_bytes[i] = (uint8_t)((b[0] << 0) | (b[1] << 1) | (b[2] << 2) | (b[3] << 3) |
+                                 (b[4] << 4) | (b[5] << 5) | (b[6] << 6) | (b[7] << 7));
+    }
+    if (num_bits % 8 != 0)
+    {
+        uint8_t value = 0;
+        for (size_t j = 0; j < num_bits % 8; j++)
+        {
+            value |= (uint8_t)(bits[full_bytes * 8 + j] << j);
+        }
+        out_bytes[full_bytes] = value;
+    }
+}
+
+/**
+ * Unpacks bytes eight bits at a time; also finishes the tail left by the SIMD kernels.
+ */
+static void bits_unpack_scalar(const uint8_t *bytes, size_t num_bits, bool *out_bits)
+{
+    const size_t full_bytes = num_bits / 8;
+    for (size_t i = 0; i < full_bytes; i++)
+    {
+        const uint8_t byte = bytes[i];
+        bool *b = out_bits + i * 8;
+        b[0] = (byte & 0x01) != 0;
+        b[1] = (byte & 0x02) != 0;
+        b[2] = (byte & 0x04) != 0;
+        b[3] = (byte & 0x08) != 0;
+        b[4] = (byte & 0x10) != 0;
+        b[5] = (byte & 0x20) != 0;
+        b[6] = (byte & 0x40) != 0;
+        b[7] = (byte & 0x80) != 0;
+    }
+    for (size_t j = 0; j < num_bits % 8; j++)
+    {
+        out_bits[full_bytes * 8 + j] = (bytes[full_bytes] >> j) & 1;
+    }
+}
+
+/**
+ * Counts the set bits of a 64-bit word with the usual SWAR reduction.
+ */
+static size_t popcount64(uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t)((x * 0x0101010101010101ULL) >> 56);
+}
+
+/**
+ * ORs two byte arrays eight bytes at a time; out may alias a or b.
+ */
+static void bytes_or_scalar(const uint8_t *a, const uint8_t *b, size_t n, uint8_t *out)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        wa |= wb;
+        memcpy(out + i, &wa, 8);
+    }
+    for (; i < n; i++)
+    {
+        out[i] = a[i] | b[i];
+    }
+}
+
+/**
+ * Tests whether two byte arrays share a set bit, eight bytes at a time.
+ */
+static bool bytes_and_any_scalar(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    uint64_t acc = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        acc |= wa & wb;
+    }
+    for (; i < n; i++)
+    {
+        acc |= a[i] & b[i];
+    }
+    return acc != 0;
+}
+
+/**
+ * Tests whether a has a set bit that b lacks, eight bytes at a time.
+ */
+static bool bytes_andnot_any_scalar(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    uint64_t acc = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        acc |= wa & ~wb;
+    }
+    for (; i < n; i++)
+    {
+        acc |= a[i] & (uint8_t)~b[i];
+    }
+    return acc != 0;
+}
+
+/**
+ * Counts the set bits of a byte array eight bytes at a time.
+ */
+static size_t bytes_popcount_scalar(const uint8_t *a, size_t n)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t w;
+        memcpy(&w, a + i, 8);
+        count += popcount64(w);
+    }
+    for (; i < n; i++)
+    {
+        count += popcount64(a[i]);
+    }
+    return count;
+}
+
+#ifdef SSZ_BITS_HAVE_X86
+/**
+ * Packs sixteen booleans per step: a byte compare against zero and movemask yield the inverted bits.
+ */
+__attribute__((target("sse2")))
+static void bits_pack_sse2(const bool *bits, size_t num_bits, uint8_t *out_bytes)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= num_bits; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(bits + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) ^ 0xFFFFu;
+        out_bytes[i / 8] = (uint8_t)mask;
+        out_bytes[i / 8 + 1] = (uint8_t)(mask >> 8);
+    }
+    bits_pack_scalar(bits + i, num_bits - i, out_bytes + i / 8);
+}
+
+/**
+ * Unpacks sixteen bits per step: each byte is broadcast over eight lanes, lane k is masked with
+ * 1 << k and compared, and the all-ones result is narrowed to 1.
+ */
+__attribute__((target("sse2")))
+static void bits_unpack_sse2(const uint8_t *bytes, size_t num_bits, bool *out_bits)
+{
+    const __m128i bit_mask = _mm_set1_epi64x((long long)0x8040201008040201ULL);
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 16 <= num_bits; i += 16)
+    {
+        uint64_t lo = bytes[i / 8] * 0x0101010101010101ULL;
+        uint64_t hi = bytes[i / 8 + 1] * 0x0101010101010101ULL;
+        __m128i v = _mm_and_si128(_mm_set_epi64x((long long)hi, (long long)lo), bit_mask);
+        v = _mm_and_si128(_mm_cmpeq_epi8(v, bit_mask), one);
+        _mm_storeu_si128((__m128i *)(out_bits + i), v);
+    }
+    bits_unpack_scalar(bytes + i / 8, num_bits - i, out_bits + i);
+}
+
+/**
+ * Packs thirty-two booleans per step with a 256-bit compare and movemask.
+ */
+__attribute__((target("avx2")))
+static void bits_pack_avx2(const bool *bits, size_t num_bits, uint8_t *out_bytes)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= num_bits; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(bits + i));
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+        memcpy(out_bytes + i / 8, &mask, sizeof(mask));
+    }
+    bits_pack_sse2(bits + i, num_bits - i, out_bytes + i / 8);
+}
+
+/**
+ * Unpacks thirty-two bits per step: four bytes are broadcast and a byte shuffle spreads byte j
+ * over lanes 8j..8j+7 before the mask and compare.
+ */
+__attribute__((target("avx2")))
+static void bits_unpack_avx2(const uint8_t *bytes, size_t num_bits, bool *out_bits)
+{
+    const __m256i spread = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit_mask = _mm256_set1_epi64x((long long)0x8040201008040201ULL);
+    const __m256i one = _mm256_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 32 <= num_bits; i += 32)
+    {
+        uint32_t word;
+        memcpy(&word, bytes + i / 8, sizeof(word));
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)word), spread);
+        v = _mm256_and_si256(v, bit_mask);
+        v = _mm256_and_si256(_mm256_cmpeq_epi8(v, bit_mask), one);
+        _mm256_storeu_si256((__m256i *)(out_bits + i), v);
+    }
+    bits_unpack_sse2(bytes + i / 8, num_bits - i, out_bits + i);
+}
+
+/**
+ * ORs sixteen bytes per step.
+ */
+__attribute__((target("sse2")))
+static void bytes_or_sse2(const uint8_t *a, const uint8_t *b, size_t n, uint8_t *out)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_or_si128(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+        _mm_storeu_si128((__m128i *)(out + i), v);
+    }
+    bytes_or_scalar(a + i, b + i, n - i, out + i);
+}
+
+/**
+ * Accumulates a & b sixteen bytes per step and tests the accumulator once at the end.
+ */
+__attribute__((target("sse2")))
+static bool bytes_and_any_sse2(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc = _mm_or_si128(acc, _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + i)),
+                                              _mm_loadu_si128((const __m128i *)(b + i))));
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xFFFF)
+    {
+        return true;
+    }
+    return bytes_and_any_scalar(a + i, b + i, n - i);
+}
+
+/**
+ * Accumulates a & ~b sixteen bytes per step and tests the accumulator once at the end.
+ */
+__attribute__((target("sse2")))
+static bool bytes_andnot_any_sse2(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc = _mm_or_si128(acc, _mm_andnot_si128(_mm_loadu_si128((const __m128i *)(b + i)),
+                                                 _mm_loadu_si128((const __m128i *)(a + i))));
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xFFFF)
+    {
+        return true;
+    }
+    return bytes_andnot_any_scalar(a + i, b + i, n - i);
+}
+
+/**
+ * Counts set bits sixteen bytes per step: a SWAR reduction to per-byte counts, then a sum of
+ * absolute differences against zero folds each half into a 64-bit lane.
+ */
+__attribute__((target("sse2")))
+static size_t bytes_popcount_sse2(const uint8_t *a, size_t n)
+{
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0F);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi16(x, 1), m1));
+        x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi16(x, 2), m2));
+        x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi16(x, 4)), m4);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(x, _mm_setzero_si128()));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    return (size_t)(lanes[0] + lanes[1]) + bytes_popcount_scalar(a + i, n - i);
+}
+
+/**
+ * ORs thirty-two bytes per step.
+ */
+__attribute__((target("avx2")))
+static void bytes_or_avx2(const uint8_t *a, const uint8_t *b, size_t n, uint8_t *out)
+{
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i)));
+        _mm256_storeu_si256((__m256i *)(out + i), v);
+    }
+    bytes_or_sse2(a + i, b + i, n - i, out + i);
+}
+
+/**
+ * Accumulates a & b thirty-two bytes per step and tests the accumulator once at the end.
+ */
+__attribute__((target("avx2")))
+static bool bytes_and_any_avx2(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc = _mm256_or_si256(acc, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                                    _mm256_loadu_si256((const __m256i *)(b + i))));
+    }
+    if (!_mm256_testz_si256(acc, acc))
+    {
+        return true;
+    }
+    return bytes_and_any_sse2(a + i, b + i, n - i);
+}
+
+/**
+ * Accumulates a & ~b thirty-two bytes per step and tests the accumulator once at the end.
+ */
+__attribute__((target("avx2")))
+static bool bytes_andnot_any_avx2(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc = _mm256_or_si256(acc, _mm256_andnot_si256(_mm256_loadu_si256((const __m256i *)(b + i)),
+                                                       _mm256_loadu_si256((const __m256i *)(a + i))));
+    }
+    if (!_mm256_testz_si256(acc, acc))
+    {
+        return true;
+    }
+    return bytes_andnot_any_sse2(a + i, b + i, n - i);
+}
+
+/**
+ * Counts set bits thirty-two bytes per step with a nibble lookup table in a byte shuffle.
+ */
+__attribute__((target("avx2")))
+static size_t bytes_popcount_avx2(const uint8_t *a, size_t n)
+{
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_nibble));
+        __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_nibble));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + bytes_popcount_sse2(a + i, n - i);
+}
+
+static bool sse2_supported(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+    return (edx & (1u << 26)) != 0;
+}
+
+static bool os_saves_ymm(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 27)))
+    {
+        return false;
+    }
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (lo & 0x06) == 0x06;
+}
+
+static bool avx2_supported(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, NULL) < 7)
+    {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0 && os_saves_ymm();
+}
+#endif
+
+#ifdef SSZ_BITS_HAVE_NEON
+/**
+ * Packs sixteen booleans per step: nonzero lanes become all-ones, lane k keeps bit k % 8 and
+ * each half is summed across lanes into one byte.
+ */
+static void bits_pack_neon(const bool *bits, size_t num_bits, uint8_t *out_bytes)
+{
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t bit_mask = vld1q_u8(weights);
+    size_t i = 0;
+    for (; i + 16 <= num_bits; i += 16)
+    {
+        uint8x16_t v = vld1q_u8((const uint8_t *)(bits + i));
+        v = vandq_u8(vtstq_u8(v, v), bit_mask);
+        out_bytes[i / 8] = vaddv_u8(vget_low_u8(v));
+        out_bytes[i / 8 + 1] = vaddv_u8(vget_high_u8(v));
+    }
+    bits_pack_scalar(bits + i, num_bits - i, out_bytes + i / 8);
+}
+
+/**
+ * Unpacks sixteen bits per step: each byte is duplicated over eight lanes and tested against 1 << k.
+ */
+static void bits_unpack_neon(const uint8_t *bytes, size_t num_bits, bool *out_bits)
+{
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t bit_mask = vld1q_u8(weights);
+    const uint8x16_t one = vdupq_n_u8(1);
+    size_t i = 0;
+    for (; i + 16 <= num_bits; i += 16)
+    {
+        uint8x16_t v = vcombine_u8(vdup_n_u8(bytes[i / 8]), vdup_n_u8(bytes[i / 8 + 1]));
+        vst1q_u8((uint8_t *)(out_bits + i), vandq_u8(vtstq_u8(v, bit_mask), one));
+    }
+    bits_unpack_scalar(bytes + i / 8, num_bits - i, out_bits + i);
+}
+
+/**
+ * ORs sixteen bytes per step.
+ */
+static void bytes_or_neon(const uint8_t *a, const uint8_t *b, size_t n, uint8_t *out)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        vst1q_u8(out + i, vorrq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+    bytes_or_scalar(a + i, b + i, n - i, out + i);
+}
+
+/**
+ * Accumulates a & b sixteen bytes per step and tests the accumulator once at the end.
+ */
+static bool bytes_and_any_neon(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    uint8x16_t acc = vdupq_n_u8(0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc = vorrq_u8(acc, vandq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+    if (vmaxvq_u8(acc) != 0)
+    {
+        return true;
+    }
+    return bytes_and_any_scalar(a + i, b + i, n - i);
+}
+
+/**
+ * Accumulates a & ~b sixteen bytes per step and tests the accumulator once at the end.
+ */
+static bool bytes_andnot_any_neon(const uint8_t *a, const uint8_t *b, size_t n)
+{
+    uint8x16_t acc = vdupq_n_u8(0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc = vorrq_u8(acc, vbicq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+    if (vmaxvq_u8(acc) != 0)
+    {
+        return true;
+    }
+    return bytes_andnot_any_scalar(a + i, b + i, n - i);
+}
+
+/**
+ * Counts set bits sixteen bytes per step with the per-byte count instruction.
+ */
+static size_t bytes_popcount_neon(const uint8_t *a, size_t n)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        count += vaddlvq_u8(vcntq_u8(vld1q_u8(a + i)));
+    }
+    return count + bytes_popcount_scalar(a + i, n - i);
+}
+#endif
+
+static const ssz_bits_kernels_t scalar_kernels = {
+    bits_pack_scalar, bits_unpack_scalar,
+    bytes_or_scalar, bytes_and_any_scalar, bytes_andnot_any_scalar, bytes_popcount_scalar};
+#ifdef SSZ_BITS_HAVE_X86
+static const ssz_bits_kernels_t sse2_kernels = {
+    bits_pack_sse2, bits_unpack_sse2,
+    bytes_or_sse2, bytes_and_any_sse2, bytes_andnot_any_sse2, bytes_popcount_sse2};
+static const ssz_bits_kernels_t avx2_kernels = {
+    bits_pack_avx2, bits_unpack_avx2,
+    bytes_or_avx2, bytes_and_any_avx2, bytes_andnot_any_avx2, bytes_popcount_avx2};
+#endif
+#ifdef SSZ_BITS_HAVE_NEON
+static const ssz_bits_kernels_t neon_kernels = {
+    bits_pack_neon, bits_unpack_neon,
+    bytes_or_neon, bytes_and_any_neon, bytes_andnot_any_neon, bytes_popcount_neon};
+#endif
+
+static const ssz_bits_kernels_t *active_kernels = NULL;
+static ssz_bits_backend_t active_backend = SSZ_BITS_BACKEND_COUNT;
+static pthread_once_t default_backend_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Points the active kernels at a backend that is known to be available.
+ */
+static void apply_backend(ssz_bits_backend_t backend)
+{
+    switch (backend)
+    {
+#ifdef SSZ_BITS_HAVE_X86
+    case SSZ_BITS_BACKEND_SSE2:
+        active_kernels = &sse2_kernels;
+        break;
+    case SSZ_BITS_BACKEND_AVX2:
+        active_kernels = &avx2_kernels;
+        break;
+#endif
+#ifdef SSZ_BITS_HAVE_NEON
+    case SSZ_BITS_BACKEND_NEON:
+        active_kernels = &neon_kernels;
+        break;
+#endif
+    default:
+        active_kernels = &scalar_kernels;
+        break;
+    }
+    active_backend = backend;
+}
+
+/**
+ * Selects the widest available kernel. Runs exactly once through default_backend_once, so
+ * threads that first use the kernels concurrently, such as parallel serialization workers,
+ * all see the same, fully set up table.
+ */
+static void select_default_backend(void)
+{
+    static const ssz_bits_backend_t preference[] = {
+        SSZ_BITS_BACKEND_AVX2,
+        SSZ_BITS_BACKEND_NEON,
+        SSZ_BITS_BACKEND_SSE2,
+        SSZ_BITS_BACKEND_SCALAR};
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++)
+    {
+        if (ssz_bits_backend_available(preference[i]))
+        {
+            apply_backend(preference[i]);
+            return;
+        }
+    }
+}
+
+/**
+ * Returns the active kernels, selecting the widest available ones on first use.
+ */
+static const ssz_bits_kernels_t *kernels(void)
+{
+    pthread_once(&default_backend_once, select_default_backend);
+    return active_kernels;
+}
+
+/**
+ * Reads the bit length of a serialized bitlist from its delimiter.
+ *
+ * @param bytes Pointer to the serialized bitlist.
+ * @param byte_count Number of serialized bytes.
+ * @param out_bits Pointer to store the number of data bits.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the delimiter is missing.
+ */
+static ssz_error_t bitlist_length(const uint8_t *bytes, size_t byte_count, size_t *out_bits)
+{
+    if (!bytes || byte_count == 0 || bytes[byte_count - 1] == 0)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    unsigned int delimiter = 7;
+    while (!(bytes[byte_count - 1] & (1u << delimiter)))
+    {
+        delimiter--;
+    }
+    *out_bits = (byte_count - 1) * 8 + delimiter;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Checks that two serialized bitlists are well formed and have the same length.
+ *
+ * @param a Pointer to the first serialized bitlist.
+ * @param b Pointer to the second serialized bitlist.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out_bits Pointer to store the common number of data bits.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+static ssz_error_t bitlist_pair_length(const uint8_t *a, const uint8_t *b, size_t byte_count, size_t *out_bits)
+{
+    size_t a_bits, b_bits;
+    if (bitlist_length(a, byte_count, &a_bits) != SSZ_SUCCESS ||
+        bitlist_length(b, byte_count, &b_bits) != SSZ_SUCCESS)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    if (a_bits != b_bits)
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    *out_bits = a_bits;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Packs an array of booleans into bytes, least significant bit first.
+ *
+ * @param bits Pointer to num_bits booleans.
+ * @param num_bits Number of bits to pack.
+ * @param out_bytes Output buffer of at least ceil(num_bits / 8) bytes.
+ */
+void ssz_bits_pack(const bool *bits, size_t num_bits, uint8_t *out_bytes)
+{
+    kernels()->pack(bits, num_bits, out_bytes);
+}
+
+/**
+ * Unpacks bytes into an array of booleans, least significant bit first.
+ *
+ * @param bytes Pointer to at least ceil(num_bits / 8) bytes.
+ * @param num_bits Number of bits to unpack.
+ * @param out_bits Output buffer of at least num_bits booleans.
+ */
+void ssz_bits_unpack(const uint8_t *bytes, size_t num_bits, bool *out_bits)
+{
+    kernels()->unpack(bytes, num_bits, out_bits);
+}
+
+/**
+ * Computes the union of two serialized bitlists of the same length.
+ *
+ * Both delimiters sit at the same bit, so ORing every byte keeps exactly one delimiter.
+ *
+ * @param a Pointer to the first serialized bitlist.
+ * @param b Pointer to the second serialized bitlist.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out Output buffer of byte_count bytes; may alias a or b.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+ssz_error_t ssz_bitlist_union(const uint8_t *a, const uint8_t *b, size_t byte_count, uint8_t *out)
+{
+    size_t bit_count;
+    ssz_error_t err = bitlist_pair_length(a, b, byte_count, &bit_count);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    if (!out)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    kernels()->bytes_or(a, b, byte_count, out);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Tests whether two serialized bitlists of the same length share a set bit.
+ *
+ * The last byte is tested on its own with the delimiter masked off.
+ *
+ * @param a Pointer to the first serialized bitlist.
+ * @param b Pointer to the second serialized bitlist.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out_result Pointer to store true if some bit is set in both bitlists.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+ssz_error_t ssz_bitlist_intersects(const uint8_t *a, const uint8_t *b, size_t byte_count, bool *out_result)
+{
+    size_t bit_count;
+    ssz_error_t err = bitlist_pair_length(a, b, byte_count, &bit_count);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    if (!out_result)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    uint8_t last = (uint8_t)(a[byte_count - 1] & b[byte_count - 1] & ~(1u << (bit_count % 8)));
+    *out_result = last != 0 || kernels()->bytes_and_any(a, b, byte_count - 1);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Tests whether every bit set in one serialized bitlist is also set in another of the same length.
+ *
+ * The delimiters are set in both and cancel out, so every byte goes through the kernel.
+ *
+ * @param a Pointer to the candidate subset.
+ * @param b Pointer to the candidate superset.
+ * @param byte_count Number of serialized bytes of each bitlist.
+ * @param out_result Pointer to store true if a is a subset of b.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if a delimiter is missing, or
+ *         SSZ_ERROR_OUT_OF_RANGE if the lengths differ.
+ */
+ssz_error_t ssz_bitlist_is_subset(const uint8_t *a, const uint8_t *b, size_t byte_count, bool *out_result)
+{
+    size_t bit_count;
+    ssz_error_t err = bitlist_pair_length(a, b, byte_count, &bit_count);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    if (!out_result)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    *out_result = !kernels()->bytes_andnot_any(a, b, byte_count);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Counts the set bits of a serialized bitlist, not counting the delimiter.
+ *
+ * @param bytes Pointer to the serialized bitlist.
+ * @param byte_count Number of serialized bytes.
+ * @param out_count Pointer to store the number of set bits.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_DESERIALIZATION if the delimiter is missing.
+ */
+ssz_error_t ssz_bitlist_popcount(const uint8_t *bytes, size_t byte_count, size_t *out_count)
+{
+    size_t bit_count;
+    if (bitlist_length(bytes, byte_count, &bit_count) != SSZ_SUCCESS || !out_count)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    *out_count = kernels()->bytes_popcount(bytes, byte_count) - 1;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Checks whether a kernel is compiled in and supported by the running CPU.
+ *
+ * The SIMD kernels treat each bool as one byte, so they are only offered where it is.
+ *
+ * @param backend The backend to check.
+ * @return true if the backend can be selected, otherwise false.
+ */
+bool ssz_bits_backend_available(ssz_bits_backend_t backend)
+{
+    if (backend != SSZ_BITS_BACKEND_SCALAR && sizeof(bool) != 1)
+    {
+        return false;
+    }
+    switch (backend)
+    {
+    case SSZ_BITS_BACKEND_SCALAR:
+        return true;
+#ifdef SSZ_BITS_HAVE_X86
+    case SSZ_BITS_BACKEND_SSE2:
+        return sse2_supported();
+    case SSZ_BITS_BACKEND_AVX2:
+        return sse2_supported() && avx2_supported();
+#endif
+#ifdef SSZ_BITS_HAVE_NEON
+    case SSZ_BITS_BACKEND_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * Returns the kernel currently used by the ssz_bits and ssz_bitlist functions.
+ *
+ * @return The active backend.
+ */
+ssz_bits_backend_t ssz_bits_get_backend(void)
+{
+    kernels();
+    return active_backend;
+}
+
+/**
+ * Overrides the kernel selected at startup.
+ *
+ * The default selection is completed first so that it cannot later replace the override.
+ * The override itself is not synchronized and must not race with other threads using the kernels.
+ *
+ * @param backend The backend to use.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if the backend is not available.
+ */
+ssz_error_t ssz_bits_set_backend(ssz_bits_backend_t backend)
+{
+    if (!ssz_bits_backend_available(backend))
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    pthread_once(&default_backend_once, select_default_backend);
+    apply_backend(backend);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Returns a human-readable name for a kernel.
+ *
+ * @param backend The backend.
+ * @return A static string naming the backend.
+ */
+const char *ssz_bits_backend_name(ssz_bits_backend_t backend)
+{
+    switch (backend)
+    {
+    case SSZ_BITS_BACKEND_SCALAR:
+        return "scalar";
+    case SSZ_BITS_BACKEND_SSE2:
+        return "sse2";
+    case SSZ_BITS_BACKEND_AVX2:
+        return "avx2";
+    case SSZ_BITS_BACKEND_NEON:
+        return "neon";
+    default:
+        return "unknown";
+    }
+}
@@ -6,7 +6,9 @@
 #include "ssz_deserialize.h"
 #include "ssz_constants.h"
 #include "ssz_types.h"
+#include "ssz_inline.h"
 #include "ssz_utils.h"
+#include "ssz_bits.h"
 
 /**
  * Deserializes an 8-bit unsigned integer from a single byte.
@@ -40,7 +42,7 @@ ssz_error_t ssz_deserialize_uint16(const uint8_t *buffer, size_t buffer_size, vo
     {
         return SSZ_ERROR_DESERIALIZATION;
     }
-    uint16_t val = (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+    uint16_t val = ssz_load_le16(buffer);
     memcpy(out_value, &val, sizeof(val));
     return SSZ_SUCCESS;
 }
@@ -59,12 +61,8 @@ ssz_error_t ssz_deserialize_uint32(const uint8_t *buffer, size_t buffer_size, vo
     {
         return SSZ_ERROR_DESERIALIZATION;
     }
-    uint32_t val = 0;
-    val |= (uint32_t)buffer[0];
-    val |= (uint32_t)buffer[1] << 8;
-    val |= (uint32_t)buffer[2] << 16;
-    val |= (uint32_t)buffer[3] << 24;
-    *(uint32_t *)out_value = val;
+    uint32_t val = ssz_load_le32(buffer);
+    memcpy(out_value, &val, sizeof(val));
     return SSZ_SUCCESS;
 }
 
@@ -82,16 +80,8 @@ ssz_error_t ssz_deserialize_uint64(const uint8_t *buffer, size_t buffer_size, vo
     {
         return SSZ_ERROR_DESERIALIZATION;
     }
-    uint64_t val = 0;
-    val |= (uint64_t)buffer[0];
-    val |= (uint64_t)buffer[1] << 8;
-    val |= (uint64_t)buffer[2] << 16;
-    val |= (uint64_t)buffer[3] << 24;
-    val |= (uint64_t)buffer[4] << 32;
-    val |= (uint64_t)buffer[5] << 40;
-    val |= (uint64_t)buffer[6] << 48;
-    val |= (uint64_t)buffer[7] << 56;
-    *(uint64_t *)out_value = val;
+    uint64_t val = ssz_load_le64(buffer);
+    memcpy(out_value, &val, sizeof(val));
     return SSZ_SUCCESS;
 }
 
@@ -109,20 +99,7 @@ ssz_error_t ssz_deserialize_uint128(const uint8_t *buffer, size_t buffer_size, v
     {
         return SSZ_ERROR_DESERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t *endian_check = (const uint8_t *)&test_value;
-    if (endian_check[0] == 0x01)
-    {
-        memcpy(out_value, buffer, 16);
-    }
-    else
-    {
-        uint8_t *dest = (uint8_t *)out_value;
-        for (size_t i = 0; i < 16; i++)
-        {
-            dest[i] = buffer[15 - i];
-        }
-    }
+    ssz_copy_le_bytes((uint8_t *)out_value, buffer, 16);
     return SSZ_SUCCESS;
 }
 
@@ -140,20 +117,7 @@ ssz_error_t ssz_deserialize_uint256(const uint8_t *buffer, size_t buffer_size, v
     {
         return SSZ_ERROR_DESERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
-    {
-        memcpy(out_value, buffer, 32);
-    }
-    else
-    {
-        uint8_t *dest = (uint8_t *)out_value;
-        for (size_t i = 0; i < 32; i++)
-        {
-            dest[i] = buffer[31 - i];
-        }
-    }
+    ssz_copy_le_bytes((uint8_t *)out_value, buffer, 32);
     return SSZ_SUCCESS;
 }
 
@@ -215,34 +179,12 @@ ssz_error_t ssz_deserialize_bitvector(
     {
         return SSZ_ERROR_DESERIALIZATION;
     }
-    const size_t full_bytes = num_bits / 8;
     const size_t remainder_bits = num_bits % 8;
-    bool *out_ptr = out_bits;
-    for (size_t i = 0; i < full_bytes; ++i)
-    {
-        const uint8_t byte = buffer[i];
-        *out_ptr++ = (byte & 0x01) != 0;
-        *out_ptr++ = (byte & 0x02) != 0;
-        *out_ptr++ = (byte & 0x04) != 0;
-        *out_ptr++ = (byte & 0x08) != 0;
-        *out_ptr++ = (byte & 0x10) != 0;
-        *out_ptr++ = (byte & 0x20) != 0;
-        *out_ptr++ = (byte & 0x40) != 0;
-        *out_ptr++ = (byte & 0x80) != 0;
-    }
-    if (remainder_bits > 0)
-    {
-        const uint8_t byte = buffer[full_bytes];
-        uint8_t mask = ~((1 << remainder_bits) - 1);
-        if (byte & mask)
-        {
-            return SSZ_ERROR_DESERIALIZATION;
-        }
-        for (size_t bit = 0; bit < remainder_bits; ++bit)
-        {
-            *out_ptr++ = (byte & (1 << bit)) != 0;
-        }
+    if (remainder_bits > 0 && (buffer[needed - 1] >> remainder_bits) != 0)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
     }
+    ssz_bits_unpack(buffer, num_bits, out_bits);
     return SSZ_SUCCESS;
 }
 
@@ -315,29 +257,7 @@ ssz_error_t ssz_deserialize_bitlist(
     {
         memset(out_bits + data_bits, 0, (max_bits - data_bits) * sizeof(bool));
     }
-    const size_t full_bytes = data_bits / 8;
-    const size_t rem_bits = data_bits % 8;
-    size_t i = 0;
-    for (; i < full_bytes; i++)
-    {
-        const uint8_t val = buffer[i];
-        out_bits[i * 8 + 0] = val & 0x01;
-        out_bits[i * 8 + 1] = val & 0x02;
-        out_bits[i * 8 + 2] = val & 0x04;
-        out_bits[i * 8 + 3] = val & 0x08;
-        out_bits[i * 8 + 4] = val & 0x10;
-        out_bits[i * 8 + 5] = val & 0x20;
-        out_bits[i * 8 + 6] = val & 0x40;
-        out_bits[i * 8 + 7] = val & 0x80;
-    }
-    if (rem_bits > 0)
-    {
-        const uint8_t val = buffer[full_bytes];
-        for (size_t bit = 0; bit < rem_bits; bit++)
-        {
-            out_bits[i * 8 + bit] = val & (1 << bit);
-        }
-    }
+    ssz_bits_unpack(buffer, data_bits, out_bits);
     return SSZ_SUCCESS;
 }
 
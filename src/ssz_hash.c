@@ -0,0 +1,1000 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include "mincrypt/sha256.h"
+#include "ssz_hash.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SSZ_HASH_HAVE_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define SSZ_HASH_HAVE_ARMV8 1
+#include <arm_neon.h>
+/* The SHA2 kernels are compiled for the crypto extension only, and selected at runtime. */
+#if defined(__clang__)
+#define SSZ_HASH_ARMV8_TARGET __attribute__((target("crypto")))
+#else
+#define SSZ_HASH_ARMV8_TARGET __attribute__((target("+crypto")))
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+/**
+ * Defines a function pointer type for a SHA-256 compression function.
+ *
+ * @param state The eight-word hash state, updated in place.
+ * @param blocks Pointer to block_count consecutive 64-byte message blocks.
+ * @param block_count Number of blocks to compress.
+ */
+typedef void (*sha256_compress_fn)(uint32_t state[8], const uint8_t *blocks, size_t block_count);
+
+/**
+ * Defines a function pointer type for a complete SHA-256 hash function.
+ */
+typedef void (*sha256_hash_fn)(const uint8_t *data, size_t len, uint8_t *out_digest);
+
+/**
+ * Defines a function pointer type for hashing consecutive 64-byte messages.
+ */
+typedef void (*sha256_64B_xN_fn)(const uint8_t *in, size_t count, uint8_t *out);
+
+/**
+ * Defines a function pointer type for hashing the concatenation of two 32-byte nodes.
+ */
+typedef void (*sha256_pair_fn)(const uint8_t *left, const uint8_t *right, uint8_t *out);
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/**
+ * Provides K[t] + W[t] for the second block of a 64-byte message.
+ * That block is always the 0x80 terminator followed by zeros and a 512-bit length, so its
+ * whole message schedule is constant and the expansion can be skipped.
+ */
+static const uint32_t sha256_pad64_wk[64] = {
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76};
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+#define SHA256_ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static inline uint32_t sha256_load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void sha256_store_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/**
+ * Runs the 64 SHA-256 rounds over a precomputed K + W schedule and adds the result into the state.
+ *
+ * @param state The eight-word hash state, updated in place.
+ * @param wk The 64 words K[t] + W[t].
+ */
+static void sha256_rounds_portable(uint32_t state[8], const uint32_t wk[64])
+{
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 64; t++)
+    {
+        uint32_t t1 = h + (SHA256_ROR(e, 6) ^ SHA256_ROR(e, 11) ^ SHA256_ROR(e, 25)) + ((e & f) ^ (~e & g)) + wk[t];
+        uint32_t t2 = (SHA256_ROR(a, 2) ^ SHA256_ROR(a, 13) ^ SHA256_ROR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/**
+ * Hashes the 64-byte concatenation of two nodes in portable C.
+ *
+ * Unlike the mincrypt state machine, this runs exactly two compressions, and the second one
+ * consumes the precomputed padding schedule. All input is read before out is written, so out
+ * may alias left or right.
+ */
+static void sha256_pair_portable(const uint8_t *left, const uint8_t *right, uint8_t *out)
+{
+    uint32_t w[64];
+    for (int t = 0; t < 8; t++)
+    {
+        w[t] = sha256_load_be32(left + 4 * t);
+        w[t + 8] = sha256_load_be32(right + 4 * t);
+    }
+    for (int t = 16; t < 64; t++)
+    {
+        uint32_t s0 = SHA256_ROR(w[t - 15], 7) ^ SHA256_ROR(w[t - 15], 18) ^ (w[t - 15] >> 3);
+        uint32_t s1 = SHA256_ROR(w[t - 2], 17) ^ SHA256_ROR(w[t - 2], 19) ^ (w[t - 2] >> 10);
+        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+    for (int t = 0; t < 64; t++)
+    {
+        w[t] += sha256_k[t];
+    }
+    uint32_t state[8];
+    memcpy(state, sha256_iv, sizeof(state));
+    sha256_rounds_portable(state, w);
+    sha256_rounds_portable(state, sha256_pad64_wk);
+    for (int i = 0; i < 8; i++)
+    {
+        sha256_store_be32(out + 4 * i, state[i]);
+    }
+}
+
+#if defined(SSZ_HASH_HAVE_X86) || defined(SSZ_HASH_HAVE_ARMV8)
+/**
+ * Computes a SHA-256 digest using the given compression function.
+ *
+ * Full blocks are compressed straight from the input; only the final one or two
+ * blocks holding the tail, the 0x80 terminator and the bit length are staged on the stack.
+ *
+ * @param compress The compression function.
+ * @param data Pointer to the input bytes.
+ * @param len Number of input bytes.
+ * @param out_digest Output buffer to write the digest (32 bytes).
+ */
+static void sha256_with_compress(sha256_compress_fn compress, const uint8_t *data, size_t len, uint8_t *out_digest)
+{
+    uint32_t state[8];
+    memcpy(state, sha256_iv, sizeof(state));
+    size_t full_blocks = len >> 6;
+    if (full_blocks)
+    {
+        compress(state, data, full_blocks);
+    }
+    uint8_t tail[128];
+    size_t rem = len & 63;
+    size_t tail_blocks = rem < 56 ? 1 : 2;
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, data + (full_blocks << 6), rem);
+    tail[rem] = 0x80;
+    uint64_t bit_len = (uint64_t)len << 3;
+    for (size_t i = 0; i < 8; i++)
+    {
+        tail[(tail_blocks << 6) - 1 - i] = (uint8_t)(bit_len >> (i * 8));
+    }
+    compress(state, tail, tail_blocks);
+    for (size_t i = 0; i < 8; i++)
+    {
+        out_digest[4 * i] = (uint8_t)(state[i] >> 24);
+        out_digest[4 * i + 1] = (uint8_t)(state[i] >> 16);
+        out_digest[4 * i + 2] = (uint8_t)(state[i] >> 8);
+        out_digest[4 * i + 3] = (uint8_t)(state[i]);
+    }
+}
+#endif
+
+/**
+ * Computes a SHA-256 digest with the portable mincrypt implementation.
+ */
+static void sha256_generic(const uint8_t *data, size_t len, uint8_t *out_digest)
+{
+    if (len <= INT_MAX)
+    {
+        SHA256_hash(data, (int)len, out_digest);
+        return;
+    }
+    SHA256_CTX ctx;
+    SHA256_init(&ctx);
+    while (len > 0)
+    {
+        int piece = len > INT_MAX ? INT_MAX : (int)len;
+        SHA256_update(&ctx, data, piece);
+        data += piece;
+        len -= (size_t)piece;
+    }
+    memcpy(out_digest, SHA256_final(&ctx), SHA256_DIGEST_SIZE);
+}
+
+#ifdef SSZ_HASH_HAVE_X86
+/**
+ * Compresses message blocks with the x86 SHA extensions.
+ *
+ * The state is kept in the ABEF/CDGH register layout expected by sha256rnds2, and the
+ * message schedule is expanded four words at a time with sha256msg1/sha256msg2.
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha256_compress_sha_ni(uint32_t state[8], const uint8_t *blocks, size_t block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (block_count--)
+    {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i msg[4];
+        for (int g = 0; g < 16; g++)
+        {
+            if (g < 4)
+            {
+                msg[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16 * g)), byte_swap);
+            }
+            else
+            {
+                __m128i w = _mm_sha256msg1_epu32(msg[g & 3], msg[(g + 1) & 3]);
+                w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(g + 3) & 3], msg[(g + 2) & 3], 4));
+                msg[g & 3] = _mm_sha256msg2_epu32(w, msg[(g + 3) & 3]);
+            }
+            __m128i wk = _mm_add_epi32(msg[g & 3], _mm_loadu_si128((const __m128i *)&sha256_k[4 * g]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+        }
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        blocks += 64;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+static void sha256_sha_ni(const uint8_t *data, size_t len, uint8_t *out_digest)
+{
+    sha256_with_compress(sha256_compress_sha_ni, data, len, out_digest);
+}
+
+/**
+ * Hashes the 64-byte concatenation of two nodes with the x86 SHA extensions.
+ *
+ * The message block is loaded straight from the two nodes and the padding block runs on
+ * sha256_pad64_wk, so no schedule is expanded for it. The digest is stored only after
+ * both nodes have been read, so out may alias left or right.
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha256_pair_sha_ni(const uint8_t *left, const uint8_t *right, uint8_t *out)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128((const __m128i *)&sha256_iv[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)&sha256_iv[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    __m128i abef_save = state0;
+    __m128i cdgh_save = state1;
+    __m128i msg[4];
+    msg[0] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)left), byte_swap);
+    msg[1] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(left + 16)), byte_swap);
+    msg[2] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)right), byte_swap);
+    msg[3] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(right + 16)), byte_swap);
+    for (int g = 0; g < 16; g++)
+    {
+        if (g >= 4)
+        {
+            __m128i w = _mm_sha256msg1_epu32(msg[g & 3], msg[(g + 1) & 3]);
+            w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(g + 3) & 3], msg[(g + 2) & 3], 4));
+            msg[g & 3] = _mm_sha256msg2_epu32(w, msg[(g + 3) & 3]);
+        }
+        __m128i wk = _mm_add_epi32(msg[g & 3], _mm_loadu_si128((const __m128i *)&sha256_k[4 * g]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+        wk = _mm_shuffle_epi32(wk, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+    }
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+
+    abef_save = state0;
+    cdgh_save = state1;
+    for (int g = 0; g < 16; g++)
+    {
+        __m128i wk = _mm_loadu_si128((const __m128i *)&sha256_pad64_wk[4 * g]);
+        state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+        wk = _mm_shuffle_epi32(wk, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+    }
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)out, _mm_shuffle_epi8(state0, byte_swap));
+    _mm_storeu_si128((__m128i *)(out + 16), _mm_shuffle_epi8(state1, byte_swap));
+}
+
+static bool sha_ni_supported(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+    bool has_ssse3 = (ecx & (1u << 9)) != 0;
+    bool has_sse41 = (ecx & (1u << 19)) != 0;
+    if (__get_cpuid_max(0, NULL) < 7)
+    {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    bool has_sha = (ebx & (1u << 29)) != 0;
+    return has_ssse3 && has_sse41 && has_sha;
+}
+
+/*
+ * Multi-buffer kernels: each SIMD lane holds the state of an independent 64-byte message,
+ * so one pass over the 64 rounds hashes 8 (AVX2) or 16 (AVX-512) sibling pairs at once.
+ * The second compression runs on the constant padding block using sha256_pad64_wk.
+ */
+#define SSZ_HASH_AVX2_LANES 8
+#define SSZ_HASH_AVX512_LANES 16
+
+#define AVX2_ROR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define AVX2_ADD3(a, b, c) _mm256_add_epi32(_mm256_add_epi32((a), (b)), (c))
+#define AVX2_ROUND(a, b, c, d, e, f, g, h, wk)                                                             \
+    do                                                                                                     \
+    {                                                                                                      \
+        __m256i _s1 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROR(e, 6), AVX2_ROR(e, 11)), AVX2_ROR(e, 25)); \
+        __m256i _ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));                \
+        __m256i _t1 = _mm256_add_epi32(AVX2_ADD3(h, _s1, _ch), (wk));                                      \
+        __m256i _s0 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROR(a, 2), AVX2_ROR(a, 13)), AVX2_ROR(a, 22)); \
+        __m256i _maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))); \
+        h = g;                                                                                             \
+        g = f;                                                                                             \
+        f = e;                                                                                             \
+        e = _mm256_add_epi32(d, _t1);                                                                      \
+        d = c;                                                                                             \
+        c = b;                                                                                             \
+        b = a;                                                                                             \
+        a = AVX2_ADD3(_t1, _s0, _maj);                                                                     \
+    } while (0)
+
+/**
+ * Transposes an 8x8 matrix of 32-bit words held in eight AVX2 registers.
+ */
+__attribute__((target("avx2")))
+static inline void avx2_transpose8(__m256i r[8])
+{
+    __m256i t[8], u[8];
+    for (int i = 0; i < 8; i += 2)
+    {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4)
+    {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+/**
+ * Hashes eight consecutive 64-byte messages into eight consecutive 32-byte digests.
+ * All input is loaded before any output is stored, so out may alias in.
+ */
+__attribute__((target("avx2")))
+static void sha256_64B_x8_avx2(const uint8_t *in, uint8_t *out)
+{
+    const __m256i byte_swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                              12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i w[16];
+    for (int half = 0; half < 2; half++)
+    {
+        for (int lane = 0; lane < SSZ_HASH_AVX2_LANES; lane++)
+        {
+            w[8 * half + lane] = _mm256_loadu_si256((const __m256i *)(in + 64 * lane + 32 * half));
+        }
+        avx2_transpose8(&w[8 * half]);
+    }
+    for (int t = 0; t < 16; t++)
+    {
+        w[t] = _mm256_shuffle_epi8(w[t], byte_swap);
+    }
+
+    __m256i s[8];
+    for (int i = 0; i < 8; i++)
+    {
+        s[i] = _mm256_set1_epi32((int)sha256_iv[i]);
+    }
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t++)
+    {
+        if (t >= 16)
+        {
+            __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROR(w15, 7), AVX2_ROR(w15, 18)), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROR(w2, 17), AVX2_ROR(w2, 19)), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(AVX2_ADD3(w[t & 15], s0, w[(t - 7) & 15]), s1);
+        }
+        AVX2_ROUND(a, b, c, d, e, f, g, h, _mm256_add_epi32(w[t & 15], _mm256_set1_epi32((int)sha256_k[t])));
+    }
+    s[0] = _mm256_add_epi32(s[0], a);
+    s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c);
+    s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e);
+    s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g);
+    s[7] = _mm256_add_epi32(s[7], h);
+
+    a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t++)
+    {
+        AVX2_ROUND(a, b, c, d, e, f, g, h, _mm256_set1_epi32((int)sha256_pad64_wk[t]));
+    }
+    s[0] = _mm256_add_epi32(s[0], a);
+    s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c);
+    s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e);
+    s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g);
+    s[7] = _mm256_add_epi32(s[7], h);
+
+    avx2_transpose8(s);
+    for (int lane = 0; lane < SSZ_HASH_AVX2_LANES; lane++)
+    {
+        _mm256_storeu_si256((__m256i *)(out + 32 * lane), _mm256_shuffle_epi8(s[lane], byte_swap));
+    }
+}
+
+#define AVX512_ROUND(a, b, c, d, e, f, g, h, wk)                                                                       \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        __m512i _s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96); \
+        __m512i _t1 = _mm512_add_epi32(_mm512_add_epi32(h, _s1), _mm512_add_epi32(_mm512_ternarylogic_epi32(e, f, g, 0xCA), (wk))); \
+        __m512i _s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96); \
+        __m512i _t2 = _mm512_add_epi32(_s0, _mm512_ternarylogic_epi32(a, b, c, 0xE8));                                \
+        h = g;                                                                                                         \
+        g = f;                                                                                                         \
+        f = e;                                                                                                         \
+        e = _mm512_add_epi32(d, _t1);                                                                                  \
+        d = c;                                                                                                         \
+        c = b;                                                                                                         \
+        b = a;                                                                                                         \
+        a = _mm512_add_epi32(_t1, _t2);                                                                                \
+    } while (0)
+
+/**
+ * Hashes sixteen consecutive 64-byte messages into sixteen consecutive 32-byte digests.
+ * All input is loaded before any output is stored, so out may alias in.
+ */
+__attribute__((target("avx512f,avx512bw")))
+static void sha256_64B_x16_avx512(const uint8_t *in, uint8_t *out)
+{
+    const __m512i byte_swap = _mm512_set4_epi32(0x0c0d0e0f, 0x08090a0b, 0x04050607, 0x00010203);
+    const __m512i in_index = _mm512_set_epi32(15 * 64, 14 * 64, 13 * 64, 12 * 64, 11 * 64, 10 * 64, 9 * 64, 8 * 64,
+                                              7 * 64, 6 * 64, 5 * 64, 4 * 64, 3 * 64, 2 * 64, 1 * 64, 0);
+    const __m512i out_index = _mm512_srli_epi32(in_index, 1);
+    __m512i w[16];
+    for (int t = 0; t < 16; t++)
+    {
+        w[t] = _mm512_shuffle_epi8(_mm512_i32gather_epi32(in_index, (const void *)(in + 4 * t), 1), byte_swap);
+    }
+
+    __m512i s[8];
+    for (int i = 0; i < 8; i++)
+    {
+        s[i] = _mm512_set1_epi32((int)sha256_iv[i]);
+    }
+    __m512i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t++)
+    {
+        if (t >= 16)
+        {
+            __m512i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18), _mm512_srli_epi32(w15, 3), 0x96);
+            __m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19), _mm512_srli_epi32(w2, 10), 0x96);
+            w[t & 15] = _mm512_add_epi32(_mm512_add_epi32(w[t & 15], s0), _mm512_add_epi32(w[(t - 7) & 15], s1));
+        }
+        AVX512_ROUND(a, b, c, d, e, f, g, h, _mm512_add_epi32(w[t & 15], _mm512_set1_epi32((int)sha256_k[t])));
+    }
+    s[0] = _mm512_add_epi32(s[0], a);
+    s[1] = _mm512_add_epi32(s[1], b);
+    s[2] = _mm512_add_epi32(s[2], c);
+    s[3] = _mm512_add_epi32(s[3], d);
+    s[4] = _mm512_add_epi32(s[4], e);
+    s[5] = _mm512_add_epi32(s[5], f);
+    s[6] = _mm512_add_epi32(s[6], g);
+    s[7] = _mm512_add_epi32(s[7], h);
+
+    a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t++)
+    {
+        AVX512_ROUND(a, b, c, d, e, f, g, h, _mm512_set1_epi32((int)sha256_pad64_wk[t]));
+    }
+    s[0] = _mm512_add_epi32(s[0], a);
+    s[1] = _mm512_add_epi32(s[1], b);
+    s[2] = _mm512_add_epi32(s[2], c);
+    s[3] = _mm512_add_epi32(s[3], d);
+    s[4] = _mm512_add_epi32(s[4], e);
+    s[5] = _mm512_add_epi32(s[5], f);
+    s[6] = _mm512_add_epi32(s[6], g);
+    s[7] = _mm512_add_epi32(s[7], h);
+
+    for (int i = 0; i < 8; i++)
+    {
+        _mm512_i32scatter_epi32((void *)(out + 4 * i), out_index, _mm512_shuffle_epi8(s[i], byte_swap), 1);
+    }
+}
+
+static uint64_t read_xcr0(void)
+{
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static bool os_saves_ymm(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 27)))
+    {
+        return false;
+    }
+    return (read_xcr0() & 0x06) == 0x06;
+}
+
+static bool os_saves_zmm(void)
+{
+    return os_saves_ymm() && (read_xcr0() & 0xE0) == 0xE0;
+}
+
+static bool avx2_supported(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, NULL) < 7)
+    {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0 && os_saves_ymm();
+}
+
+static bool avx512_supported(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, NULL) < 7)
+    {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    bool has_avx512f = (ebx & (1u << 16)) != 0;
+    bool has_avx512bw = (ebx & (1u << 30)) != 0;
+    return has_avx512f && has_avx512bw && avx2_supported() && os_saves_zmm();
+}
+#endif
+
+#ifdef SSZ_HASH_HAVE_ARMV8
+/**
+ * Compresses message blocks with the ARMv8 SHA2 instructions.
+ */
+SSZ_HASH_ARMV8_TARGET
+static void sha256_compress_armv8(uint32_t state[8], const uint8_t *blocks, size_t block_count)
+{
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    while (block_count--)
+    {
+        uint32x4_t abcd_save = state0;
+        uint32x4_t efgh_save = state1;
+        uint32x4_t msg[4];
+        for (int g = 0; g < 16; g++)
+        {
+            if (g < 4)
+            {
+                msg[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * g)));
+            }
+            else
+            {
+                msg[g & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[g & 3], msg[(g + 1) & 3]),
+                                             msg[(g + 2) & 3], msg[(g + 3) & 3]);
+            }
+            uint32x4_t wk = vaddq_u32(msg[g & 3], vld1q_u32(&sha256_k[4 * g]));
+            uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+        }
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+        blocks += 64;
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+
+SSZ_HASH_ARMV8_TARGET
+static void sha256_armv8(const uint8_t *data, size_t len, uint8_t *out_digest)
+{
+    sha256_with_compress(sha256_compress_armv8, data, len, out_digest);
+}
+
+/**
+ * Hashes the 64-byte concatenation of two nodes with the ARMv8 SHA2 instructions,
+ * running the padding block on sha256_pad64_wk. out may alias left or right.
+ */
+SSZ_HASH_ARMV8_TARGET
+static void sha256_pair_armv8(const uint8_t *left, const uint8_t *right, uint8_t *out)
+{
+    uint32x4_t state0 = vld1q_u32(&sha256_iv[0]);
+    uint32x4_t state1 = vld1q_u32(&sha256_iv[4]);
+    uint32x4_t abcd_save = state0;
+    uint32x4_t efgh_save = state1;
+    uint32x4_t msg[4];
+    msg[0] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(left)));
+    msg[1] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(left + 16)));
+    msg[2] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(right)));
+    msg[3] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(right + 16)));
+    for (int g = 0; g < 16; g++)
+    {
+        if (g >= 4)
+        {
+            msg[g & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[g & 3], msg[(g + 1) & 3]),
+                                         msg[(g + 2) & 3], msg[(g + 3) & 3]);
+        }
+        uint32x4_t wk = vaddq_u32(msg[g & 3], vld1q_u32(&sha256_k[4 * g]));
+        uint32x4_t abcd = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, abcd, wk);
+    }
+    state0 = vaddq_u32(state0, abcd_save);
+    state1 = vaddq_u32(state1, efgh_save);
+
+    abcd_save = state0;
+    efgh_save = state1;
+    for (int g = 0; g < 16; g++)
+    {
+        uint32x4_t wk = vld1q_u32(&sha256_pad64_wk[4 * g]);
+        uint32x4_t abcd = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, abcd, wk);
+    }
+    state0 = vaddq_u32(state0, abcd_save);
+    state1 = vaddq_u32(state1, efgh_save);
+    vst1q_u8(out, vrev32q_u8(vreinterpretq_u8_u32(state0)));
+    vst1q_u8(out + 16, vrev32q_u8(vreinterpretq_u8_u32(state1)));
+}
+
+static bool armv8_supported(void)
+{
+#if defined(__linux__) && defined(HWCAP_SHA2)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#elif defined(__APPLE__)
+    return true;
+#else
+    return false;
+#endif
+}
+#endif
+
+static sha256_hash_fn active_hash = NULL;
+static sha256_64B_xN_fn active_hash_64B_xN = NULL;
+static sha256_pair_fn active_hash_pair = NULL;
+static ssz_hash_backend_t active_backend = SSZ_HASH_BACKEND_COUNT;
+static pthread_once_t default_backend_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Hashes 64-byte messages one at a time with the active pair function.
+ */
+static void sha256_64B_xN_loop(const uint8_t *in, size_t count, uint8_t *out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        active_hash_pair(in + 64 * i, in + 64 * i + 32, out + 32 * i);
+    }
+}
+
+#ifdef SSZ_HASH_HAVE_X86
+static void sha256_64B_xN_avx2(const uint8_t *in, size_t count, uint8_t *out)
+{
+    while (count >= SSZ_HASH_AVX2_LANES)
+    {
+        sha256_64B_x8_avx2(in, out);
+        in += 64 * SSZ_HASH_AVX2_LANES;
+        out += 32 * SSZ_HASH_AVX2_LANES;
+        count -= SSZ_HASH_AVX2_LANES;
+    }
+    sha256_64B_xN_loop(in, count, out);
+}
+
+static void sha256_64B_xN_avx512(const uint8_t *in, size_t count, uint8_t *out)
+{
+    while (count >= SSZ_HASH_AVX512_LANES)
+    {
+        sha256_64B_x16_avx512(in, out);
+        in += 64 * SSZ_HASH_AVX512_LANES;
+        out += 32 * SSZ_HASH_AVX512_LANES;
+        count -= SSZ_HASH_AVX512_LANES;
+    }
+    if (active_hash_pair == sha256_pair_sha_ni)
+    {
+        sha256_64B_xN_loop(in, count, out);
+    }
+    else
+    {
+        sha256_64B_xN_avx2(in, count, out);
+    }
+}
+#endif
+
+/**
+ * Returns the single-message hash function used by a backend, or NULL if it is not compiled in.
+ * The multi-buffer backends hash single messages with SHA-NI when the CPU has it.
+ */
+static sha256_hash_fn backend_hash_fn(ssz_hash_backend_t backend)
+{
+    switch (backend)
+    {
+    case SSZ_HASH_BACKEND_GENERIC:
+        return sha256_generic;
+#ifdef SSZ_HASH_HAVE_X86
+    case SSZ_HASH_BACKEND_SHA_NI:
+        return sha256_sha_ni;
+    case SSZ_HASH_BACKEND_AVX2:
+    case SSZ_HASH_BACKEND_AVX512:
+        return sha_ni_supported() ? sha256_sha_ni : sha256_generic;
+#endif
+#ifdef SSZ_HASH_HAVE_ARMV8
+    case SSZ_HASH_BACKEND_ARMV8:
+        return sha256_armv8;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * Returns the node pair hash function used by a backend.
+ * The multi-buffer backends hash single pairs with SHA-NI when the CPU has it.
+ */
+static sha256_pair_fn backend_hash_pair_fn(ssz_hash_backend_t backend)
+{
+    switch (backend)
+    {
+#ifdef SSZ_HASH_HAVE_X86
+    case SSZ_HASH_BACKEND_SHA_NI:
+        return sha256_pair_sha_ni;
+    case SSZ_HASH_BACKEND_AVX2:
+    case SSZ_HASH_BACKEND_AVX512:
+        return sha_ni_supported() ? sha256_pair_sha_ni : sha256_pair_portable;
+#endif
+#ifdef SSZ_HASH_HAVE_ARMV8
+    case SSZ_HASH_BACKEND_ARMV8:
+        return sha256_pair_armv8;
+#endif
+    default:
+        return sha256_pair_portable;
+    }
+}
+
+/**
+ * Returns the 64-byte batch hash function used by a backend.
+ */
+static sha256_64B_xN_fn backend_hash_64B_xN_fn(ssz_hash_backend_t backend)
+{
+    switch (backend)
+    {
+#ifdef SSZ_HASH_HAVE_X86
+    case SSZ_HASH_BACKEND_AVX2:
+        return sha256_64B_xN_avx2;
+    case SSZ_HASH_BACKEND_AVX512:
+        return sha256_64B_xN_avx512;
+#endif
+    default:
+        return sha256_64B_xN_loop;
+    }
+}
+
+/**
+ * Points the active hash functions at a backend that is known to be available.
+ */
+static void apply_backend(ssz_hash_backend_t backend)
+{
+    active_hash = backend_hash_fn(backend);
+    active_hash_64B_xN = backend_hash_64B_xN_fn(backend);
+    active_hash_pair = backend_hash_pair_fn(backend);
+    active_backend = backend;
+}
+
+/**
+ * Selects the fastest available backend. Runs exactly once through default_backend_once;
+ * every public entry point goes through pthread_once before reading the active functions,
+ * which orders their reads after these writes on all threads.
+ *
+ * Sixteen AVX-512 lanes outrun SHA-NI node hashing, but eight AVX2 lanes do not, so
+ * AVX2 is only preferred over the portable code.
+ */
+static void select_default_backend(void)
+{
+    static const ssz_hash_backend_t preference[] = {
+        SSZ_HASH_BACKEND_AVX512,
+        SSZ_HASH_BACKEND_SHA_NI,
+        SSZ_HASH_BACKEND_ARMV8,
+        SSZ_HASH_BACKEND_AVX2,
+        SSZ_HASH_BACKEND_GENERIC};
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++)
+    {
+        if (ssz_hash_backend_available(preference[i]))
+        {
+            apply_backend(preference[i]);
+            return;
+        }
+    }
+}
+
+/**
+ * Computes the SHA-256 digest of a byte array using the active backend.
+ *
+ * @param data Pointer to the input bytes.
+ * @param len Number of input bytes.
+ * @param out_digest Output buffer to write the digest (32 bytes).
+ */
+void ssz_sha256(const uint8_t *data, size_t len, uint8_t *out_digest)
+{
+    pthread_once(&default_backend_once, select_default_backend);
+    active_hash(data, len, out_digest);
+}
+
+/**
+ * Computes the SHA-256 digests of consecutive 64-byte messages using the active backend.
+ *
+ * @param in Pointer to count consecutive 64-byte messages.
+ * @param count Number of messages.
+ * @param out Output buffer to write count consecutive 32-byte digests; may alias in.
+ */
+void ssz_sha256_64B_xN(const uint8_t *in, size_t count, uint8_t *out)
+{
+    pthread_once(&default_backend_once, select_default_backend);
+    active_hash_64B_xN(in, count, out);
+}
+
+/**
+ * Computes the SHA-256 digest of the 64-byte concatenation of two 32-byte nodes.
+ *
+ * @param left Pointer to the left node (32 bytes).
+ * @param right Pointer to the right node (32 bytes).
+ * @param out Output buffer to write the digest (32 bytes); may alias left or right.
+ */
+void ssz_hash_pair(const uint8_t *left, const uint8_t *right, uint8_t *out)
+{
+    pthread_once(&default_backend_once, select_default_backend);
+    active_hash_pair(left, right, out);
+}
+
+/**
+ * Checks whether a backend is compiled in and supported by the running CPU.
+ *
+ * @param backend The backend to check.
+ * @return true if the backend can be selected, otherwise false.
+ */
+bool ssz_hash_backend_available(ssz_hash_backend_t backend)
+{
+    switch (backend)
+    {
+    case SSZ_HASH_BACKEND_GENERIC:
+        return true;
+#ifdef SSZ_HASH_HAVE_X86
+    case SSZ_HASH_BACKEND_SHA_NI:
+        return sha_ni_supported();
+    case SSZ_HASH_BACKEND_AVX2:
+        return avx2_supported();
+    case SSZ_HASH_BACKEND_AVX512:
+        return avx512_supported();
+#endif
+#ifdef SSZ_HASH_HAVE_ARMV8
+    case SSZ_HASH_BACKEND_ARMV8:
+        return armv8_supported();
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * Returns the backend currently used by ssz_sha256.
+ *
+ * @return The active backend.
+ */
+ssz_hash_backend_t ssz_hash_get_backend(void)
+{
+    pthread_once(&default_backend_once, select_default_backend);
+    return active_backend;
+}
+
+/**
+ * Overrides the backend selected at startup.
+ *
+ * The default selection is completed first so that it cannot later replace the override.
+ * The override itself is not synchronized and must not race with hashing on other threads.
+ *
+ * @param backend The backend to use.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if the backend is not available.
+ */
+ssz_error_t ssz_hash_set_backend(ssz_hash_backend_t backend)
+{
+    if (!ssz_hash_backend_available(backend))
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    pthread_once(&default_backend_once, select_default_backend);
+    apply_backend(backend);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Returns a human-readable name for a backend.
+ *
+ * @param backend The backend.
+ * @return A static string naming the backend.
+ */
+const char *ssz_hash_backend_name(ssz_hash_backend_t backend)
+{
+    switch (backend)
+    {
+    case SSZ_HASH_BACKEND_GENERIC:
+        return "generic";
+    case SSZ_HASH_BACKEND_SHA_NI:
+        return "sha-ni";
+    case SSZ_HASH_BACKEND_ARMV8:
+        return "armv8";
+    case SSZ_HASH_BACKEND_AVX2:
+        return "avx2";
+    case SSZ_HASH_BACKEND_AVX512:
+        return "avx512";
+    default:
+        return "unknown";
+    }
+}
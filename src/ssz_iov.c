@@ -0,0 +1,279 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ssz_iov.h"
+#include "ssz_inline.h"
+#ifndef _WIN32
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#endif
+
+/** Scratch region size of a list when none is given. */
+#define SSZ_IOV_DEFAULT_SCRATCH_SIZE 4096
+
+/** Number of entries allocated for a list on the first append. */
+#define SSZ_IOV_INITIAL_ENTRIES 16
+
+#ifndef _WIN32
+/** Entries passed to one writev call; IOV_MAX is only visible with X/Open extensions enabled. */
+#ifdef IOV_MAX
+#define SSZ_IOV_WRITEV_BATCH IOV_MAX
+#else
+#define SSZ_IOV_WRITEV_BATCH 1024
+#endif
+#endif
+
+/**
+ * Appends a span to the list, extending the last entry if the span starts where it ends.
+ *
+ * @param iov Pointer to the list.
+ * @param data Start of the span.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+static ssz_error_t ssz_iov_push(ssz_iov_t *iov, const uint8_t *data, size_t size)
+{
+    if (size == 0)
+    {
+        return SSZ_SUCCESS;
+    }
+    iov->size += size;
+    if (iov->count > 0)
+    {
+        ssz_iovec_t *last = &iov->entries[iov->count - 1];
+        if ((const uint8_t *)last->iov_base + last->iov_len == data)
+        {
+            last->iov_len += size;
+            return SSZ_SUCCESS;
+        }
+    }
+    if (iov->count == iov->capacity)
+    {
+        size_t capacity = iov->capacity != 0 ? iov->capacity * 2 : SSZ_IOV_INITIAL_ENTRIES;
+        ssz_iovec_t *entries = ssz_arena_grow(iov->arena, iov->entries,
+                                              iov->capacity * sizeof(ssz_iovec_t),
+                                              capacity * sizeof(ssz_iovec_t));
+        if (entries == NULL)
+        {
+            iov->size -= size;
+            return SSZ_ERROR_SERIALIZATION;
+        }
+        iov->entries = entries;
+        iov->capacity = capacity;
+    }
+    iov->entries[iov->count].iov_base = (void *)data;
+    iov->entries[iov->count].iov_len = size;
+    iov->count++;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Initializes an empty scatter-gather list.
+ *
+ * @param iov Pointer to the list to initialize.
+ * @param arena Arena providing the entries and scratch memory.
+ * @param scratch_size Minimum size of each scratch region; 0 selects a default.
+ */
+void ssz_iov_init(ssz_iov_t *iov, ssz_arena_t *arena, size_t scratch_size)
+{
+    memset(iov, 0, sizeof(*iov));
+    iov->arena = arena;
+    iov->scratch_size = scratch_size != 0 ? scratch_size : SSZ_IOV_DEFAULT_SCRATCH_SIZE;
+}
+
+/**
+ * Appends bytes by reference.
+ *
+ * @param iov Pointer to the list.
+ * @param data Bytes to reference; must outlive the list.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_append_ref(ssz_iov_t *iov, const void *data, size_t size)
+{
+    if (data == NULL && size != 0)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    return ssz_iov_push(iov, (const uint8_t *)data, size);
+}
+
+/**
+ * Appends an array of unsigned integers in little-endian order.
+ *
+ * @param iov Pointer to the list.
+ * @param values Pointer to count values of value_size bytes each.
+ * @param count Number of values.
+ * @param value_size Size of one value in bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_append_le(ssz_iov_t *iov, const void *values, size_t count, size_t value_size)
+{
+    if (value_size != 0 && count > SIZE_MAX / value_size)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t size = count * value_size;
+    if (SSZ_HOST_LITTLE_ENDIAN || value_size == 1)
+    {
+        return ssz_iov_append_ref(iov, values, size);
+    }
+    uint8_t *out = ssz_iov_reserve(iov, size);
+    if (out == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    const uint8_t *src = (const uint8_t *)values;
+    for (size_t i = 0; i < count; i++)
+    {
+        ssz_copy_le_bytes(out + i * value_size, src + i * value_size, value_size);
+    }
+    return ssz_iov_advance(iov, size);
+}
+
+/**
+ * Returns size bytes of scratch memory to serialize into.
+ *
+ * When the current region is too small a new one is allocated from the arena; the bytes already
+ * appended from the old region stay where they are.
+ *
+ * @param iov Pointer to the list.
+ * @param size Number of bytes needed.
+ * @return Pointer to the scratch bytes, or NULL on allocation failure.
+ */
+uint8_t *ssz_iov_reserve(ssz_iov_t *iov, size_t size)
+{
+    if (iov->scratch != NULL && iov->scratch_capacity - iov->scratch_used >= size)
+    {
+        return iov->scratch + iov->scratch_used;
+    }
+    size_t capacity = size > iov->scratch_size ? size : iov->scratch_size;
+    uint8_t *scratch = ssz_arena_alloc(iov->arena, capacity);
+    if (scratch == NULL)
+    {
+        return NULL;
+    }
+    iov->scratch = scratch;
+    iov->scratch_used = 0;
+    iov->scratch_capacity = capacity;
+    return scratch;
+}
+
+/**
+ * Appends scratch bytes filled in after ssz_iov_reserve to the list.
+ *
+ * @param iov Pointer to the list.
+ * @param size Number of bytes written, at most the size reserved.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_advance(ssz_iov_t *iov, size_t size)
+{
+    ssz_error_t err = ssz_iov_push(iov, iov->scratch + iov->scratch_used, size);
+    if (err == SSZ_SUCCESS)
+    {
+        iov->scratch_used += size;
+    }
+    return err;
+}
+
+/**
+ * Appends a little-endian uint32, e.g. an SSZ offset, through scratch memory.
+ *
+ * @param iov Pointer to the list.
+ * @param value The value.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_iov_put_uint32(ssz_iov_t *iov, uint32_t value)
+{
+    uint8_t *out = ssz_iov_reserve(iov, SSZ_BYTE_SIZE_OF_UINT32);
+    if (out == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    ssz_store_le32(out, value);
+    return ssz_iov_advance(iov, SSZ_BYTE_SIZE_OF_UINT32);
+}
+
+/**
+ * Copies the bytes of a list into a contiguous buffer.
+ *
+ * @param iov Pointer to the list.
+ * @param out_buf Output buffer of at least iov->size bytes.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes copied.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the buffer is too small.
+ */
+ssz_error_t ssz_iov_copy(const ssz_iov_t *iov, uint8_t *out_buf, size_t *out_size)
+{
+    if (out_buf == NULL || out_size == NULL || *out_size < iov->size)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < iov->count; i++)
+    {
+        memcpy(out_buf + offset, iov->entries[i].iov_base, iov->entries[i].iov_len);
+        offset += iov->entries[i].iov_len;
+    }
+    *out_size = offset;
+    return SSZ_SUCCESS;
+}
+
+#ifndef _WIN32
+/**
+ * Writes a list to a file descriptor with writev.
+ *
+ * After a partial write the partly written entry is advanced in place and restored once it has
+ * been written completely, so the entries are unchanged on return.
+ *
+ * @param iov Pointer to the list.
+ * @param fd File descriptor of a file, pipe or socket.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if a write fails.
+ */
+ssz_error_t ssz_iov_writev(ssz_iov_t *iov, int fd)
+{
+    ssz_error_t result = SSZ_SUCCESS;
+    size_t i = 0;
+    size_t patched = SIZE_MAX;
+    ssz_iovec_t original;
+    while (i < iov->count)
+    {
+        size_t batch = iov->count - i < (size_t)SSZ_IOV_WRITEV_BATCH ? iov->count - i : (size_t)SSZ_IOV_WRITEV_BATCH;
+        ssize_t written = writev(fd, &iov->entries[i], (int)batch);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            result = SSZ_ERROR_SERIALIZATION;
+            break;
+        }
+        size_t done = (size_t)written;
+        while (i < iov->count && done >= iov->entries[i].iov_len)
+        {
+            done -= iov->entries[i].iov_len;
+            if (patched == i)
+            {
+                iov->entries[i] = original;
+                patched = SIZE_MAX;
+            }
+            i++;
+        }
+        if (done > 0)
+        {
+            if (patched == SIZE_MAX)
+            {
+                original = iov->entries[i];
+                patched = i;
+            }
+            iov->entries[i].iov_base = (uint8_t *)iov->entries[i].iov_base + done;
+            iov->entries[i].iov_len -= done;
+        }
+    }
+    if (patched != SIZE_MAX)
+    {
+        iov->entries[patched] = original;
+    }
+    return result;
+}
+#endif
@@ -1,16 +1,125 @@
 #include <stdlib.h>
 #include <string.h>
-#include "mincrypt/sha256.h"
+#include <pthread.h>
 #include "ssz_merkle.h"
+#include "ssz_hash.h"
 #include "ssz_utils.h"
+#include "ssz_bits.h"
 #include "ssz_constants.h"
+#include "ssz_inline.h"
+
+/*
+ * Sibling pairs hashed per ssz_sha256_64B_xN call when streaming; a multiple of every SIMD lane
+ * width. Pushed chunks are reduced in aligned power-of-two blocks of up to twice as many chunks,
+ * level by level in batches, and only each block root is carried.
+ */
+#define SSZ_MERKLEIZER_BATCH_PAIRS 512
+
+/* Upper bound on ssz_merkleize_parallel workers; also sizes its on-stack subtree roots. */
+#define SSZ_MERKLEIZE_MAX_THREADS 64
+
+/* Smallest subtree worth a thread; below this the thread start-up cost dominates. */
+#define SSZ_MERKLEIZE_MIN_CHUNKS_PER_THREAD 1024
+
+/**
+ * Describes one node of a tree to be copied out while the tree is hashed, so proofs cost no
+ * hashing beyond the root computation itself.
+ */
+typedef struct
+{
+    unsigned int level; /**< Level of the node (0 for leaf chunks). */
+    uint64_t index;     /**< Index of the node within its level. */
+    uint8_t *out;       /**< Receives the node (SSZ_BYTES_PER_CHUNK bytes). */
+} ssz_merkle_capture_t;
+
+/**
+ * Copies out the captured nodes that lie on one level of the tree.
+ *
+ * Nodes at or beyond count are roots of all-zero subtrees and are taken from zero_hash_table.
+ *
+ * @param capture First pending capture; captures are sorted by ascending level.
+ * @param end One past the last capture.
+ * @param row Pointer to the populated nodes of the level.
+ * @param count Number of populated nodes in the row.
+ * @param level Level of the nodes in the row.
+ * @return The first capture above this level.
+ */
+static const ssz_merkle_capture_t *ssz_merkle_capture_level(const ssz_merkle_capture_t *capture, const ssz_merkle_capture_t *end,
+                                                            const uint8_t *row, size_t count, unsigned int level)
+{
+    for (; capture != end && capture->level == level; capture++)
+    {
+        memcpy(capture->out, capture->index < count ? row + capture->index * SSZ_BYTES_PER_CHUNK : zero_hash_table[level],
+               SSZ_BYTES_PER_CHUNK);
+    }
+    return capture;
+}
+
+/**
+ * Hashes a row of nodes at a given tree level up to the root at the given depth.
+ *
+ * Whenever a level has an odd number of nodes, the missing right sibling is taken from the
+ * precomputed zero_hash_table for that level.
+ *
+ * @param row Pointer to the nodes at the starting level (each SSZ_BYTES_PER_CHUNK bytes).
+ * @param count Number of nodes in the row; must be non-zero and at most 2^(depth - level).
+ * @param level Level of the nodes in the row (0 for leaf chunks).
+ * @param depth Level of the root.
+ * @param captures Nodes to copy out on the way up, sorted by ascending level from the starting level; may be NULL.
+ * @param capture_count Number of captures.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+static ssz_error_t ssz_merkleize_levels(const uint8_t *row, size_t count, unsigned int level, unsigned int depth,
+                                        const ssz_merkle_capture_t *captures, size_t capture_count, uint8_t *out_root)
+{
+    const ssz_merkle_capture_t *capture = captures;
+    const ssz_merkle_capture_t *captures_end = captures + capture_count;
+    if (level == depth) 
+    {
+        ssz_merkle_capture_level(capture, captures_end, row, count, level);
+        memcpy(out_root, row, SSZ_BYTES_PER_CHUNK);
+        return SSZ_SUCCESS;
+    }
+    size_t nodes_size = ((count + 1) >> 1) * SSZ_BYTES_PER_CHUNK;
+    uint8_t small_buf[SSZ_SMALL_BUFFER_SIZE];
+    uint8_t *restrict nodes = nodes_size <= SSZ_SMALL_BUFFER_SIZE ? small_buf : malloc(nodes_size);
+    if (!nodes) 
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    const uint8_t *src = row;
+    size_t num = count;
+    for (; level < depth; level++) 
+    {
+        capture = ssz_merkle_capture_level(capture, captures_end, src, num, level);
+        size_t parent = num >> 1;
+        ssz_sha256_64B_xN(src, parent, nodes);
+        if (num & 1) 
+        {
+            ssz_hash_pair(src + (num - 1) * SSZ_BYTES_PER_CHUNK, zero_hash_table[level], nodes + parent * SSZ_BYTES_PER_CHUNK);
+            parent++;
+        }
+        src = nodes;
+        num = parent;
+    }
+    ssz_merkle_capture_level(capture, captures_end, nodes, 1, depth);
+    memcpy(out_root, nodes, SSZ_BYTES_PER_CHUNK);
+    if (nodes != small_buf) 
+    {
+        free(nodes);
+    }
+    return SSZ_SUCCESS;
+}
 
 /**
  * Computes the Merkle root from an array of chunks.
  *
- * This function constructs a Merkle tree by first copying the provided chunks
- * into leaf nodes, padding with zeros if necessary, and then iteratively hashing
- * pairs of nodes until a single root is obtained.
+ * This function hashes only the populated part of the tree. Whenever a level has an odd
+ * number of nodes, the missing right sibling is taken from the precomputed zero_hash_table,
+ * so padding up to the limit costs one hash per level instead of hashing every zero leaf.
+ * Time and memory are O(chunk_count + depth) regardless of the limit. The sibling pairs
+ * of each level are hashed as one batch so multi-buffer SHA-256 backends can fill their lanes.
  *
  * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes).
  * @param chunk_count Number of chunks provided.
@@ -29,48 +138,268 @@ ssz_error_t ssz_merkleize(const uint8_t *restrict chunks, size_t chunk_count, si
         }
         effective = limit;
     }
-    if (effective == 0) 
+    unsigned int depth = ceil_log2(effective);
+    if (chunk_count == 0) 
     {
-        memset(out_root, 0, SSZ_BYTES_PER_CHUNK);
+        memcpy(out_root, zero_hash_table[depth], SSZ_BYTES_PER_CHUNK);
         return SSZ_SUCCESS;
     }
-    size_t padded = next_pow_of_two(effective);
-    if (padded == 1) 
+    return ssz_merkleize_levels(chunks, chunk_count, 0, depth, NULL, 0, out_root);
+}
+
+/**
+ * Describes one subtree hashed by a worker of ssz_merkleize_parallel.
+ */
+typedef struct
+{
+    const uint8_t *chunks;
+    size_t chunk_count;
+    size_t span;
+    uint8_t *out_root;
+    ssz_error_t err;
+} ssz_merkleize_job_t;
+
+static void *ssz_merkleize_worker(void *arg)
+{
+    ssz_merkleize_job_t *job = (ssz_merkleize_job_t *)arg;
+    job->err = ssz_merkleize(job->chunks, job->chunk_count, job->span, job->out_root);
+    return NULL;
+}
+
+/**
+ * Computes the Merkle root from an array of chunks using several threads.
+ *
+ * The leaves are split into equal power-of-two spans, one subtree per worker. Each subtree
+ * root is computed with ssz_merkleize on its own thread (the calling thread takes the first),
+ * and the few remaining top levels are hashed once all workers have joined. The result is
+ * identical to ssz_merkleize. If a thread cannot be started its subtree is hashed on the
+ * calling thread instead.
+ *
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes).
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @param thread_count Maximum number of threads to use, including the calling thread.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkleize_parallel(const uint8_t *chunks, size_t chunk_count, size_t limit, unsigned int thread_count, uint8_t *out_root)
+{
+    if (limit != 0 && chunk_count > limit) 
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    if (thread_count > SSZ_MERKLEIZE_MAX_THREADS) 
+    {
+        thread_count = SSZ_MERKLEIZE_MAX_THREADS;
+    }
+    if (thread_count <= 1 || chunk_count < 2 * SSZ_MERKLEIZE_MIN_CHUNKS_PER_THREAD) 
+    {
+        return ssz_merkleize(chunks, chunk_count, limit, out_root);
+    }
+    unsigned int depth = ceil_log2(limit != 0 ? limit : chunk_count);
+    unsigned int sub_depth = ceil_log2((chunk_count + thread_count - 1) / thread_count);
+    if (sub_depth < ceil_log2(SSZ_MERKLEIZE_MIN_CHUNKS_PER_THREAD)) 
+    {
+        sub_depth = ceil_log2(SSZ_MERKLEIZE_MIN_CHUNKS_PER_THREAD);
+    }
+    size_t span = (size_t)1 << sub_depth;
+    size_t job_count = (chunk_count + span - 1) >> sub_depth;
+    /* Resolve the hash backend before the workers race to do it. */
+    ssz_hash_get_backend();
+
+    uint8_t roots[SSZ_MERKLEIZE_MAX_THREADS * SSZ_BYTES_PER_CHUNK];
+    ssz_merkleize_job_t jobs[SSZ_MERKLEIZE_MAX_THREADS];
+    pthread_t threads[SSZ_MERKLEIZE_MAX_THREADS];
+    bool started[SSZ_MERKLEIZE_MAX_THREADS];
+    for (size_t j = 0; j < job_count; j++) 
+    {
+        size_t first = j * span;
+        jobs[j].chunks = chunks + first * SSZ_BYTES_PER_CHUNK;
+        jobs[j].chunk_count = chunk_count - first < span ? chunk_count - first : span;
+        jobs[j].span = span;
+        jobs[j].out_root = roots + j * SSZ_BYTES_PER_CHUNK;
+        jobs[j].err = SSZ_SUCCESS;
+        started[j] = j != 0 && pthread_create(&threads[j], NULL, ssz_merkleize_worker, &jobs[j]) == 0;
+    }
+    ssz_error_t err = SSZ_SUCCESS;
+    for (size_t j = 0; j < job_count; j++) 
     {
-        if (chunk_count >= 1) 
+        if (started[j]) 
         {
-            memcpy(out_root, chunks, SSZ_BYTES_PER_CHUNK);
-        } else 
+            pthread_join(threads[j], NULL);
+        }
+        else 
         {
-            memset(out_root, 0, SSZ_BYTES_PER_CHUNK);
+            ssz_merkleize_worker(&jobs[j]);
+        }
+        if (jobs[j].err != SSZ_SUCCESS) 
+        {
+            err = jobs[j].err;
         }
-        return SSZ_SUCCESS;
     }
-    uint8_t *restrict nodes = malloc(padded * SSZ_BYTES_PER_CHUNK);
-    if (!nodes) 
+    if (err != SSZ_SUCCESS) 
+    {
+        return err;
+    }
+    return ssz_merkleize_levels(roots, job_count, sub_depth, depth, NULL, 0, out_root);
+}
+
+/**
+ * Hashes a node into the pending slots of an incremental Merkleization context.
+ *
+ * The node is the root of the subtree at the given level whose index is m->count >> level.
+ * While that index is odd, the node is the right sibling of the pending node and the pair is
+ * hashed one level up; the first even index leaves the node pending at that level.
+ *
+ * @param m Pointer to the context.
+ * @param node The node to carry (SSZ_BYTES_PER_CHUNK bytes).
+ * @param level The level of the node (0 for leaf chunks).
+ */
+static void ssz_merkleizer_carry(ssz_merkleizer_t *m, const uint8_t *node, unsigned int level)
+{
+    uint8_t carried[SSZ_BYTES_PER_CHUNK];
+    uint64_t index = m->count >> level;
+    memcpy(carried, node, SSZ_BYTES_PER_CHUNK);
+    while (index & 1)
+    {
+        ssz_hash_pair(m->pending[level], carried, carried);
+        index >>= 1;
+        level++;
+    }
+    memcpy(m->pending[level], carried, SSZ_BYTES_PER_CHUNK);
+}
+
+/**
+ * Initializes an incremental Merkleization context.
+ *
+ * @param m Pointer to the context to initialize.
+ * @param limit Maximum number of chunks that may be pushed, or 0 for no limit.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkleizer_init(ssz_merkleizer_t *m, uint64_t limit)
+{
+    if (!m)
     {
         return SSZ_ERROR_MERKLEIZATION;
     }
-    if (chunk_count) 
+    m->count = 0;
+    m->limit = limit;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Pushes a single chunk into an incremental Merkleization context.
+ *
+ * @param m Pointer to the context.
+ * @param chunk Pointer to the chunk (SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code if the limit would be exceeded.
+ */
+ssz_error_t ssz_merkleizer_push_chunk(ssz_merkleizer_t *m, const uint8_t *chunk)
+{
+    if (m->limit != 0 && m->count >= m->limit)
     {
-        memcpy(nodes, chunks, chunk_count * SSZ_BYTES_PER_CHUNK);
+        return SSZ_ERROR_SERIALIZATION;
     }
-    if (chunk_count < padded) 
+    ssz_merkleizer_carry(m, chunk, 0);
+    m->count++;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Pushes a contiguous array of chunks into an incremental Merkleization context.
+ *
+ * When the context is at an even position, sibling pairs are hashed straight from the
+ * caller's buffer and carried in at level 1, skipping the level-0 pending slot.
+ *
+ * @param m Pointer to the context.
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes).
+ * @param chunk_count Number of chunks provided.
+ * @return SSZ_SUCCESS on success, or an error code if the limit would be exceeded.
+ */
+ssz_error_t ssz_merkleizer_push_chunks(ssz_merkleizer_t *m, const uint8_t *chunks, size_t chunk_count)
+{
+    if (m->limit != 0 && chunk_count > m->limit - m->count)
     {
-        memset(nodes + chunk_count * SSZ_BYTES_PER_CHUNK, 0, (padded - chunk_count) * SSZ_BYTES_PER_CHUNK);
+        return SSZ_ERROR_SERIALIZATION;
     }
-    size_t num = padded;
-    while (num > 1) 
+    if (chunk_count && (m->count & 1))
     {
-        size_t parent = num >> 1;
-        for (size_t i = 0; i < parent; i++) 
+        ssz_merkleizer_carry(m, chunks, 0);
+        m->count++;
+        chunks += SSZ_BYTES_PER_CHUNK;
+        chunk_count--;
+    }
+    uint8_t nodes[SSZ_MERKLEIZER_BATCH_PAIRS * SSZ_BYTES_PER_CHUNK];
+    while (chunk_count >= 2)
+    {
+        /* Largest power-of-two block that fits the batch, the remaining chunks and the alignment of m->count. */
+        size_t block = 2 * SSZ_MERKLEIZER_BATCH_PAIRS;
+        while (block > chunk_count || (m->count & (block - 1)) != 0)
         {
-            SHA256_hash(nodes + (2 * i) * SSZ_BYTES_PER_CHUNK, 2 * SSZ_BYTES_PER_CHUNK, nodes + i * SSZ_BYTES_PER_CHUNK);
+            block >>= 1;
         }
-        num = parent;
+        ssz_sha256_64B_xN(chunks, block >> 1, nodes);
+        unsigned int level = 1;
+        for (size_t width = block >> 1; width > 1; width >>= 1)
+        {
+            ssz_sha256_64B_xN(nodes, width >> 1, nodes);
+            level++;
+        }
+        ssz_merkleizer_carry(m, nodes, level);
+        m->count += block;
+        chunks += block * SSZ_BYTES_PER_CHUNK;
+        chunk_count -= block;
     }
-    memcpy(out_root, nodes, SSZ_BYTES_PER_CHUNK);
-    free(nodes);
+    if (chunk_count)
+    {
+        ssz_merkleizer_carry(m, chunks, 0);
+        m->count++;
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Computes the Merkle root of all chunks pushed into an incremental Merkleization context.
+ *
+ * Walking up from the leaves, each set bit of the chunk count marks a complete pending
+ * subtree that becomes the left sibling of the partial node built so far; each clear bit
+ * pairs the partial node with the zero-subtree hash of that level.
+ *
+ * @param m Pointer to the context.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkleizer_finalize(const ssz_merkleizer_t *m, uint8_t *out_root)
+{
+    unsigned int depth = ceil_log2(m->limit != 0 ? m->limit : m->count);
+    if (m->count == 0)
+    {
+        memcpy(out_root, zero_hash_table[depth], SSZ_BYTES_PER_CHUNK);
+        return SSZ_SUCCESS;
+    }
+    uint8_t node[SSZ_BYTES_PER_CHUNK];
+    bool have_node = false;
+    for (unsigned int level = 0; level < depth; level++)
+    {
+        const uint8_t *left, *right;
+        if ((m->count >> level) & 1)
+        {
+            left = m->pending[level];
+            right = have_node ? node : zero_hash_table[level];
+        }
+        else if (have_node)
+        {
+            left = node;
+            right = zero_hash_table[level];
+        }
+        else
+        {
+            continue;
+        }
+        ssz_hash_pair(left, right, node);
+        have_node = true;
+    }
+    memcpy(out_root, have_node ? node : m->pending[depth], SSZ_BYTES_PER_CHUNK);
     return SSZ_SUCCESS;
 }
 
@@ -141,22 +470,7 @@ ssz_error_t ssz_pack_bits(const bool *bits, size_t bit_count, uint8_t *out_chunk
     }
     else 
     {
-        memset(bitfield_bytes, 0, bitfield_len);
-        size_t full_bytes = bit_count >> 3, rem = bit_count & 7;
-        for (size_t i = 0; i < full_bytes; i++) 
-        {
-            size_t base = i << 3;
-            bitfield_bytes[i] = (uint8_t)bits[base] | (uint8_t)bits[base+1] << 1 |
-                (uint8_t)bits[base+2] << 2 | (uint8_t)bits[base+3] << 3 |
-                (uint8_t)bits[base+4] << 4 | (uint8_t)bits[base+5] << 5 |
-                (uint8_t)bits[base+6] << 6 | (uint8_t)bits[base+7] << 7;
-        }
-        if (rem) 
-        {
-            uint8_t byte = 0;
-            for (size_t j = 0, base = full_bytes << 3; j < rem; j++) byte |= (uint8_t)bits[base + j] << j;
-            bitfield_bytes[full_bytes] = byte;
-        }
+        ssz_bits_pack(bits, bit_count, bitfield_bytes);
     }
     ssz_error_t err = ssz_pack(bitfield_bytes, 1, bitfield_len, out_chunks, out_chunk_count);
     if (bitfield_bytes != small_buf)
@@ -170,7 +484,7 @@ ssz_error_t ssz_pack_bits(const bool *bits, size_t bit_count, uint8_t *out_chunk
  * Mixes a length value into a Merkle root to produce an updated root.
  *
  * This function takes an existing Merkle root and a length value, then mixes the length
- * into the root by placing it in a buffer alongside the original root and computing SHA256_hash.
+ * into the root by placing it in a buffer alongside the original root and computing SHA256.
  *
  * @param root Pointer to the original Merkle root (32 bytes).
  * @param length 64-bit unsigned integer representing the length to mix in.
@@ -178,18 +492,17 @@ ssz_error_t ssz_pack_bits(const bool *bits, size_t bit_count, uint8_t *out_chunk
  * @return SSZ_SUCCESS on success, or an error code on failure.
  */
 ssz_error_t ssz_mix_in_length(const uint8_t *root, uint64_t length, uint8_t *out_root) {
-    uint8_t buf[64];
-    memcpy(buf, root, 32);
-    buf[32] = (uint8_t)length;
-    buf[33] = (uint8_t)(length >> 8);
-    buf[34] = (uint8_t)(length >> 16);
-    buf[35] = (uint8_t)(length >> 24);
-    buf[36] = (uint8_t)(length >> 32);
-    buf[37] = (uint8_t)(length >> 40);
-    buf[38] = (uint8_t)(length >> 48);
-    buf[39] = (uint8_t)(length >> 56);
-    memset(buf + 40, 0, 24);
-    SHA256_hash(buf, 64, out_root);
+    uint8_t buf[32];
+    buf[0] = (uint8_t)length;
+    buf[1] = (uint8_t)(length >> 8);
+    buf[2] = (uint8_t)(length >> 16);
+    buf[3] = (uint8_t)(length >> 24);
+    buf[4] = (uint8_t)(length >> 32);
+    buf[5] = (uint8_t)(length >> 40);
+    buf[6] = (uint8_t)(length >> 48);
+    buf[7] = (uint8_t)(length >> 56);
+    memset(buf + 8, 0, 24);
+    ssz_hash_pair(root, buf, out_root);
     return SSZ_SUCCESS;
 }
 
@@ -197,7 +510,7 @@ ssz_error_t ssz_mix_in_length(const uint8_t *root, uint64_t length, uint8_t *out
  * Mixes a selector byte into a Merkle root to produce an updated root.
  *
  * This function takes an existing Merkle root and a selector byte, places the selector in a
- * buffer along with the root, and computes SHA256_hash to produce a new Merkle root.
+ * buffer along with the root, and computes the node hash to produce a new Merkle root.
  *
  * @param root Pointer to the original Merkle root (32 bytes).
  * @param selector The selector byte to mix into the root.
@@ -209,9 +522,822 @@ ssz_error_t ssz_mix_in_selector(
     uint8_t selector,
     uint8_t *out_root)
 {
-    uint8_t buf[64] = {0};
-    memcpy(buf, root, 32);
-    buf[32] = selector;
-    SHA256_hash(buf, 64, out_root);
+    uint8_t buf[32] = {0};
+    buf[0] = selector;
+    ssz_hash_pair(root, buf, out_root);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Pushes packed basic values into an incremental Merkleization context without packing them first.
+ *
+ * On little-endian hosts (and for single-byte values) the full chunks are pushed straight from
+ * the value buffer and only the last partial chunk is zero-padded on the stack. Otherwise each
+ * chunk is assembled on the stack with every value byte-reversed into its SSZ encoding. Value
+ * sizes divide the chunk size, so no value straddles two chunks.
+ *
+ * @param m Pointer to the context.
+ * @param values Pointer to the values.
+ * @param value_size Size of one value in bytes (1, 2, 4, 8, 16 or 32).
+ * @param count Number of values.
+ * @return SSZ_SUCCESS on success, or an error code if the limit would be exceeded.
+ */
+static ssz_error_t ssz_merkleizer_push_values(ssz_merkleizer_t *m, const uint8_t *values, size_t value_size, size_t count)
+{
+    size_t total_bytes = value_size * count;
+    if (SSZ_HOST_LITTLE_ENDIAN || value_size == 1)
+    {
+        size_t full_chunks = total_bytes / SSZ_BYTES_PER_CHUNK;
+        size_t tail = total_bytes % SSZ_BYTES_PER_CHUNK;
+        ssz_error_t err = ssz_merkleizer_push_chunks(m, values, full_chunks);
+        if (err != SSZ_SUCCESS || tail == 0)
+        {
+            return err;
+        }
+        uint8_t last[SSZ_BYTES_PER_CHUNK] = {0};
+        memcpy(last, values + full_chunks * SSZ_BYTES_PER_CHUNK, tail);
+        return ssz_merkleizer_push_chunk(m, last);
+    }
+    for (size_t offset = 0; offset < total_bytes; offset += SSZ_BYTES_PER_CHUNK)
+    {
+        uint8_t chunk[SSZ_BYTES_PER_CHUNK] = {0};
+        size_t n = total_bytes - offset < SSZ_BYTES_PER_CHUNK ? total_bytes - offset : SSZ_BYTES_PER_CHUNK;
+        for (size_t i = 0; i < n; i += value_size)
+        {
+            for (size_t b = 0; b < value_size; b++)
+            {
+                chunk[i + b] = values[offset + i + value_size - 1 - b];
+            }
+        }
+        ssz_error_t err = ssz_merkleizer_push_chunk(m, chunk);
+        if (err != SSZ_SUCCESS)
+        {
+            return err;
+        }
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Checks the arguments shared by the basic vector and list root functions.
+ *
+ * @return true if value_size is a supported basic size and value_size * count fits in a size_t.
+ */
+static bool ssz_basic_values_valid(const void *values, size_t value_size, size_t count, const uint8_t *out_root)
+{
+    return out_root && (count == 0 || values) && value_size != 0 && value_size <= SSZ_BYTES_PER_CHUNK &&
+           (value_size & (value_size - 1)) == 0 && count <= SIZE_MAX / value_size;
+}
+
+/**
+ * Computes the hash tree root of a vector of basic values.
+ *
+ * @param values Pointer to the values; may be NULL if count is 0.
+ * @param value_size Size of one value in bytes (1, 2, 4, 8, 16 or 32).
+ * @param count Number of values; must be non-zero.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_hash_tree_root_basic_vector(const void *values, size_t value_size, size_t count, uint8_t *out_root)
+{
+    if (count == 0 || !ssz_basic_values_valid(values, value_size, count, out_root))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    ssz_merkleizer_t m;
+    ssz_merkleizer_init(&m, (value_size * count + SSZ_BYTES_PER_CHUNK - 1) / SSZ_BYTES_PER_CHUNK);
+    ssz_error_t err = ssz_merkleizer_push_values(&m, (const uint8_t *)values, value_size, count);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    return ssz_merkleizer_finalize(&m, out_root);
+}
+
+/**
+ * Computes the hash tree root of a list of basic values.
+ *
+ * @param values Pointer to the values; may be NULL if count is 0.
+ * @param value_size Size of one value in bytes (1, 2, 4, 8, 16 or 32).
+ * @param count Number of values in the list.
+ * @param limit Maximum number of values in the list; if zero, the tree depth is derived from count.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_hash_tree_root_basic_list(const void *values, size_t value_size, size_t count, size_t limit, uint8_t *out_root)
+{
+    if (!ssz_basic_values_valid(values, value_size, count, out_root))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    if (limit != 0 && count > limit)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t values_per_chunk = SSZ_BYTES_PER_CHUNK / value_size;
+    uint64_t chunk_limit = limit / values_per_chunk + (limit % values_per_chunk != 0);
+    ssz_merkleizer_t m;
+    ssz_merkleizer_init(&m, chunk_limit);
+    ssz_error_t err = ssz_merkleizer_push_values(&m, (const uint8_t *)values, value_size, count);
+    if (err == SSZ_SUCCESS)
+    {
+        err = ssz_merkleizer_finalize(&m, out_root);
+    }
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    return ssz_mix_in_length(out_root, count, out_root);
+}
+
+/**
+ * Computes the hash tree root of a bitvector from its packed (serialized) bytes.
+ *
+ * The bytes are merkleized where they lie; only a partial last chunk is zero-padded on the stack.
+ *
+ * @param bytes Pointer to the packed bits, ceil(bit_count / 8) bytes, least significant bit first.
+ * @param bit_count Number of bits in the bitvector; must be non-zero.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if bits past bit_count are set,
+ *         or SSZ_ERROR_MERKLEIZATION on invalid arguments.
+ */
+ssz_error_t ssz_hash_tree_root_bitvector(const uint8_t *bytes, size_t bit_count, uint8_t *out_root)
+{
+    if (!bytes || !out_root || bit_count == 0)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    size_t byte_count = (bit_count + 7) / 8;
+    if (bit_count % 8 != 0 && (bytes[byte_count - 1] >> (bit_count % 8)) != 0)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    ssz_merkleizer_t m;
+    ssz_merkleizer_init(&m, (byte_count + SSZ_BYTES_PER_CHUNK - 1) / SSZ_BYTES_PER_CHUNK);
+    ssz_error_t err = ssz_merkleizer_push_values(&m, bytes, 1, byte_count);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    return ssz_merkleizer_finalize(&m, out_root);
+}
+
+/**
+ * Computes the hash tree root of a bitlist from its serialized bytes.
+ *
+ * The length is read from the delimiter bit, the highest set bit of the last byte. Every chunk but
+ * the last is merkleized where it lies; the last one is copied to the stack so the delimiter can be
+ * cleared without touching the caller's buffer.
+ *
+ * @param bytes Pointer to the serialized bitlist, including the delimiter bit.
+ * @param byte_count Number of serialized bytes; must be non-zero.
+ * @param max_bits Maximum number of bits in the bitlist.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @param out_bit_count Optional pointer to store the number of bits in the bitlist; may be NULL.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_DESERIALIZATION if the delimiter is missing or the
+ *         bitlist is longer than max_bits, or SSZ_ERROR_MERKLEIZATION on invalid arguments.
+ */
+ssz_error_t ssz_hash_tree_root_bitlist(const uint8_t *bytes, size_t byte_count, size_t max_bits, uint8_t *out_root, size_t *out_bit_count)
+{
+    if (!bytes || !out_root || byte_count == 0)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    uint8_t last_byte = bytes[byte_count - 1];
+    if (last_byte == 0 || byte_count - 1 > max_bits / 8)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    unsigned int delimiter = 7;
+    while (!(last_byte & (1u << delimiter)))
+    {
+        delimiter--;
+    }
+    size_t bit_count = (byte_count - 1) * 8 + delimiter;
+    if (bit_count > max_bits)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    size_t data_bytes = (bit_count + 7) / 8;
+    size_t chunk_count = (data_bytes + SSZ_BYTES_PER_CHUNK - 1) / SSZ_BYTES_PER_CHUNK;
+    ssz_merkleizer_t m;
+    ssz_merkleizer_init(&m, ((uint64_t)max_bits + SSZ_BYTES_PER_CHUNK * 8 - 1) / (SSZ_BYTES_PER_CHUNK * 8));
+    ssz_error_t err = SSZ_SUCCESS;
+    if (chunk_count != 0)
+    {
+        err = ssz_merkleizer_push_chunks(&m, bytes, chunk_count - 1);
+        if (err == SSZ_SUCCESS)
+        {
+            uint8_t last[SSZ_BYTES_PER_CHUNK] = {0};
+            size_t offset = (chunk_count - 1) * SSZ_BYTES_PER_CHUNK;
+            memcpy(last, bytes + offset, data_bytes - offset);
+            if (delimiter != 0)
+            {
+                last[data_bytes - offset - 1] &= (uint8_t)~(1u << delimiter);
+            }
+            err = ssz_merkleizer_push_chunk(&m, last);
+        }
+    }
+    if (err == SSZ_SUCCESS)
+    {
+        err = ssz_merkleizer_finalize(&m, out_root);
+    }
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    if (out_bit_count)
+    {
+        *out_bit_count = bit_count;
+    }
+    return ssz_mix_in_length(out_root, bit_count, out_root);
+}
+
+/**
+ * Returns floor(log2(gindex)), the depth of a generalized index below the root.
+ *
+ * @param gindex A non-zero generalized index.
+ * @return The number of levels between the node and the root.
+ */
+static unsigned int ssz_gindex_depth(uint64_t gindex)
+{
+    unsigned int depth = 0;
+    while (gindex >> (depth + 1))
+    {
+        depth++;
+    }
+    return depth;
+}
+
+/**
+ * Generates a Merkle proof for the node at a generalized index.
+ *
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes); may be NULL if chunk_count is 0.
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @param gindex Generalized index of the node to prove (1 for the root, 2^depth + i for chunk i).
+ * @param out_proof Output proof holding the node, its branch, the branch depth and gindex.
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_OUT_OF_RANGE if gindex lies below the leaf level,
+ *         or another error code on failure.
+ */
+ssz_error_t ssz_generate_proof(const uint8_t *chunks, size_t chunk_count, size_t limit, uint64_t gindex, ssz_merkle_proof_t *out_proof)
+{
+    if (!out_proof || gindex == 0 || (chunk_count != 0 && !chunks))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    if (limit != 0 && chunk_count > limit)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    unsigned int depth = ceil_log2(limit != 0 ? limit : chunk_count);
+    unsigned int proof_depth = ssz_gindex_depth(gindex);
+    if (proof_depth > depth)
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    out_proof->depth = proof_depth;
+    out_proof->gindex = gindex;
+    unsigned int level = depth - proof_depth;
+    if (chunk_count == 0)
+    {
+        memcpy(out_proof->leaf, zero_hash_table[level], SSZ_BYTES_PER_CHUNK);
+        for (unsigned int i = 0; i < proof_depth; i++)
+        {
+            memcpy(out_proof->branch[i], zero_hash_table[level + i], SSZ_BYTES_PER_CHUNK);
+        }
+        return SSZ_SUCCESS;
+    }
+    ssz_merkle_capture_t captures[SSZ_MAX_MERKLE_DEPTH + 1];
+    uint64_t index = gindex - ((uint64_t)1 << proof_depth);
+    captures[0].level = level;
+    captures[0].index = index;
+    captures[0].out = out_proof->leaf;
+    for (unsigned int i = 0; i < proof_depth; i++)
+    {
+        captures[i + 1].level = level + i;
+        captures[i + 1].index = (index >> i) ^ 1;
+        captures[i + 1].out = out_proof->branch[i];
+    }
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    return ssz_merkleize_levels(chunks, chunk_count, 0, depth, captures, proof_depth + 1, root);
+}
+
+/**
+ * Verifies a Merkle proof for the node at a generalized index.
+ *
+ * @param leaf The proven node (SSZ_BYTES_PER_CHUNK bytes).
+ * @param branch Sibling nodes, bottom first (depth * SSZ_BYTES_PER_CHUNK bytes).
+ * @param depth Number of branch nodes; must equal floor(log2(gindex)).
+ * @param gindex Generalized index of the proven node.
+ * @param root Expected Merkle root (SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the branch hashes the leaf up to root, false otherwise.
+ */
+bool ssz_verify_proof(const uint8_t *leaf, const uint8_t *branch, unsigned int depth, uint64_t gindex, const uint8_t *root)
+{
+    if (!leaf || !root || (depth != 0 && !branch) || gindex == 0 || ssz_gindex_depth(gindex) != depth)
+    {
+        return false;
+    }
+    uint8_t node[SSZ_BYTES_PER_CHUNK];
+    memcpy(node, leaf, SSZ_BYTES_PER_CHUNK);
+    for (unsigned int i = 0; i < depth; i++)
+    {
+        const uint8_t *sibling = branch + (size_t)i * SSZ_BYTES_PER_CHUNK;
+        if ((gindex >> i) & 1)
+        {
+            ssz_hash_pair(sibling, node, node);
+        }
+        else
+        {
+            ssz_hash_pair(node, sibling, node);
+        }
+    }
+    return memcmp(node, root, SSZ_BYTES_PER_CHUNK) == 0;
+}
+
+/**
+ * Computes the dedupe table key of a 64-byte message by folding all eight of its words.
+ *
+ * Leaves are caller data, such as packed balances or zero chunks, so any fixed subset of the
+ * bytes can repeat across many different messages; folding the whole message keeps the probe
+ * sequences short.
+ *
+ * @param message The 64-byte message.
+ * @return The key.
+ */
+static uint64_t ssz_message_key(const uint8_t *message)
+{
+    uint64_t key = 0;
+    for (size_t i = 0; i < 2 * SSZ_BYTES_PER_CHUNK; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, message + i, sizeof(word));
+        key = (key ^ word) * 0x9E3779B97F4A7C15ULL;
+    }
+    return key ^ (key >> 32);
+}
+
+/**
+ * Verifies many single-node proofs together.
+ *
+ * Each round hashes one level of every proof that is still climbing. The 64-byte inputs of the
+ * round are written to a message array and deduplicated through an open-addressing table keyed
+ * by ssz_message_key.
+ *
+ * @param items The proofs to verify.
+ * @param item_count Number of proofs.
+ * @param out_valid Output array receiving the verdict for each proof (item_count entries).
+ * @return SSZ_SUCCESS if every proof was checked (whatever the verdicts), or an error code on failure.
+ */
+ssz_error_t ssz_verify_proofs_batch(const ssz_proof_batch_item_t *items, size_t item_count, bool *out_valid)
+{
+    if (item_count == 0)
+    {
+        return SSZ_SUCCESS;
+    }
+    if (!items || !out_valid)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    if (item_count > SIZE_MAX / (2 * SSZ_BYTES_PER_CHUNK) || item_count > SIZE_MAX / (4 * sizeof(size_t)))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    size_t table_size = (size_t)next_pow_of_two(2 * (uint64_t)item_count);
+    uint8_t *nodes = malloc(item_count * SSZ_BYTES_PER_CHUNK);
+    uint8_t *messages = malloc(item_count * 2 * SSZ_BYTES_PER_CHUNK);
+    size_t *slots = malloc(item_count * sizeof(size_t));
+    size_t *table = malloc(table_size * sizeof(size_t));
+    if (!nodes || !messages || !slots || !table)
+    {
+        free(nodes);
+        free(messages);
+        free(slots);
+        free(table);
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    unsigned int max_depth = 0;
+    for (size_t j = 0; j < item_count; j++)
+    {
+        const ssz_proof_batch_item_t *item = &items[j];
+        out_valid[j] = item->leaf && item->root && (item->depth == 0 || item->branch) && item->gindex != 0 &&
+                       ssz_gindex_depth(item->gindex) == item->depth;
+        if (out_valid[j])
+        {
+            memcpy(nodes + j * SSZ_BYTES_PER_CHUNK, item->leaf, SSZ_BYTES_PER_CHUNK);
+            if (item->depth > max_depth)
+            {
+                max_depth = item->depth;
+            }
+        }
+    }
+    for (unsigned int level = 0; level < max_depth; level++)
+    {
+        size_t unique = 0;
+        for (size_t i = 0; i < table_size; i++)
+        {
+            table[i] = SIZE_MAX;
+        }
+        for (size_t j = 0; j < item_count; j++)
+        {
+            const ssz_proof_batch_item_t *item = &items[j];
+            if (!out_valid[j] || item->depth <= level)
+            {
+                continue;
+            }
+            uint8_t *message = messages + unique * 2 * SSZ_BYTES_PER_CHUNK;
+            const uint8_t *sibling = item->branch + (size_t)level * SSZ_BYTES_PER_CHUNK;
+            bool is_right = (item->gindex >> level) & 1;
+            memcpy(message, is_right ? sibling : nodes + j * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK);
+            memcpy(message + SSZ_BYTES_PER_CHUNK, is_right ? nodes + j * SSZ_BYTES_PER_CHUNK : sibling, SSZ_BYTES_PER_CHUNK);
+            size_t h = (size_t)ssz_message_key(message) & (table_size - 1);
+            while (table[h] != SIZE_MAX &&
+                   memcmp(messages + table[h] * 2 * SSZ_BYTES_PER_CHUNK, message, 2 * SSZ_BYTES_PER_CHUNK) != 0)
+            {
+                h = (h + 1) & (table_size - 1);
+            }
+            if (table[h] == SIZE_MAX)
+            {
+                table[h] = unique++;
+            }
+            slots[j] = table[h];
+        }
+        ssz_sha256_64B_xN(messages, unique, messages);
+        for (size_t j = 0; j < item_count; j++)
+        {
+            if (out_valid[j] && items[j].depth > level)
+            {
+                memcpy(nodes + j * SSZ_BYTES_PER_CHUNK, messages + slots[j] * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK);
+            }
+        }
+    }
+    for (size_t j = 0; j < item_count; j++)
+    {
+        out_valid[j] = out_valid[j] && memcmp(nodes + j * SSZ_BYTES_PER_CHUNK, items[j].root, SSZ_BYTES_PER_CHUNK) == 0;
+    }
+    free(nodes);
+    free(messages);
+    free(slots);
+    free(table);
     return SSZ_SUCCESS;
-}
\ No newline at end of file
+}
+
+/**
+ * Orders generalized indices from highest to lowest.
+ */
+static int ssz_gindex_compare_desc(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? 1 : (x > y ? -1 : 0);
+}
+
+/**
+ * Sorts generalized indices in descending order and removes duplicates.
+ *
+ * @param indices The indices to sort in place.
+ * @param count Number of indices.
+ * @return Number of distinct indices left at the front of the array.
+ */
+static size_t ssz_gindex_sort_unique(uint64_t *indices, size_t count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    qsort(indices, count, sizeof(uint64_t), ssz_gindex_compare_desc);
+    size_t unique = 1;
+    for (size_t i = 1; i < count; i++)
+    {
+        if (indices[i] != indices[unique - 1])
+        {
+            indices[unique++] = indices[i];
+        }
+    }
+    return unique;
+}
+
+/**
+ * Computes the helper indices of a multiproof for a set of generalized indices.
+ *
+ * @param gindices Generalized indices of the proven nodes; each must be non-zero.
+ * @param gindex_count Number of generalized indices.
+ * @param out_helper_indices Output array for the helper indices; may be NULL to query the count only.
+ * @param out_helper_count On input the capacity of out_helper_indices; on output the number of helper indices.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_get_helper_indices(const uint64_t *gindices, size_t gindex_count, uint64_t *out_helper_indices, size_t *out_helper_count)
+{
+    if (!out_helper_count || (gindex_count != 0 && !gindices))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < gindex_count; i++)
+    {
+        if (gindices[i] == 0)
+        {
+            return SSZ_ERROR_MERKLEIZATION;
+        }
+        total += ssz_gindex_depth(gindices[i]);
+    }
+    uint64_t *branch = malloc((2 * total + 1) * sizeof(uint64_t));
+    if (!branch)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    uint64_t *path = branch + total;
+    size_t n = 0;
+    for (size_t i = 0; i < gindex_count; i++)
+    {
+        for (uint64_t g = gindices[i]; g > 1; g >>= 1)
+        {
+            branch[n] = g ^ 1;
+            path[n] = g;
+            n++;
+        }
+    }
+    size_t branch_count = ssz_gindex_sort_unique(branch, n);
+    size_t path_count = ssz_gindex_sort_unique(path, n);
+    size_t helper_count = 0;
+    for (size_t i = 0, j = 0; i < branch_count; i++)
+    {
+        while (j < path_count && path[j] > branch[i])
+        {
+            j++;
+        }
+        if (j == path_count || path[j] != branch[i])
+        {
+            branch[helper_count++] = branch[i];
+        }
+    }
+    ssz_error_t err = SSZ_SUCCESS;
+    if (out_helper_indices)
+    {
+        if (helper_count > *out_helper_count)
+        {
+            err = SSZ_ERROR_MERKLEIZATION;
+        }
+        else if (helper_count != 0)
+        {
+            memcpy(out_helper_indices, branch, helper_count * sizeof(uint64_t));
+        }
+    }
+    *out_helper_count = helper_count;
+    free(branch);
+    return err;
+}
+
+/**
+ * Orders captures by ascending tree level.
+ */
+static int ssz_merkle_capture_compare(const void *a, const void *b)
+{
+    unsigned int x = ((const ssz_merkle_capture_t *)a)->level;
+    unsigned int y = ((const ssz_merkle_capture_t *)b)->level;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * Generates a multiproof for several nodes of one tree.
+ *
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes); may be NULL if chunk_count is 0.
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @param gindices Generalized indices of the proven nodes.
+ * @param gindex_count Number of generalized indices.
+ * @param helper_indices Helper indices as returned by ssz_get_helper_indices for gindices.
+ * @param helper_count Number of helper indices.
+ * @param out_leaves Output buffer for the proven nodes, in gindices order (gindex_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @param out_helpers Output buffer for the helper nodes, in helper_indices order (helper_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_OUT_OF_RANGE if an index lies below the leaf level,
+ *         or another error code on failure.
+ */
+ssz_error_t ssz_generate_multiproof(const uint8_t *chunks, size_t chunk_count, size_t limit,
+                                    const uint64_t *gindices, size_t gindex_count,
+                                    const uint64_t *helper_indices, size_t helper_count,
+                                    uint8_t *out_leaves, uint8_t *out_helpers)
+{
+    if ((chunk_count != 0 && !chunks) || (gindex_count != 0 && (!gindices || !out_leaves)) ||
+        (helper_count != 0 && (!helper_indices || !out_helpers)))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    if (limit != 0 && chunk_count > limit)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    unsigned int depth = ceil_log2(limit != 0 ? limit : chunk_count);
+    size_t capture_count = gindex_count + helper_count;
+    ssz_merkle_capture_t *captures = malloc((capture_count ? capture_count : 1) * sizeof(ssz_merkle_capture_t));
+    if (!captures)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    ssz_error_t err = SSZ_SUCCESS;
+    for (size_t i = 0; i < capture_count; i++)
+    {
+        uint64_t g = i < gindex_count ? gindices[i] : helper_indices[i - gindex_count];
+        unsigned int g_depth = ssz_gindex_depth(g);
+        if (g == 0 || g_depth > depth)
+        {
+            err = g == 0 ? SSZ_ERROR_MERKLEIZATION : SSZ_ERROR_OUT_OF_RANGE;
+            break;
+        }
+        captures[i].level = depth - g_depth;
+        captures[i].index = g - ((uint64_t)1 << g_depth);
+        captures[i].out = i < gindex_count ? out_leaves + i * SSZ_BYTES_PER_CHUNK
+                                           : out_helpers + (i - gindex_count) * SSZ_BYTES_PER_CHUNK;
+    }
+    if (err == SSZ_SUCCESS)
+    {
+        if (chunk_count == 0)
+        {
+            for (size_t i = 0; i < capture_count; i++)
+            {
+                memcpy(captures[i].out, zero_hash_table[captures[i].level], SSZ_BYTES_PER_CHUNK);
+            }
+        }
+        else
+        {
+            uint8_t root[SSZ_BYTES_PER_CHUNK];
+            qsort(captures, capture_count, sizeof(ssz_merkle_capture_t), ssz_merkle_capture_compare);
+            err = ssz_merkleize_levels(chunks, chunk_count, 0, depth, captures, capture_count, root);
+        }
+    }
+    free(captures);
+    return err;
+}
+
+/**
+ * Holds one known node while a multiproof is being verified.
+ */
+typedef struct
+{
+    uint64_t gindex;
+    uint8_t node[SSZ_BYTES_PER_CHUNK];
+} ssz_multiproof_node_t;
+
+/**
+ * Orders known nodes deepest level first, then left to right.
+ */
+static int ssz_multiproof_node_compare(const void *a, const void *b)
+{
+    uint64_t x = ((const ssz_multiproof_node_t *)a)->gindex;
+    uint64_t y = ((const ssz_multiproof_node_t *)b)->gindex;
+    unsigned int dx = ssz_gindex_depth(x);
+    unsigned int dy = ssz_gindex_depth(y);
+    if (dx != dy)
+    {
+        return dx > dy ? -1 : 1;
+    }
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * Rebuilds the root from a set of known nodes, one level at a time.
+ *
+ * On each level the computed parents of the level below are merged with the known nodes of
+ * that level; every node must then have its sibling present, and all sibling pairs of the
+ * level are hashed as one batch. A known node that is also computed must match.
+ *
+ * @param known The known nodes, sorted deepest first and left to right within a level.
+ * @param known_count Number of known nodes; must be non-zero.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the nodes form a complete proof, false otherwise.
+ */
+static bool ssz_multiproof_root(const ssz_multiproof_node_t *known, size_t known_count, uint8_t *out_root)
+{
+    ssz_multiproof_node_t *level_nodes = malloc(2 * known_count * sizeof(ssz_multiproof_node_t));
+    uint8_t *pairs = malloc(known_count * SSZ_BYTES_PER_CHUNK);
+    if (!level_nodes || !pairs)
+    {
+        free(level_nodes);
+        free(pairs);
+        return false;
+    }
+    ssz_multiproof_node_t *cur = level_nodes;
+    ssz_multiproof_node_t *merged = level_nodes + known_count;
+    size_t cur_count = 0;
+    size_t pos = 0;
+    bool ok = true;
+    for (unsigned int depth = ssz_gindex_depth(known[0].gindex);; depth--)
+    {
+        size_t merged_count = 0;
+        size_t i = 0;
+        while (ok && (i < cur_count || (pos < known_count && ssz_gindex_depth(known[pos].gindex) == depth)))
+        {
+            bool take_known = pos < known_count && ssz_gindex_depth(known[pos].gindex) == depth &&
+                              (i == cur_count || known[pos].gindex <= cur[i].gindex);
+            if (take_known && i < cur_count && known[pos].gindex == cur[i].gindex)
+            {
+                ok = memcmp(known[pos].node, cur[i].node, SSZ_BYTES_PER_CHUNK) == 0;
+                i++;
+            }
+            merged[merged_count++] = take_known ? known[pos++] : cur[i++];
+        }
+        ssz_multiproof_node_t *swap = cur;
+        cur = merged;
+        merged = swap;
+        cur_count = merged_count;
+        if (!ok || depth == 0)
+        {
+            break;
+        }
+        if (cur_count & 1)
+        {
+            ok = false;
+            break;
+        }
+        for (size_t k = 0; k < cur_count; k += 2)
+        {
+            if ((cur[k].gindex & 1) || cur[k + 1].gindex != cur[k].gindex + 1)
+            {
+                ok = false;
+                break;
+            }
+            memcpy(pairs + k * SSZ_BYTES_PER_CHUNK, cur[k].node, SSZ_BYTES_PER_CHUNK);
+            memcpy(pairs + (k + 1) * SSZ_BYTES_PER_CHUNK, cur[k + 1].node, SSZ_BYTES_PER_CHUNK);
+        }
+        if (!ok)
+        {
+            break;
+        }
+        ssz_sha256_64B_xN(pairs, cur_count / 2, pairs);
+        for (size_t k = 0; k < cur_count / 2; k++)
+        {
+            cur[k].gindex = cur[2 * k].gindex >> 1;
+            memcpy(cur[k].node, pairs + k * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK);
+        }
+        cur_count /= 2;
+    }
+    ok = ok && pos == known_count && cur_count == 1 && cur[0].gindex == 1;
+    if (ok)
+    {
+        memcpy(out_root, cur[0].node, SSZ_BYTES_PER_CHUNK);
+    }
+    free(level_nodes);
+    free(pairs);
+    return ok;
+}
+
+/**
+ * Verifies a multiproof for several nodes against a Merkle root.
+ *
+ * @param leaves The proven nodes, in gindices order (gindex_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @param gindices Generalized indices of the proven nodes.
+ * @param gindex_count Number of generalized indices.
+ * @param helpers The helper nodes, in descending helper index order (helper_count * SSZ_BYTES_PER_CHUNK bytes).
+ * @param helper_count Number of helper nodes.
+ * @param root Expected Merkle root (SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the proof hashes up to root, false otherwise.
+ */
+bool ssz_verify_multiproof(const uint8_t *leaves, const uint64_t *gindices, size_t gindex_count,
+                           const uint8_t *helpers, size_t helper_count, const uint8_t *root)
+{
+    if (gindex_count == 0 || !leaves || !gindices || !root || (helper_count != 0 && !helpers))
+    {
+        return false;
+    }
+    size_t expected_count = 0;
+    if (ssz_get_helper_indices(gindices, gindex_count, NULL, &expected_count) != SSZ_SUCCESS ||
+        expected_count != helper_count)
+    {
+        return false;
+    }
+    size_t known_count = gindex_count + helper_count;
+    uint64_t *helper_indices = malloc((helper_count + 1) * sizeof(uint64_t));
+    ssz_multiproof_node_t *known = malloc(known_count * sizeof(ssz_multiproof_node_t));
+    bool ok = helper_indices && known &&
+              ssz_get_helper_indices(gindices, gindex_count, helper_indices, &expected_count) == SSZ_SUCCESS;
+    if (ok)
+    {
+        for (size_t i = 0; i < known_count; i++)
+        {
+            known[i].gindex = i < gindex_count ? gindices[i] : helper_indices[i - gindex_count];
+            memcpy(known[i].node, i < gindex_count ? leaves + i * SSZ_BYTES_PER_CHUNK
+                                                   : helpers + (i - gindex_count) * SSZ_BYTES_PER_CHUNK,
+                   SSZ_BYTES_PER_CHUNK);
+        }
+        qsort(known, known_count, sizeof(ssz_multiproof_node_t), ssz_multiproof_node_compare);
+        size_t unique = 1;
+        for (size_t i = 1; i < known_count && ok; i++)
+        {
+            if (known[i].gindex != known[unique - 1].gindex)
+            {
+                known[unique++] = known[i];
+            }
+            else
+            {
+                ok = memcmp(known[i].node, known[unique - 1].node, SSZ_BYTES_PER_CHUNK) == 0;
+            }
+        }
+        uint8_t computed[SSZ_BYTES_PER_CHUNK];
+        ok = ok && ssz_multiproof_root(known, unique, computed) &&
+             memcmp(computed, root, SSZ_BYTES_PER_CHUNK) == 0;
+    }
+    free(helper_indices);
+    free(known);
+    return ok;
+}
@@ -0,0 +1,335 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ssz_merkle_tree.h"
+#include "ssz_hash.h"
+#include "ssz_utils.h"
+
+#define NODE(tree, g) ((tree)->nodes + (size_t)(g) * SSZ_BYTES_PER_CHUNK)
+
+/**
+ * Allocates node storage and dirty bookkeeping for a given number of leaves.
+ *
+ * @param tree Pointer to the tree.
+ * @param capacity Number of leaves, a power of two.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION if allocation fails.
+ */
+static ssz_error_t ssz_merkle_tree_alloc(ssz_merkle_tree_t *tree, size_t capacity)
+{
+    tree->nodes = malloc(2 * capacity * SSZ_BYTES_PER_CHUNK);
+    tree->dirty_flags = calloc(capacity, 1);
+    tree->dirty = malloc(capacity * sizeof(size_t));
+    if (!tree->nodes || !tree->dirty_flags || !tree->dirty)
+    {
+        ssz_merkle_tree_free(tree);
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    memset(tree->dirty_count, 0, sizeof(tree->dirty_count));
+    tree->capacity = capacity;
+    tree->capacity_depth = ceil_log2(capacity);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Fills one level of the held subtree from the level below it.
+ *
+ * The first populated_children nodes of the level below are hashed pairwise as one batch;
+ * an odd last child is paired with the zero-subtree hash, and every parent beyond the populated
+ * range is set to the zero-subtree hash of its level.
+ *
+ * @param tree Pointer to the tree.
+ * @param level Level to fill (1 for the parents of the leaves).
+ * @param populated_children Number of populated nodes on the level below.
+ */
+static void ssz_merkle_tree_fill_level(ssz_merkle_tree_t *tree, unsigned int level, size_t populated_children)
+{
+    size_t first = tree->capacity >> level;
+    uint8_t *children = NODE(tree, 2 * first);
+    uint8_t *parents = NODE(tree, first);
+    size_t pairs = populated_children >> 1;
+    ssz_sha256_64B_xN(children, pairs, parents);
+    size_t populated = pairs;
+    if (populated_children & 1)
+    {
+        ssz_hash_pair(children + (populated_children - 1) * SSZ_BYTES_PER_CHUNK, zero_hash_table[level - 1],
+                      parents + pairs * SSZ_BYTES_PER_CHUNK);
+        populated++;
+    }
+    for (size_t i = populated; i < first; i++)
+    {
+        memcpy(parents + i * SSZ_BYTES_PER_CHUNK, zero_hash_table[level], SSZ_BYTES_PER_CHUNK);
+    }
+}
+
+/**
+ * Rehashes every dirty interior node, lowest level first, and clears the dirty lists.
+ *
+ * @param tree Pointer to the tree.
+ */
+static void ssz_merkle_tree_flush(ssz_merkle_tree_t *tree)
+{
+    for (unsigned int level = 1; level <= tree->capacity_depth; level++)
+    {
+        const size_t *list = tree->dirty + (tree->capacity >> level);
+        for (size_t i = 0; i < tree->dirty_count[level]; i++)
+        {
+            size_t g = list[i];
+            ssz_hash_pair(NODE(tree, 2 * g), NODE(tree, 2 * g + 1), NODE(tree, g));
+            tree->dirty_flags[g] = 0;
+        }
+        tree->dirty_count[level] = 0;
+    }
+}
+
+/**
+ * Doubles the number of leaves held; the old subtree becomes the left half of the new one.
+ *
+ * Pending changes are flushed first so that the copied levels are consistent. The new root
+ * is left for the caller to mark dirty.
+ *
+ * @param tree Pointer to the tree.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION if allocation fails.
+ */
+static ssz_error_t ssz_merkle_tree_grow(ssz_merkle_tree_t *tree)
+{
+    ssz_merkle_tree_flush(tree);
+    ssz_merkle_tree_t grown = *tree;
+    if (ssz_merkle_tree_alloc(&grown, 2 * tree->capacity) != SSZ_SUCCESS)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    for (unsigned int level = 0; level <= tree->capacity_depth; level++)
+    {
+        size_t width = tree->capacity >> level;
+        memcpy(NODE(&grown, 2 * width), NODE(tree, width), width * SSZ_BYTES_PER_CHUNK);
+        for (size_t i = width; i < 2 * width; i++)
+        {
+            memcpy(NODE(&grown, 2 * width + i), zero_hash_table[level], SSZ_BYTES_PER_CHUNK);
+        }
+    }
+    free(tree->nodes);
+    free(tree->dirty_flags);
+    free(tree->dirty);
+    *tree = grown;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Builds a persistent Merkle tree from an array of chunks.
+ *
+ * @param tree Pointer to the tree to initialize.
+ * @param chunks Pointer to the array of chunks (each chunk is SSZ_BYTES_PER_CHUNK bytes); may be NULL if chunk_count is 0.
+ * @param chunk_count Number of chunks provided.
+ * @param limit Maximum number of chunks allowed; if non-zero, chunk_count must not exceed this limit.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkle_tree_init(ssz_merkle_tree_t *tree, const uint8_t *chunks, size_t chunk_count, size_t limit)
+{
+    if (!tree || (chunk_count != 0 && !chunks))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    if (limit != 0 && chunk_count > limit)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    tree->nodes = NULL;
+    tree->dirty_flags = NULL;
+    tree->dirty = NULL;
+    tree->chunk_count = chunk_count;
+    tree->limit = limit;
+    ssz_error_t err = ssz_merkle_tree_alloc(tree, (size_t)1 << ceil_log2(chunk_count ? chunk_count : 1));
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    if (chunk_count)
+    {
+        memcpy(NODE(tree, tree->capacity), chunks, chunk_count * SSZ_BYTES_PER_CHUNK);
+    }
+    memset(NODE(tree, tree->capacity + chunk_count), 0, (tree->capacity - chunk_count) * SSZ_BYTES_PER_CHUNK);
+    size_t populated = chunk_count;
+    for (unsigned int level = 1; level <= tree->capacity_depth; level++)
+    {
+        ssz_merkle_tree_fill_level(tree, level, populated);
+        populated = (populated + 1) >> 1;
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Replaces or appends a chunk and marks its path to the root dirty.
+ *
+ * Marking stops at the first ancestor that is already dirty, so each interior node is listed
+ * at most once per root computation.
+ *
+ * @param tree Pointer to the tree.
+ * @param index Index of the chunk; at most the current chunk count.
+ * @param chunk Pointer to the new chunk (SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkle_tree_set_chunk(ssz_merkle_tree_t *tree, size_t index, const uint8_t *chunk)
+{
+    if (index > tree->chunk_count || (tree->limit != 0 && index >= tree->limit))
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    if (index == tree->capacity)
+    {
+        ssz_error_t err = ssz_merkle_tree_grow(tree);
+        if (err != SSZ_SUCCESS)
+        {
+            return err;
+        }
+    }
+    if (index == tree->chunk_count)
+    {
+        tree->chunk_count++;
+    }
+    size_t g = tree->capacity + index;
+    memcpy(NODE(tree, g), chunk, SSZ_BYTES_PER_CHUNK);
+    for (unsigned int level = 1; (g >>= 1) != 0 && !tree->dirty_flags[g]; level++)
+    {
+        tree->dirty_flags[g] = 1;
+        tree->dirty[(tree->capacity >> level) + tree->dirty_count[level]++] = g;
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Returns a pointer to a chunk held by the tree.
+ *
+ * @param tree Pointer to the tree.
+ * @param index Index of the chunk; must be less than the chunk count.
+ * @return Pointer to the chunk, or NULL if the index is out of range.
+ */
+const uint8_t *ssz_merkle_tree_get_chunk(const ssz_merkle_tree_t *tree, size_t index)
+{
+    if (index >= tree->chunk_count)
+    {
+        return NULL;
+    }
+    return NODE(tree, tree->capacity + index);
+}
+
+/**
+ * Computes the Merkle root, rehashing only the paths of chunks changed since the last call.
+ *
+ * Above the held subtree the root is paired with zero-subtree hashes up to the depth implied
+ * by the limit (or by the chunk count when there is no limit).
+ *
+ * @param tree Pointer to the tree.
+ * @param out_root Output buffer to write the resulting Merkle root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_merkle_tree_root(ssz_merkle_tree_t *tree, uint8_t *out_root)
+{
+    ssz_merkle_tree_flush(tree);
+    unsigned int depth = ceil_log2(tree->limit != 0 ? tree->limit : tree->chunk_count);
+    if (tree->chunk_count == 0)
+    {
+        memcpy(out_root, zero_hash_table[depth], SSZ_BYTES_PER_CHUNK);
+        return SSZ_SUCCESS;
+    }
+    memcpy(out_root, NODE(tree, 1), SSZ_BYTES_PER_CHUNK);
+    for (unsigned int level = tree->capacity_depth; level < depth; level++)
+    {
+        ssz_hash_pair(out_root, zero_hash_table[level], out_root);
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Returns a node of the held subtree, or the zero-subtree hash for a node past its right edge.
+ *
+ * @param tree Pointer to the tree.
+ * @param level Level of the node (0 for leaf chunks).
+ * @param index Index of the node within its level.
+ * @return Pointer to the node (SSZ_BYTES_PER_CHUNK bytes), or NULL for a node above the held
+ *         subtree that contains it, which is not stored.
+ */
+static const uint8_t *ssz_merkle_tree_node_at(const ssz_merkle_tree_t *tree, unsigned int level, size_t index)
+{
+    if (level > tree->capacity_depth)
+    {
+        return index == 0 ? NULL : zero_hash_table[level];
+    }
+    if (index >= tree->capacity >> level)
+    {
+        return zero_hash_table[level];
+    }
+    return NODE(tree, (tree->capacity >> level) + index);
+}
+
+/**
+ * Descends into the subtree at a given level and index of both trees, reporting differing leaves.
+ *
+ * @param a Pointer to the first tree.
+ * @param b Pointer to the second tree.
+ * @param level Level of the subtree root (0 for leaf chunks).
+ * @param index Index of the subtree root within its level.
+ * @param callback Function called once for each differing chunk index.
+ * @param user_data Pointer passed through to the callback.
+ */
+static void ssz_merkle_tree_diff_node(const ssz_merkle_tree_t *a, const ssz_merkle_tree_t *b, unsigned int level,
+                                      size_t index, ssz_merkle_tree_diff_fn callback, void *user_data)
+{
+    const uint8_t *node_a = ssz_merkle_tree_node_at(a, level, index);
+    const uint8_t *node_b = ssz_merkle_tree_node_at(b, level, index);
+    if (node_a && node_b && memcmp(node_a, node_b, SSZ_BYTES_PER_CHUNK) == 0)
+    {
+        return;
+    }
+    if (level == 0)
+    {
+        callback(index, user_data);
+        return;
+    }
+    ssz_merkle_tree_diff_node(a, b, level - 1, 2 * index, callback, user_data);
+    ssz_merkle_tree_diff_node(a, b, level - 1, 2 * index + 1, callback, user_data);
+}
+
+/**
+ * Reports the indices of the chunks that differ between two persistent Merkle trees.
+ *
+ * Pending changes of both trees are flushed first. The walk starts at the root of the larger
+ * held subtree; the smaller tree is its left-most part, padded with zero-subtree hashes.
+ *
+ * @param a Pointer to the first tree.
+ * @param b Pointer to the second tree.
+ * @param callback Function called once for each differing chunk index.
+ * @param user_data Pointer passed through to the callback.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on invalid arguments.
+ */
+ssz_error_t ssz_merkle_tree_diff(ssz_merkle_tree_t *a, ssz_merkle_tree_t *b, ssz_merkle_tree_diff_fn callback, void *user_data)
+{
+    if (!a || !b || !callback || !a->nodes || !b->nodes)
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    ssz_merkle_tree_flush(a);
+    ssz_merkle_tree_flush(b);
+    unsigned int depth = a->capacity_depth > b->capacity_depth ? a->capacity_depth : b->capacity_depth;
+    ssz_merkle_tree_diff_node(a, b, depth, 0, callback, user_data);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Releases the memory held by a persistent Merkle tree.
+ *
+ * @param tree Pointer to the tree.
+ */
+void ssz_merkle_tree_free(ssz_merkle_tree_t *tree)
+{
+    if (!tree)
+    {
+        return;
+    }
+    free(tree->nodes);
+    free(tree->dirty_flags);
+    free(tree->dirty);
+    tree->nodes = NULL;
+    tree->dirty_flags = NULL;
+    tree->dirty = NULL;
+    tree->capacity = 0;
+    tree->chunk_count = 0;
+}
@@ -0,0 +1,204 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ssz_root_cache.h"
+
+/** Number of consecutive slots searched from the home slot of a key. */
+#define SSZ_ROOT_CACHE_PROBES 8
+
+/**
+ * Computes the 64-bit fingerprint of a key.
+ *
+ * The key is consumed eight bytes at a time with a multiply-xorshift mix. The lowest bit is
+ * forced to 1 so that a fingerprint is never 0, which marks an empty slot; the home slot is
+ * taken from the remaining bits.
+ *
+ * @param key Pointer to the key.
+ * @param key_size Size of the key in bytes.
+ * @return The fingerprint.
+ */
+static uint64_t ssz_root_cache_fingerprint(const uint8_t *key, size_t key_size)
+{
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (uint64_t)key_size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= key_size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, key + i, sizeof(word));
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+    if (i < key_size)
+    {
+        uint64_t word = 0;
+        memcpy(&word, key + i, key_size - i);
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+    h = (h ^ (h >> 29)) * 0x94D049BB133111EBULL;
+    h ^= h >> 32;
+    return h | 1;
+}
+
+/**
+ * Initializes a root cache.
+ *
+ * Entries start being replaced before the table is full, so the capacity should be a few times
+ * the number of distinct objects expected, e.g. four times the validator count.
+ *
+ * @param cache Pointer to the cache to initialize.
+ * @param key_size Size of every key in bytes; must be non-zero.
+ * @param capacity Minimum number of slots; rounded up to a power of two.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_MERKLEIZATION on invalid arguments or allocation failure.
+ */
+ssz_error_t ssz_root_cache_init(ssz_root_cache_t *cache, size_t key_size, size_t capacity)
+{
+    if (!cache || key_size == 0 || capacity == 0 || capacity > SIZE_MAX / 2 / (key_size + SSZ_BYTES_PER_CHUNK))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    size_t slots = SSZ_ROOT_CACHE_PROBES;
+    while (slots < capacity)
+    {
+        slots <<= 1;
+    }
+    cache->tags = calloc(slots, sizeof(uint64_t));
+    cache->keys = malloc(slots * key_size);
+    cache->roots = malloc(slots * SSZ_BYTES_PER_CHUNK);
+    cache->key_size = key_size;
+    cache->capacity = slots;
+    cache->entries = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    if (!cache->tags || !cache->keys || !cache->roots)
+    {
+        ssz_root_cache_free(cache);
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Looks up the root cached for a key and counts the lookup as a hit or a miss.
+ *
+ * The search stops at the first empty slot or after SSZ_ROOT_CACHE_PROBES slots.
+ *
+ * @param cache Pointer to the cache.
+ * @param key Pointer to the key (key_size bytes).
+ * @param out_root Output buffer for the root on a hit (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return true if the root was found, false otherwise.
+ */
+bool ssz_root_cache_lookup(ssz_root_cache_t *cache, const uint8_t *key, uint8_t *out_root)
+{
+    uint64_t tag = ssz_root_cache_fingerprint(key, cache->key_size);
+    size_t mask = cache->capacity - 1;
+    for (size_t p = 0; p < SSZ_ROOT_CACHE_PROBES; p++)
+    {
+        size_t slot = ((size_t)(tag >> 1) + p) & mask;
+        if (cache->tags[slot] == 0)
+        {
+            break;
+        }
+        if (cache->tags[slot] == tag && memcmp(cache->keys + slot * cache->key_size, key, cache->key_size) == 0)
+        {
+            memcpy(out_root, cache->roots + slot * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK);
+            cache->hits++;
+            return true;
+        }
+    }
+    cache->misses++;
+    return false;
+}
+
+/**
+ * Stores the root of a key, replacing an older entry if the probe window is full.
+ *
+ * An existing entry for the same key is overwritten in place; otherwise the first empty slot of
+ * the window is used, or the home slot when there is none. Replacing never empties a slot, so
+ * the search windows of other keys stay intact.
+ *
+ * @param cache Pointer to the cache.
+ * @param key Pointer to the key (key_size bytes).
+ * @param root Pointer to the root of the key (SSZ_BYTES_PER_CHUNK bytes).
+ */
+void ssz_root_cache_insert(ssz_root_cache_t *cache, const uint8_t *key, const uint8_t *root)
+{
+    uint64_t tag = ssz_root_cache_fingerprint(key, cache->key_size);
+    size_t mask = cache->capacity - 1;
+    size_t target = (size_t)(tag >> 1) & mask;
+    for (size_t p = 0; p < SSZ_ROOT_CACHE_PROBES; p++)
+    {
+        size_t slot = ((size_t)(tag >> 1) + p) & mask;
+        if (cache->tags[slot] == 0)
+        {
+            target = slot;
+            cache->entries++;
+            break;
+        }
+        if (cache->tags[slot] == tag && memcmp(cache->keys + slot * cache->key_size, key, cache->key_size) == 0)
+        {
+            target = slot;
+            break;
+        }
+    }
+    cache->tags[target] = tag;
+    memcpy(cache->keys + target * cache->key_size, key, cache->key_size);
+    memcpy(cache->roots + target * SSZ_BYTES_PER_CHUNK, root, SSZ_BYTES_PER_CHUNK);
+}
+
+/**
+ * Reads the cache counters for monitoring.
+ *
+ * @param cache Pointer to the cache.
+ * @param out_hits Optional pointer to store the number of hits; may be NULL.
+ * @param out_misses Optional pointer to store the number of misses; may be NULL.
+ * @param out_entries Optional pointer to store the number of cached roots; may be NULL.
+ */
+void ssz_root_cache_stats(const ssz_root_cache_t *cache, uint64_t *out_hits, uint64_t *out_misses, size_t *out_entries)
+{
+    if (out_hits)
+    {
+        *out_hits = cache->hits;
+    }
+    if (out_misses)
+    {
+        *out_misses = cache->misses;
+    }
+    if (out_entries)
+    {
+        *out_entries = cache->entries;
+    }
+}
+
+/**
+ * Removes every entry and resets the counters, keeping the allocated table.
+ *
+ * @param cache Pointer to the cache.
+ */
+void ssz_root_cache_clear(ssz_root_cache_t *cache)
+{
+    memset(cache->tags, 0, cache->capacity * sizeof(uint64_t));
+    cache->entries = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+/**
+ * Releases the memory held by a root cache.
+ *
+ * @param cache Pointer to the cache.
+ */
+void ssz_root_cache_free(ssz_root_cache_t *cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+    free(cache->tags);
+    free(cache->keys);
+    free(cache->roots);
+    cache->tags = NULL;
+    cache->keys = NULL;
+    cache->roots = NULL;
+    cache->capacity = 0;
+    cache->entries = 0;
+}
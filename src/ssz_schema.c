@@ -0,0 +1,430 @@
+#include <string.h>
+#include "ssz_schema.h"
+#include "ssz_merkle.h"
+
+/** Number of child roots buffered before they are pushed into a merkleizer as one block. */
+#define SSZ_SCHEMA_ROOT_BATCH 64
+
+const ssz_type_desc_t ssz_type_uint8 = {SSZ_TYPE_UINT, SSZ_BYTE_SIZE_OF_UINT8, 0, NULL, NULL};
+const ssz_type_desc_t ssz_type_uint16 = {SSZ_TYPE_UINT, SSZ_BYTE_SIZE_OF_UINT16, 0, NULL, NULL};
+const ssz_type_desc_t ssz_type_uint32 = {SSZ_TYPE_UINT, SSZ_BYTE_SIZE_OF_UINT32, 0, NULL, NULL};
+const ssz_type_desc_t ssz_type_uint64 = {SSZ_TYPE_UINT, SSZ_BYTE_SIZE_OF_UINT64, 0, NULL, NULL};
+const ssz_type_desc_t ssz_type_uint128 = {SSZ_TYPE_UINT, SSZ_BYTE_SIZE_OF_UINT128, 0, NULL, NULL};
+const ssz_type_desc_t ssz_type_uint256 = {SSZ_TYPE_UINT, SSZ_BYTE_SIZE_OF_UINT256, 0, NULL, NULL};
+const ssz_type_desc_t ssz_type_boolean = {SSZ_TYPE_BOOLEAN, SSZ_BYTE_SIZE_OF_BOOL, 0, NULL, NULL};
+
+/**
+ * Reads a little-endian offset from a serialized buffer.
+ *
+ * @param p Pointer to SSZ_BYTES_PER_LENGTH_OFFSET bytes.
+ * @return The offset value.
+ */
+static size_t ssz_read_offset(const uint8_t *p)
+{
+    return (size_t)p[0] | (size_t)p[1] << 8 | (size_t)p[2] << 16 | (size_t)p[3] << 24;
+}
+
+/**
+ * Returns whether a type is basic, i.e. packed into chunks rather than rooted per element.
+ *
+ * @param type Pointer to the type descriptor.
+ * @return true for uints and booleans.
+ */
+static bool ssz_type_is_basic(const ssz_type_desc_t *type)
+{
+    return type->kind == SSZ_TYPE_UINT || type->kind == SSZ_TYPE_BOOLEAN;
+}
+
+/**
+ * Returns the serialized size of a fixed-size type.
+ *
+ * @param type Pointer to the type descriptor.
+ * @return The size in bytes, or 0 if the type is variable-size.
+ */
+size_t ssz_type_fixed_size(const ssz_type_desc_t *type)
+{
+    switch (type->kind)
+    {
+    case SSZ_TYPE_UINT:
+        return type->size;
+    case SSZ_TYPE_BOOLEAN:
+        return SSZ_BYTE_SIZE_OF_BOOL;
+    case SSZ_TYPE_BITVECTOR:
+        return (size_t)((type->length + SSZ_BITS_PER_BYTE - 1) / SSZ_BITS_PER_BYTE);
+    case SSZ_TYPE_VECTOR:
+        return (size_t)type->length * ssz_type_fixed_size(type->element);
+    case SSZ_TYPE_CONTAINER:
+    {
+        size_t total = 0;
+        for (uint64_t i = 0; i < type->length; i++)
+        {
+            size_t field_size = ssz_type_fixed_size(type->fields[i]);
+            if (field_size == 0)
+            {
+                return 0;
+            }
+            total += field_size;
+        }
+        return total;
+    }
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Merkleizes packed bytes where they lie; only a partial last chunk is zero-padded on the stack.
+ *
+ * @param bytes Pointer to the packed bytes.
+ * @param len Number of bytes.
+ * @param chunk_limit Maximum number of chunks, which sets the tree depth.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code if the limit is exceeded.
+ */
+static ssz_error_t ssz_merkleize_packed(const uint8_t *bytes, size_t len, uint64_t chunk_limit, uint8_t *out_root)
+{
+    ssz_merkleizer_t m;
+    ssz_error_t err = ssz_merkleizer_init(&m, chunk_limit);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    size_t full_chunks = len / SSZ_BYTES_PER_CHUNK;
+    size_t tail = len % SSZ_BYTES_PER_CHUNK;
+    err = ssz_merkleizer_push_chunks(&m, bytes, full_chunks);
+    if (err == SSZ_SUCCESS && tail != 0)
+    {
+        uint8_t last[SSZ_BYTES_PER_CHUNK] = {0};
+        memcpy(last, bytes + full_chunks * SSZ_BYTES_PER_CHUNK, tail);
+        err = ssz_merkleizer_push_chunk(&m, last);
+    }
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    return ssz_merkleizer_finalize(&m, out_root);
+}
+
+/**
+ * Checks that every byte of a packed boolean sequence is 0 or 1.
+ *
+ * @param bytes Pointer to the packed booleans.
+ * @param len Number of booleans.
+ * @return true if all values are valid.
+ */
+static bool ssz_booleans_valid(const uint8_t *bytes, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (bytes[i] > 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Merkleizes the roots of the elements of a composite vector or list.
+ *
+ * Fixed-size elements follow one another; variable-size elements are located through the offset
+ * table at the start of the buffer, which must be strictly laid out: the first offset ends the
+ * table, and each offset lies between its predecessor and the end of the buffer.
+ *
+ * @param element Pointer to the element type descriptor.
+ * @param buf Pointer to the serialized elements.
+ * @param len Size of the serialized elements in bytes.
+ * @param limit Vector length or list limit, which sets the tree depth.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @param out_count Pointer to store the number of elements found.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+static ssz_error_t ssz_merkleize_elements(const ssz_type_desc_t *element, const uint8_t *buf, size_t len,
+                                          uint64_t limit, uint8_t *out_root, size_t *out_count)
+{
+    size_t element_size = ssz_type_fixed_size(element);
+    size_t count;
+    if (element_size != 0)
+    {
+        if (len % element_size != 0)
+        {
+            return SSZ_ERROR_DESERIALIZATION;
+        }
+        count = len / element_size;
+    }
+    else if (len == 0)
+    {
+        count = 0;
+    }
+    else
+    {
+        if (len < SSZ_BYTES_PER_LENGTH_OFFSET)
+        {
+            return SSZ_ERROR_INVALID_OFFSET;
+        }
+        size_t first = ssz_read_offset(buf);
+        if (first == 0 || first % SSZ_BYTES_PER_LENGTH_OFFSET != 0 || first > len)
+        {
+            return SSZ_ERROR_INVALID_OFFSET;
+        }
+        count = first / SSZ_BYTES_PER_LENGTH_OFFSET;
+    }
+    if (count > limit)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    ssz_merkleizer_t m;
+    ssz_error_t err = ssz_merkleizer_init(&m, limit);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    uint8_t roots[SSZ_SCHEMA_ROOT_BATCH * SSZ_BYTES_PER_CHUNK];
+    size_t buffered = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t *start;
+        size_t size;
+        if (element_size != 0)
+        {
+            start = buf + i * element_size;
+            size = element_size;
+        }
+        else
+        {
+            size_t begin = ssz_read_offset(buf + i * SSZ_BYTES_PER_LENGTH_OFFSET);
+            size_t end = i + 1 < count ? ssz_read_offset(buf + (i + 1) * SSZ_BYTES_PER_LENGTH_OFFSET) : len;
+            if (begin > end || end > len)
+            {
+                return SSZ_ERROR_INVALID_OFFSET;
+            }
+            start = buf + begin;
+            size = end - begin;
+        }
+        err = ssz_hash_tree_root_serialized(element, start, size, roots + buffered * SSZ_BYTES_PER_CHUNK);
+        if (err != SSZ_SUCCESS)
+        {
+            return err;
+        }
+        if (++buffered == SSZ_SCHEMA_ROOT_BATCH)
+        {
+            err = ssz_merkleizer_push_chunks(&m, roots, buffered);
+            if (err != SSZ_SUCCESS)
+            {
+                return err;
+            }
+            buffered = 0;
+        }
+    }
+    err = ssz_merkleizer_push_chunks(&m, roots, buffered);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    *out_count = count;
+    return ssz_merkleizer_finalize(&m, out_root);
+}
+
+/**
+ * Merkleizes the roots of the fields of a container.
+ *
+ * The fixed part is walked in field order. A variable-size field spans from its offset to the
+ * offset of the next variable-size field, or to the end of the buffer for the last one.
+ *
+ * @param type Pointer to the container type descriptor.
+ * @param buf Pointer to the serialized container.
+ * @param len Size of the serialized container in bytes.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+static ssz_error_t ssz_merkleize_container(const ssz_type_desc_t *type, const uint8_t *buf, size_t len, uint8_t *out_root)
+{
+    size_t fixed_end = 0;
+    for (uint64_t i = 0; i < type->length; i++)
+    {
+        size_t field_size = ssz_type_fixed_size(type->fields[i]);
+        fixed_end += field_size != 0 ? field_size : SSZ_BYTES_PER_LENGTH_OFFSET;
+    }
+    if (fixed_end > len)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    ssz_merkleizer_t m;
+    ssz_error_t err = ssz_merkleizer_init(&m, type->length);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    uint8_t roots[SSZ_SCHEMA_ROOT_BATCH * SSZ_BYTES_PER_CHUNK];
+    size_t buffered = 0;
+    size_t pos = 0;
+    size_t previous_offset = fixed_end;
+    bool has_variable = false;
+    for (uint64_t i = 0; i < type->length; i++)
+    {
+        const ssz_type_desc_t *field = type->fields[i];
+        size_t field_size = ssz_type_fixed_size(field);
+        const uint8_t *start = buf + pos;
+        size_t size = field_size;
+        if (field_size == 0)
+        {
+            size_t begin = ssz_read_offset(buf + pos);
+            if ((!has_variable && begin != fixed_end) || begin < previous_offset || begin > len)
+            {
+                return SSZ_ERROR_INVALID_OFFSET;
+            }
+            size_t end = len;
+            size_t next_pos = pos + SSZ_BYTES_PER_LENGTH_OFFSET;
+            for (uint64_t j = i + 1; j < type->length; j++)
+            {
+                size_t next_size = ssz_type_fixed_size(type->fields[j]);
+                if (next_size == 0)
+                {
+                    end = ssz_read_offset(buf + next_pos);
+                    break;
+                }
+                next_pos += next_size;
+            }
+            if (end < begin || end > len)
+            {
+                return SSZ_ERROR_INVALID_OFFSET;
+            }
+            start = buf + begin;
+            size = end - begin;
+            previous_offset = begin;
+            has_variable = true;
+            field_size = SSZ_BYTES_PER_LENGTH_OFFSET;
+        }
+        err = ssz_hash_tree_root_serialized(field, start, size, roots + buffered * SSZ_BYTES_PER_CHUNK);
+        if (err != SSZ_SUCCESS)
+        {
+            return err;
+        }
+        if (++buffered == SSZ_SCHEMA_ROOT_BATCH)
+        {
+            err = ssz_merkleizer_push_chunks(&m, roots, buffered);
+            if (err != SSZ_SUCCESS)
+            {
+                return err;
+            }
+            buffered = 0;
+        }
+        pos += field_size;
+    }
+    err = ssz_merkleizer_push_chunks(&m, roots, buffered);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    if (!has_variable && len != fixed_end)
+    {
+        return SSZ_ERROR_DESERIALIZATION;
+    }
+    return ssz_merkleizer_finalize(&m, out_root);
+}
+
+/**
+ * Computes the hash tree root of a value directly from its serialized bytes.
+ *
+ * @param type Pointer to the type descriptor.
+ * @param buf Pointer to the serialized value.
+ * @param len Size of the serialized value in bytes.
+ * @param out_root Output buffer to write the resulting root (at least SSZ_BYTES_PER_CHUNK bytes).
+ * @return SSZ_SUCCESS on success, SSZ_ERROR_INVALID_OFFSET or SSZ_ERROR_DESERIALIZATION if the
+ *         encoding is malformed, or SSZ_ERROR_MERKLEIZATION if the descriptor is invalid.
+ */
+ssz_error_t ssz_hash_tree_root_serialized(const ssz_type_desc_t *type, const uint8_t *buf, size_t len, uint8_t *out_root)
+{
+    if (!type || !out_root || (len != 0 && !buf))
+    {
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+    switch (type->kind)
+    {
+    case SSZ_TYPE_UINT:
+    case SSZ_TYPE_BOOLEAN:
+    {
+        size_t size = ssz_type_fixed_size(type);
+        if (size == 0 || size > SSZ_BYTES_PER_CHUNK)
+        {
+            return SSZ_ERROR_MERKLEIZATION;
+        }
+        if (len != size || (type->kind == SSZ_TYPE_BOOLEAN && buf[0] > 1))
+        {
+            return SSZ_ERROR_DESERIALIZATION;
+        }
+        memset(out_root, 0, SSZ_BYTES_PER_CHUNK);
+        memcpy(out_root, buf, len);
+        return SSZ_SUCCESS;
+    }
+    case SSZ_TYPE_BITVECTOR:
+        if (type->length == 0)
+        {
+            return SSZ_ERROR_MERKLEIZATION;
+        }
+        if (len != ssz_type_fixed_size(type))
+        {
+            return SSZ_ERROR_DESERIALIZATION;
+        }
+        return ssz_hash_tree_root_bitvector(buf, (size_t)type->length, out_root);
+    case SSZ_TYPE_BITLIST:
+        if (len == 0)
+        {
+            return SSZ_ERROR_DESERIALIZATION;
+        }
+        return ssz_hash_tree_root_bitlist(buf, len, (size_t)type->length, out_root, NULL);
+    case SSZ_TYPE_VECTOR:
+    case SSZ_TYPE_LIST:
+    {
+        const ssz_type_desc_t *element = type->element;
+        bool is_list = type->kind == SSZ_TYPE_LIST;
+        if (!element || (!is_list && type->length == 0))
+        {
+            return SSZ_ERROR_MERKLEIZATION;
+        }
+        size_t count;
+        if (ssz_type_is_basic(element))
+        {
+            size_t element_size = ssz_type_fixed_size(element);
+            if (element_size == 0 || SSZ_BYTES_PER_CHUNK % element_size != 0)
+            {
+                return SSZ_ERROR_MERKLEIZATION;
+            }
+            count = len / element_size;
+            if (len % element_size != 0 || (is_list ? count > type->length : count != type->length) ||
+                (element->kind == SSZ_TYPE_BOOLEAN && !ssz_booleans_valid(buf, len)))
+            {
+                return SSZ_ERROR_DESERIALIZATION;
+            }
+            uint64_t per_chunk = SSZ_BYTES_PER_CHUNK / element_size;
+            uint64_t chunk_limit = type->length / per_chunk + (type->length % per_chunk != 0);
+            ssz_error_t err = ssz_merkleize_packed(buf, len, chunk_limit, out_root);
+            if (err != SSZ_SUCCESS)
+            {
+                return err;
+            }
+        }
+        else
+        {
+            ssz_error_t err = ssz_merkleize_elements(element, buf, len, type->length, out_root, &count);
+            if (err != SSZ_SUCCESS)
+            {
+                return err;
+            }
+            if (!is_list && count != type->length)
+            {
+                return SSZ_ERROR_DESERIALIZATION;
+            }
+        }
+        return is_list ? ssz_mix_in_length(out_root, count, out_root) : SSZ_SUCCESS;
+    }
+    case SSZ_TYPE_CONTAINER:
+        if (type->length == 0 || !type->fields)
+        {
+            return SSZ_ERROR_MERKLEIZATION;
+        }
+        return ssz_merkleize_container(type, buf, len, out_root);
+    default:
+        return SSZ_ERROR_MERKLEIZATION;
+    }
+}
@@ -3,10 +3,19 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <pthread.h>
 #include "ssz_serialize.h"
 #include "ssz_constants.h"
 #include "ssz_types.h"
+#include "ssz_inline.h"
 #include "ssz_utils.h"
+#include "ssz_bits.h"
+
+/* Upper bound on ssz_serialize_list_parallel workers; also sizes its on-stack job table. */
+#define SSZ_SERIALIZE_MAX_THREADS 64
+
+/* Smallest range worth a thread; below this the thread start-up cost dominates. */
+#define SSZ_SERIALIZE_MIN_ELEMENTS_PER_THREAD 4096
 
 /**
  * Serializes an 8-bit unsigned integer into a single byte.
@@ -43,8 +52,7 @@ ssz_error_t ssz_serialize_uint16(const void *value, uint8_t *out_buf, size_t *ou
     }
     uint16_t val;
     memcpy(&val, value, sizeof(val));
-    out_buf[0] = (uint8_t)(val);
-    out_buf[1] = (uint8_t)(val >> 8);
+    ssz_store_le16(out_buf, val);
     *out_size = SSZ_BYTE_SIZE_OF_UINT16;
     return SSZ_SUCCESS;
 }
@@ -65,10 +73,7 @@ ssz_error_t ssz_serialize_uint32(const void *value, uint8_t *out_buf, size_t *ou
     }
     uint32_t val;
     memcpy(&val, value, sizeof(val));
-    out_buf[0] = (uint8_t)(val);
-    out_buf[1] = (uint8_t)(val >> 8);
-    out_buf[2] = (uint8_t)(val >> 16);
-    out_buf[3] = (uint8_t)(val >> 24);
+    ssz_store_le32(out_buf, val);
     *out_size = SSZ_BYTE_SIZE_OF_UINT32;
     return SSZ_SUCCESS;
 }
@@ -87,15 +92,9 @@ ssz_error_t ssz_serialize_uint64(const void *value, uint8_t *out_buf, size_t *ou
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    uint64_t val = *(const uint64_t *)value;
-    out_buf[0] = (uint8_t)(val);
-    out_buf[1] = (uint8_t)(val >> 8);
-    out_buf[2] = (uint8_t)(val >> 16);
-    out_buf[3] = (uint8_t)(val >> 24);
-    out_buf[4] = (uint8_t)(val >> 32);
-    out_buf[5] = (uint8_t)(val >> 40);
-    out_buf[6] = (uint8_t)(val >> 48);
-    out_buf[7] = (uint8_t)(val >> 56);
+    uint64_t val;
+    memcpy(&val, value, sizeof(val));
+    ssz_store_le64(out_buf, val);
     *out_size = SSZ_BYTE_SIZE_OF_UINT64;
     return SSZ_SUCCESS;
 }
@@ -117,20 +116,7 @@ ssz_error_t ssz_serialize_uint128(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t *endian_check = (const uint8_t *)&test_value;
-    if (endian_check[0] == 0x01)
-    {
-        memcpy(out_buf, value, 16);
-    }
-    else
-    {
-        const uint8_t *src = (const uint8_t *)value;
-        for (size_t i = 0; i < 16; i++)
-        {
-            out_buf[i] = src[15 - i];
-        }
-    }
+    ssz_copy_le_bytes(out_buf, (const uint8_t *)value, 16);
     *out_size = SSZ_BYTE_SIZE_OF_UINT128;
     return SSZ_SUCCESS;
 }
@@ -152,20 +138,7 @@ ssz_error_t ssz_serialize_uint256(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
-    {
-        memcpy(out_buf, value, 32);
-    }
-    else
-    {
-        const uint8_t *src = (const uint8_t *)value;
-        for (size_t i = 0; i < 32; i++)
-        {
-            out_buf[i] = src[31 - i];
-        }
-    }
+    ssz_copy_le_bytes(out_buf, (const uint8_t *)value, 32);
     *out_size = SSZ_BYTE_SIZE_OF_UINT256;
     return SSZ_SUCCESS;
 }
@@ -210,27 +183,7 @@ ssz_error_t ssz_serialize_bitvector(const bool *restrict bits, size_t num_bits,
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    const size_t full_bytes = num_bits / 8;
-    const size_t remainder_bits = num_bits % 8;
-    const bool *bit_ptr = bits;
-    uint8_t *out_ptr = out_buf;
-    for (size_t i = 0; i < full_bytes; ++i)
-    {
-        *out_ptr++ = (uint8_t)((bit_ptr[0] << 0) | (bit_ptr[1] << 1) |
-                               (bit_ptr[2] << 2) | (bit_ptr[3] << 3) |
-                               (bit_ptr[4] << 4) | (bit_ptr[5] << 5) |
-                               (bit_ptr[6] << 6) | (bit_ptr[7] << 7));
-        bit_ptr += 8;
-    }
-    if (remainder_bits > 0)
-    {
-        uint8_t value = 0;
-        for (size_t bit = 0; bit < remainder_bits; ++bit)
-        {
-            value |= (*bit_ptr++) << bit;
-        }
-        *out_ptr = value;
-    }
+    ssz_bits_pack(bits, num_bits, out_buf);
     *out_size = byte_count;
     return SSZ_SUCCESS;
 }
@@ -257,39 +210,12 @@ ssz_error_t ssz_serialize_bitlist(const bool *bits, size_t num_bits, uint8_t *ou
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    const size_t delimiter_byte = num_bits / 8;
-    const size_t delimiter_bit = num_bits % 8;
-    const bool *bit_ptr = bits;
-    for (size_t j = 0; j < byte_count; j++)
+    if (num_bits % 8 == 0)
     {
-        uint8_t byte = 0;
-        const size_t start = j * 8;
-        if (start + 8 <= num_bits)
-        {
-            byte |= (uint8_t)(*bit_ptr++) << 0;
-            byte |= (uint8_t)(*bit_ptr++) << 1;
-            byte |= (uint8_t)(*bit_ptr++) << 2;
-            byte |= (uint8_t)(*bit_ptr++) << 3;
-            byte |= (uint8_t)(*bit_ptr++) << 4;
-            byte |= (uint8_t)(*bit_ptr++) << 5;
-            byte |= (uint8_t)(*bit_ptr++) << 6;
-            byte |= (uint8_t)(*bit_ptr++) << 7;
-        }
-        else
-        {
-            for (size_t k = 0; k < 8; k++)
-            {
-                if (start + k >= num_bits)
-                    break;
-                byte |= (uint8_t)(*bit_ptr++) << k;
-            }
-        }
-        if (j == delimiter_byte)
-        {
-            byte |= (1 << delimiter_bit);
-        }
-        out_buf[j] = byte;
+        out_buf[byte_count - 1] = 0;
     }
+    ssz_bits_pack(bits, num_bits, out_buf);
+    out_buf[byte_count - 1] |= (uint8_t)(1u << (num_bits % 8));
     *out_size = byte_count;
     return SSZ_SUCCESS;
 }
@@ -393,9 +319,7 @@ ssz_error_t ssz_serialize_vector_uint16(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -436,9 +360,7 @@ ssz_error_t ssz_serialize_vector_uint32(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -482,9 +404,7 @@ ssz_error_t ssz_serialize_vector_uint64(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -532,9 +452,7 @@ ssz_error_t ssz_serialize_vector_uint128(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -578,9 +496,7 @@ ssz_error_t ssz_serialize_vector_uint256(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -695,9 +611,7 @@ ssz_error_t ssz_serialize_list_uint16(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -743,9 +657,7 @@ ssz_error_t ssz_serialize_list_uint32(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -794,9 +706,7 @@ ssz_error_t ssz_serialize_list_uint64(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -849,9 +759,7 @@ ssz_error_t ssz_serialize_list_uint128(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -900,9 +808,7 @@ ssz_error_t ssz_serialize_list_uint256(
     {
         return SSZ_ERROR_SERIALIZATION;
     }
-    static const uint32_t test_value = 1;
-    const uint8_t endian_check = *(const uint8_t *)&test_value;
-    if (endian_check == 0x01)
+    if (SSZ_HOST_LITTLE_ENDIAN)
     {
         memcpy(out_buf, elements, total_bytes);
     }
@@ -957,4 +863,121 @@ ssz_error_t ssz_serialize_list_bool(
     }
     *out_size = total_bytes;
     return SSZ_SUCCESS;
-}
\ No newline at end of file
+}
+
+/**
+ * Describes one range of elements serialized by a worker of ssz_serialize_list_parallel.
+ */
+typedef struct
+{
+    const void *elements;
+    size_t element_count;
+    uint8_t *out_buf;
+    ssz_serialize_range_fn range_func;
+    ssz_error_t err;
+} ssz_serialize_job_t;
+
+static void *ssz_serialize_worker(void *arg)
+{
+    ssz_serialize_job_t *job = (ssz_serialize_job_t *)arg;
+    job->err = job->range_func(job->elements, job->element_count, job->out_buf);
+    return NULL;
+}
+
+/**
+ * Serializes a list of fixed-size elements using several threads.
+ *
+ * The elements are split into equal contiguous ranges, one per worker, and range j writes to
+ * out_buf + first_j * element_size, so the workers never share output bytes. The calling thread
+ * takes the first range. If a thread cannot be started its range is serialized on the calling
+ * thread instead.
+ *
+ * @param elements Pointer to the elements.
+ * @param element_count The number of elements in the list.
+ * @param element_stride Distance in bytes between consecutive elements in memory.
+ * @param element_size Serialized size of one element in bytes.
+ * @param range_func Function serializing a range of elements.
+ * @param thread_count Maximum number of threads to use, including the calling thread.
+ * @param out_buf Pointer to the output buffer to write the serialized data.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes written.
+ * @return SSZ_SUCCESS on success, or an error code on failure.
+ */
+ssz_error_t ssz_serialize_list_parallel(
+    const void *elements,
+    size_t element_count,
+    size_t element_stride,
+    size_t element_size,
+    ssz_serialize_range_fn range_func,
+    unsigned int thread_count,
+    uint8_t *out_buf,
+    size_t *out_size)
+{
+    if (range_func == NULL || out_size == NULL || (element_count != 0 && (elements == NULL || out_buf == NULL)))
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    if (element_size != 0 && element_count > SIZE_MAX / element_size)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t total = element_count * element_size;
+    if (*out_size < total)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    if (thread_count > SSZ_SERIALIZE_MAX_THREADS)
+    {
+        thread_count = SSZ_SERIALIZE_MAX_THREADS;
+    }
+    if (thread_count <= 1 || element_count < 2 * SSZ_SERIALIZE_MIN_ELEMENTS_PER_THREAD)
+    {
+        ssz_error_t err = element_count != 0 ? range_func(elements, element_count, out_buf) : SSZ_SUCCESS;
+        if (err == SSZ_SUCCESS)
+        {
+            *out_size = total;
+        }
+        return err;
+    }
+    size_t per_job = (element_count + thread_count - 1) / thread_count;
+    if (per_job < SSZ_SERIALIZE_MIN_ELEMENTS_PER_THREAD)
+    {
+        per_job = SSZ_SERIALIZE_MIN_ELEMENTS_PER_THREAD;
+    }
+    size_t job_count = (element_count + per_job - 1) / per_job;
+
+    ssz_serialize_job_t jobs[SSZ_SERIALIZE_MAX_THREADS];
+    pthread_t threads[SSZ_SERIALIZE_MAX_THREADS];
+    bool started[SSZ_SERIALIZE_MAX_THREADS];
+    for (size_t j = 0; j < job_count; j++)
+    {
+        size_t first = j * per_job;
+        jobs[j].elements = (const uint8_t *)elements + first * element_stride;
+        jobs[j].element_count = element_count - first < per_job ? element_count - first : per_job;
+        jobs[j].out_buf = out_buf + first * element_size;
+        jobs[j].range_func = range_func;
+        jobs[j].err = SSZ_SUCCESS;
+        started[j] = j != 0 && pthread_create(&threads[j], NULL, ssz_serialize_worker, &jobs[j]) == 0;
+    }
+    ssz_error_t err = SSZ_SUCCESS;
+    for (size_t j = 0; j < job_count; j++)
+    {
+        if (started[j])
+        {
+            pthread_join(threads[j], NULL);
+        }
+        else
+        {
+            ssz_serialize_worker(&jobs[j]);
+        }
+        if (jobs[j].err != SSZ_SUCCESS)
+        {
+            err = jobs[j].err;
+        }
+    }
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    *out_size = total;
+    return SSZ_SUCCESS;
+}
@@ -48,6 +48,22 @@ uint64_t next_pow_of_two(uint64_t value)
     return p;
 }
 
+/**
+ * Computes the base-2 logarithm of the next power of two for the given value.
+ *
+ * @param value The input value.
+ * @return The smallest d such that 2^d >= value, or 0 if value is zero or one.
+ */
+unsigned int ceil_log2(uint64_t value)
+{
+    unsigned int depth = 0;
+    while (depth < 64 && (1ULL << depth) < value)
+    {
+        depth++;
+    }
+    return depth;
+}
+
 /**
  * Validates whether the provided offset is within the maximum allowed SSZ offset range.
  *
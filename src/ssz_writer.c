@@ -0,0 +1,613 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ssz_writer.h"
+#ifndef _WIN32
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+/** Bytes reserved for the header of an arena block, keeping block data 16-byte aligned. */
+#define SSZ_ARENA_HEADER_SIZE ((sizeof(ssz_arena_block_t) + 15) & ~(size_t)15)
+
+/** Capacity of a growable writer when none is given. */
+#define SSZ_WRITER_DEFAULT_CAPACITY 256
+
+/** Chunk capacity of a chunked writer when none is given. */
+#define SSZ_WRITER_DEFAULT_CHUNK_SIZE 65536
+
+static uint8_t *ssz_arena_block_data(ssz_arena_block_t *block)
+{
+    return (uint8_t *)block + SSZ_ARENA_HEADER_SIZE;
+}
+
+/**
+ * Initializes an empty arena. No memory is allocated until the first allocation.
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param block_size Minimum capacity of each block; larger requests get a block of their own size.
+ */
+void ssz_arena_init(ssz_arena_t *arena, size_t block_size)
+{
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size;
+    arena->block_count = 0;
+}
+
+/**
+ * Allocates memory from an arena, aligned to 16 bytes.
+ *
+ * Blocks after the current one are unused since the last reset, so they are tried in order before
+ * a new block is appended to the list.
+ *
+ * @param arena Pointer to the arena.
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the memory, or NULL if a new block could not be allocated.
+ */
+void *ssz_arena_alloc(ssz_arena_t *arena, size_t size)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    ssz_arena_block_t *last = NULL;
+    for (ssz_arena_block_t *block = arena->current; block != NULL; block = block->next)
+    {
+        size_t start = (block->used + 15) & ~(size_t)15;
+        if (start <= block->capacity && block->capacity - start >= size)
+        {
+            block->used = start + size;
+            arena->current = block;
+            return ssz_arena_block_data(block) + start;
+        }
+        last = block;
+    }
+
+    size_t capacity = size > arena->block_size ? size : arena->block_size;
+    if (capacity > SIZE_MAX - SSZ_ARENA_HEADER_SIZE)
+    {
+        return NULL;
+    }
+    ssz_arena_block_t *block = malloc(SSZ_ARENA_HEADER_SIZE + capacity);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = size;
+    if (last != NULL)
+    {
+        last->next = block;
+    }
+    else
+    {
+        arena->head = block;
+    }
+    arena->current = block;
+    arena->block_count++;
+    return ssz_arena_block_data(block);
+}
+
+/**
+ * Grows an allocation of an arena.
+ *
+ * If ptr is the most recent allocation and its block has room, the allocation is extended in
+ * place; otherwise a new allocation is made and the old_size bytes are copied to it. The old
+ * memory is not reused until the next reset.
+ *
+ * @param arena Pointer to the arena.
+ * @param ptr Pointer returned by ssz_arena_alloc or ssz_arena_grow, or NULL.
+ * @param old_size Current size of the allocation.
+ * @param new_size Requested size, at least old_size.
+ * @return Pointer to the grown allocation, or NULL if a new block could not be allocated.
+ */
+void *ssz_arena_grow(ssz_arena_t *arena, void *ptr, size_t old_size, size_t new_size)
+{
+    if (ptr == NULL)
+    {
+        return ssz_arena_alloc(arena, new_size);
+    }
+    ssz_arena_block_t *block = arena->current;
+    if (block != NULL && old_size <= block->used &&
+        (uint8_t *)ptr + old_size == ssz_arena_block_data(block) + block->used)
+    {
+        size_t start = block->used - old_size;
+        if (block->capacity - start >= new_size)
+        {
+            block->used = start + new_size;
+            return ptr;
+        }
+    }
+    void *grown = ssz_arena_alloc(arena, new_size);
+    if (grown != NULL)
+    {
+        memcpy(grown, ptr, old_size);
+    }
+    return grown;
+}
+
+/**
+ * Releases every allocation at once while keeping the blocks for reuse.
+ *
+ * @param arena Pointer to the arena.
+ */
+void ssz_arena_reset(ssz_arena_t *arena)
+{
+    for (ssz_arena_block_t *block = arena->head; block != NULL; block = block->next)
+    {
+        block->used = 0;
+    }
+    arena->current = arena->head;
+}
+
+/**
+ * Frees every block of an arena.
+ *
+ * @param arena Pointer to the arena.
+ */
+void ssz_arena_free(ssz_arena_t *arena)
+{
+    ssz_arena_block_t *block = arena->head;
+    while (block != NULL)
+    {
+        ssz_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_count = 0;
+}
+
+/**
+ * Allocates a chunk of at least min_capacity bytes for a chunked writer.
+ *
+ * @param writer Pointer to the writer.
+ * @param min_capacity Number of bytes the chunk must hold.
+ * @return Pointer to the chunk, or NULL on allocation failure.
+ */
+static ssz_writer_chunk_t *ssz_writer_new_chunk(ssz_writer_t *writer, size_t min_capacity)
+{
+    size_t capacity = min_capacity > writer->chunk_size ? min_capacity : writer->chunk_size;
+    if (capacity > SIZE_MAX - sizeof(ssz_writer_chunk_t))
+    {
+        return NULL;
+    }
+    ssz_writer_chunk_t *chunk = ssz_arena_alloc(writer->arena, sizeof(ssz_writer_chunk_t) + capacity);
+    if (chunk == NULL)
+    {
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->data = (uint8_t *)(chunk + 1);
+    chunk->length = 0;
+    chunk->capacity = capacity;
+    return chunk;
+}
+
+/**
+ * Initializes a writer over a caller-provided buffer.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param buf Output buffer.
+ * @param capacity Size of the output buffer in bytes.
+ */
+void ssz_writer_init_fixed(ssz_writer_t *writer, uint8_t *buf, size_t capacity)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->kind = SSZ_WRITER_FIXED;
+    writer->buf = buf;
+    writer->capacity = buf != NULL ? capacity : 0;
+}
+
+/**
+ * Initializes a writer whose output is one contiguous buffer allocated from an arena.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param arena Arena providing the buffer.
+ * @param initial_capacity Initial buffer size in bytes; 0 selects a small default.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_writer_init_growable(ssz_writer_t *writer, ssz_arena_t *arena, size_t initial_capacity)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->kind = SSZ_WRITER_GROWABLE;
+    writer->arena = arena;
+    size_t capacity = initial_capacity != 0 ? initial_capacity : SSZ_WRITER_DEFAULT_CAPACITY;
+    writer->buf = ssz_arena_alloc(arena, capacity);
+    if (writer->buf == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    writer->capacity = capacity;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Initializes a writer whose output is a list of chunks allocated from an arena.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param arena Arena providing the chunks.
+ * @param chunk_size Minimum capacity of each chunk; 0 selects a default.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on allocation failure.
+ */
+ssz_error_t ssz_writer_init_chunked(ssz_writer_t *writer, ssz_arena_t *arena, size_t chunk_size)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->kind = SSZ_WRITER_CHUNKED;
+    writer->arena = arena;
+    writer->chunk_size = chunk_size != 0 ? chunk_size : SSZ_WRITER_DEFAULT_CHUNK_SIZE;
+    ssz_writer_chunk_t *chunk = ssz_writer_new_chunk(writer, 0);
+    if (chunk == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    writer->head = chunk;
+    writer->tail = chunk;
+    writer->buf = chunk->data;
+    writer->capacity = chunk->capacity;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Initializes a writer that streams its output through a callback.
+ *
+ * @param writer Pointer to the writer to initialize.
+ * @param buf Buffer collecting the output; it must hold the largest single reservation.
+ * @param capacity Size of the buffer in bytes.
+ * @param write Callback receiving the output.
+ * @param ctx Context pointer passed to the callback.
+ */
+void ssz_writer_init_stream(ssz_writer_t *writer, uint8_t *buf, size_t capacity, ssz_write_fn write, void *ctx)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->kind = SSZ_WRITER_STREAM;
+    writer->buf = buf;
+    writer->capacity = buf != NULL ? capacity : 0;
+    writer->write = write;
+    writer->ctx = ctx;
+}
+
+/**
+ * Passes the bytes buffered by a stream writer to its callback. Other writers keep all of their
+ * output, so this does nothing for them.
+ *
+ * @param writer Pointer to the writer.
+ * @return SSZ_SUCCESS on success, or the error returned by the callback.
+ */
+ssz_error_t ssz_writer_flush(ssz_writer_t *writer)
+{
+    if (writer->kind != SSZ_WRITER_STREAM || writer->length == 0)
+    {
+        return SSZ_SUCCESS;
+    }
+    ssz_error_t err = writer->write(writer->ctx, writer->buf, writer->length);
+    if (err != SSZ_SUCCESS)
+    {
+        return err;
+    }
+    writer->flushed += writer->length;
+    writer->length = 0;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Returns a pointer to size contiguous bytes at the write position, growing the output if
+ * needed. The bytes become part of the output only after ssz_writer_advance.
+ *
+ * A growable writer doubles its buffer, in place when it is the last arena allocation. A chunked
+ * writer closes the current chunk and starts one large enough for the request. A stream writer
+ * flushes its buffer to make room.
+ *
+ * @param writer Pointer to the writer.
+ * @param size Number of bytes needed.
+ * @return Pointer to the bytes, or NULL if a fixed writer is full, a stream writer's buffer is
+ *         smaller than size or its callback failed, or allocation failed.
+ */
+uint8_t *ssz_writer_reserve(ssz_writer_t *writer, size_t size)
+{
+    if (writer->capacity - writer->length >= size)
+    {
+        return writer->buf + writer->length;
+    }
+    switch (writer->kind)
+    {
+    case SSZ_WRITER_GROWABLE:
+    {
+        if (size > SIZE_MAX / 2 - writer->length)
+        {
+            return NULL;
+        }
+        size_t capacity = writer->capacity != 0 ? writer->capacity : SSZ_WRITER_DEFAULT_CAPACITY;
+        while (capacity < writer->length + size)
+        {
+            capacity *= 2;
+        }
+        uint8_t *grown = ssz_arena_grow(writer->arena, writer->buf, writer->capacity, capacity);
+        if (grown == NULL)
+        {
+            return NULL;
+        }
+        writer->buf = grown;
+        writer->capacity = capacity;
+        return writer->buf + writer->length;
+    }
+    case SSZ_WRITER_CHUNKED:
+    {
+        ssz_writer_chunk_t *chunk = ssz_writer_new_chunk(writer, size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        writer->tail->length = writer->length;
+        writer->tail->next = chunk;
+        writer->tail = chunk;
+        writer->flushed += writer->length;
+        writer->buf = chunk->data;
+        writer->length = 0;
+        writer->capacity = chunk->capacity;
+        return writer->buf;
+    }
+    case SSZ_WRITER_STREAM:
+        if (size > writer->capacity || ssz_writer_flush(writer) != SSZ_SUCCESS)
+        {
+            return NULL;
+        }
+        return writer->buf;
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * Appends bytes to the output. A chunked or stream writer may split them across chunks.
+ *
+ * @param writer Pointer to the writer.
+ * @param data Bytes to append.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the writer is full.
+ */
+ssz_error_t ssz_writer_write(ssz_writer_t *writer, const uint8_t *data, size_t size)
+{
+    if (writer->kind == SSZ_WRITER_STREAM)
+    {
+        while (size > writer->capacity - writer->length)
+        {
+            size_t head = writer->capacity - writer->length;
+            memcpy(writer->buf + writer->length, data, head);
+            writer->length += head;
+            data += head;
+            size -= head;
+            if (writer->capacity == 0 || ssz_writer_flush(writer) != SSZ_SUCCESS)
+            {
+                return SSZ_ERROR_SERIALIZATION;
+            }
+        }
+    }
+    else if (writer->kind == SSZ_WRITER_CHUNKED && size > writer->capacity - writer->length)
+    {
+        size_t head = writer->capacity - writer->length;
+        memcpy(writer->buf + writer->length, data, head);
+        writer->length += head;
+        data += head;
+        size -= head;
+    }
+    uint8_t *p = ssz_writer_reserve(writer, size);
+    if (p == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    memcpy(p, data, size);
+    ssz_writer_advance(writer, size);
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Appends an array of unsigned integers in little-endian order.
+ *
+ * On little-endian hosts, and always for one-byte values, the array is written as is; otherwise
+ * each value is byte-swapped into the output.
+ *
+ * @param writer Pointer to the writer.
+ * @param values Pointer to count values of value_size bytes each.
+ * @param count Number of values.
+ * @param value_size Size of one value in bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the writer is full.
+ */
+ssz_error_t ssz_writer_append_le(ssz_writer_t *writer, const void *values, size_t count, size_t value_size)
+{
+    if (value_size != 0 && count > SIZE_MAX / value_size)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    if (SSZ_HOST_LITTLE_ENDIAN || value_size == 1)
+    {
+        return ssz_writer_write(writer, (const uint8_t *)values, count * value_size);
+    }
+    const uint8_t *src = (const uint8_t *)values;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint8_t *out = ssz_writer_reserve(writer, value_size);
+        if (out == NULL)
+        {
+            return SSZ_ERROR_SERIALIZATION;
+        }
+        ssz_copy_le_bytes(out, src + i * value_size, value_size);
+        ssz_writer_advance(writer, value_size);
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Overwrites bytes already written, e.g. an offset whose value was not known when it was
+ * written.
+ *
+ * @param writer Pointer to the writer.
+ * @param position Position of the first byte from the start of the output.
+ * @param data Replacement bytes.
+ * @param size Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_OUT_OF_RANGE if the range was not written yet or,
+ *         for a stream writer, was already passed to the callback.
+ */
+ssz_error_t ssz_writer_patch(ssz_writer_t *writer, size_t position, const uint8_t *data, size_t size)
+{
+    size_t total = ssz_writer_size(writer);
+    if (position > total || size > total - position)
+    {
+        return SSZ_ERROR_OUT_OF_RANGE;
+    }
+    if (writer->kind != SSZ_WRITER_CHUNKED)
+    {
+        if (position < writer->flushed)
+        {
+            return SSZ_ERROR_OUT_OF_RANGE;
+        }
+        memcpy(writer->buf + (position - writer->flushed), data, size);
+        return SSZ_SUCCESS;
+    }
+    for (ssz_writer_chunk_t *chunk = writer->head; chunk != NULL && size > 0; chunk = chunk->next)
+    {
+        size_t length = chunk == writer->tail ? writer->length : chunk->length;
+        if (position >= length)
+        {
+            position -= length;
+            continue;
+        }
+        size_t n = length - position < size ? length - position : size;
+        memcpy(chunk->data + position, data, n);
+        data += n;
+        size -= n;
+        position = 0;
+    }
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Returns the output of a fixed or growable writer, of a chunked writer with one chunk, or of a
+ * stream writer that has not flushed yet.
+ *
+ * @param writer Pointer to the writer.
+ * @return Pointer to the contiguous output, or NULL if it spans several chunks.
+ */
+const uint8_t *ssz_writer_data(const ssz_writer_t *writer)
+{
+    if ((writer->kind == SSZ_WRITER_CHUNKED && writer->head != writer->tail) || writer->flushed != 0)
+    {
+        return NULL;
+    }
+    return writer->buf;
+}
+
+/**
+ * Copies the output of any writer into a contiguous buffer.
+ *
+ * @param writer Pointer to the writer.
+ * @param out_buf Output buffer of at least ssz_writer_size bytes.
+ * @param out_size Pointer to the size of the output buffer. Updated with the number of bytes copied.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if the buffer is too small or a
+ *         stream writer has already flushed part of its output.
+ */
+ssz_error_t ssz_writer_copy(const ssz_writer_t *writer, uint8_t *out_buf, size_t *out_size)
+{
+    size_t total = ssz_writer_size(writer);
+    if (out_buf == NULL || out_size == NULL || *out_size < total ||
+        (writer->kind == SSZ_WRITER_STREAM && writer->flushed != 0))
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    if (writer->kind != SSZ_WRITER_CHUNKED)
+    {
+        memcpy(out_buf, writer->buf, total);
+    }
+    else
+    {
+        size_t offset = 0;
+        for (const ssz_writer_chunk_t *chunk = writer->head; chunk != NULL; chunk = chunk->next)
+        {
+            size_t length = chunk == writer->tail ? writer->length : chunk->length;
+            memcpy(out_buf + offset, chunk->data, length);
+            offset += length;
+        }
+    }
+    *out_size = total;
+    return SSZ_SUCCESS;
+}
+
+/**
+ * Discards the output so the writer can be reused. A growable writer keeps its buffer; a chunked
+ * writer keeps its first chunk. Arena memory is reclaimed by ssz_arena_reset.
+ *
+ * @param writer Pointer to the writer.
+ */
+void ssz_writer_reset(ssz_writer_t *writer)
+{
+    if (writer->kind == SSZ_WRITER_CHUNKED && writer->head != NULL)
+    {
+        writer->head->next = NULL;
+        writer->tail = writer->head;
+        writer->buf = writer->head->data;
+        writer->capacity = writer->head->capacity;
+    }
+    writer->length = 0;
+    writer->flushed = 0;
+}
+
+/**
+ * Runs a serializer with the out_buf/out_size interface directly into a writer.
+ *
+ * @param writer Pointer to the writer.
+ * @param size Maximum number of bytes the serializer writes, e.g. from ssz_size_<Type>.
+ * @param ser_func Serializer taking (value, out_buf, out_size).
+ * @param value Value passed to the serializer.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION on failure.
+ */
+ssz_error_t ssz_writer_serialize(
+    ssz_writer_t *writer,
+    size_t size,
+    ssz_error_t (*ser_func)(const void *, uint8_t *, size_t *),
+    const void *value)
+{
+    uint8_t *out_buf = ssz_writer_reserve(writer, size);
+    if (out_buf == NULL)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    size_t written = size;
+    if (ser_func(value, out_buf, &written) != SSZ_SUCCESS || written > size)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    ssz_writer_advance(writer, written);
+    return SSZ_SUCCESS;
+}
+
+#ifndef _WIN32
+/**
+ * Stream writer callback that writes to a file descriptor, retrying partial writes and EINTR.
+ *
+ * @param ctx Pointer to the int file descriptor.
+ * @param bytes Bytes to write.
+ * @param len Number of bytes.
+ * @return SSZ_SUCCESS on success, or SSZ_ERROR_SERIALIZATION if a write fails.
+ */
+ssz_error_t ssz_write_fd(void *ctx, const uint8_t *bytes, size_t len)
+{
+    int fd = *(const int *)ctx;
+    while (len > 0)
+    {
+        ssize_t written = write(fd, bytes, len);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return SSZ_ERROR_SERIALIZATION;
+        }
+        bytes += written;
+        len -= (size_t)written;
+    }
+    return SSZ_SUCCESS;
+}
+#endif
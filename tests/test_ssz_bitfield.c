@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_bitfield.h"
+#include "ssz_serialize.h"
+#include "ssz_deserialize.h"
+#include "ssz_merkle.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+#define MAX_BITS 2048
+
+static const size_t lengths[] = {0, 1, 7, 8, 9, 63, 64, 65, 255, 256, 257, 511, 1000, 2048};
+
+static void fill_bits(bool *bits, ssz_bitfield_t *bf, size_t length, uint32_t seed)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        bits[i] = (seed >> 16) & 1;
+        ssz_bitfield_set(bf, i, bits[i]);
+    }
+}
+
+static void test_bitfield_list(void)
+{
+    printf("\n--- Testing ssz_bitfield_t as a bitlist ---\n");
+    bool bits[MAX_BITS];
+
+    printf("Testing serialize, deserialize and hash_tree_root against the bool-array functions...\n");
+    {
+        bool ok = true;
+        for (size_t t = 0; t < sizeof(lengths) / sizeof(lengths[0]) && ok; t++)
+        {
+            size_t length = lengths[t];
+            ssz_bitfield_t bf;
+            ssz_bitfield_t back;
+            ok = ssz_bitfield_init(&bf, length) == SSZ_SUCCESS;
+            if (!ok)
+            {
+                break;
+            }
+            fill_bits(bits, &bf, length, (uint32_t)length);
+
+            uint8_t expected[MAX_BITS / 8 + 1];
+            uint8_t actual[MAX_BITS / 8 + 1];
+            size_t expected_size = sizeof(expected);
+            size_t actual_size = sizeof(actual);
+            ok = ssz_serialize_bitlist(bits, length, expected, &expected_size) == SSZ_SUCCESS &&
+                 ssz_serialize_bitfield_list(&bf, actual, &actual_size) == SSZ_SUCCESS &&
+                 actual_size == expected_size && memcmp(actual, expected, actual_size) == 0;
+
+            uint8_t expected_root[SSZ_BYTES_PER_CHUNK];
+            uint8_t actual_root[SSZ_BYTES_PER_CHUNK];
+            ok = ok && ssz_hash_tree_root_bitlist(expected, expected_size, MAX_BITS, expected_root, NULL) == SSZ_SUCCESS &&
+                 ssz_hash_tree_root_bitfield_list(&bf, MAX_BITS, actual_root) == SSZ_SUCCESS &&
+                 memcmp(actual_root, expected_root, SSZ_BYTES_PER_CHUNK) == 0;
+
+            ok = ok && ssz_deserialize_bitfield_list(expected, expected_size, MAX_BITS, &back) == SSZ_SUCCESS;
+            if (ok)
+            {
+                ok = back.length == length &&
+                     (length == 0 || memcmp(back.words, bf.words, SSZ_BITFIELD_WORDS(length) * sizeof(uint64_t)) == 0);
+                ssz_bitfield_free(&back);
+            }
+            if (!ok)
+            {
+                printf("  FAIL: Mismatch for a bitlist of %zu bits.\n", length);
+            }
+            ssz_bitfield_free(&bf);
+        }
+        if (ok)
+        {
+            printf("  OK: Bitlists of every length match.\n");
+        }
+    }
+
+    printf("Testing missing delimiter, too many bits and a short buffer => should fail...\n");
+    {
+        uint8_t no_delimiter[2] = {0xFF, 0x00};
+        uint8_t too_long[3] = {0xFF, 0xFF, 0x01};
+        ssz_bitfield_t bf;
+        bool ok = ssz_deserialize_bitfield_list(no_delimiter, sizeof(no_delimiter), MAX_BITS, &bf) == SSZ_ERROR_DESERIALIZATION &&
+                  ssz_deserialize_bitfield_list(too_long, sizeof(too_long), 15, &bf) == SSZ_ERROR_DESERIALIZATION;
+        if (ok && ssz_bitfield_init(&bf, 16) == SSZ_SUCCESS)
+        {
+            uint8_t out[2];
+            size_t out_size = sizeof(out);
+            uint8_t root[SSZ_BYTES_PER_CHUNK];
+            ok = ssz_serialize_bitfield_list(&bf, out, &out_size) == SSZ_ERROR_SERIALIZATION &&
+                 ssz_hash_tree_root_bitfield_list(&bf, 15, root) == SSZ_ERROR_MERKLEIZATION;
+            ssz_bitfield_free(&bf);
+        }
+        if (ok)
+        {
+            printf("  OK: Invalid bitlists rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: An invalid bitlist was accepted.\n");
+        }
+    }
+}
+
+static void test_bitfield_vector(void)
+{
+    printf("\n--- Testing ssz_bitfield_t as a bitvector ---\n");
+    bool bits[MAX_BITS];
+
+    printf("Testing serialize, deserialize and hash_tree_root against the bool-array functions...\n");
+    {
+        bool ok = true;
+        for (size_t t = 1; t < sizeof(lengths) / sizeof(lengths[0]) && ok; t++)
+        {
+            size_t length = lengths[t];
+            ssz_bitfield_t bf;
+            ssz_bitfield_t back;
+            ok = ssz_bitfield_init(&bf, length) == SSZ_SUCCESS;
+            if (!ok)
+            {
+                break;
+            }
+            fill_bits(bits, &bf, length, (uint32_t)length * 7);
+
+            uint8_t expected[MAX_BITS / 8];
+            uint8_t actual[MAX_BITS / 8];
+            size_t expected_size = sizeof(expected);
+            size_t actual_size = sizeof(actual);
+            ok = ssz_serialize_bitvector(bits, length, expected, &expected_size) == SSZ_SUCCESS &&
+                 ssz_serialize_bitfield_vector(&bf, actual, &actual_size) == SSZ_SUCCESS &&
+                 actual_size == expected_size && memcmp(actual, expected, actual_size) == 0;
+
+            uint8_t expected_root[SSZ_BYTES_PER_CHUNK];
+            uint8_t actual_root[SSZ_BYTES_PER_CHUNK];
+            ok = ok && ssz_hash_tree_root_bitvector(expected, length, expected_root) == SSZ_SUCCESS &&
+                 ssz_hash_tree_root_bitfield_vector(&bf, actual_root) == SSZ_SUCCESS &&
+                 memcmp(actual_root, expected_root, SSZ_BYTES_PER_CHUNK) == 0;
+
+            ok = ok && ssz_deserialize_bitfield_vector(expected, expected_size, length, &back) == SSZ_SUCCESS;
+            if (ok)
+            {
+                ok = back.length == length &&
+                     memcmp(back.words, bf.words, SSZ_BITFIELD_WORDS(length) * sizeof(uint64_t)) == 0;
+                ssz_bitfield_free(&back);
+            }
+            if (!ok)
+            {
+                printf("  FAIL: Mismatch for a bitvector of %zu bits.\n", length);
+            }
+            ssz_bitfield_free(&bf);
+        }
+        if (ok)
+        {
+            printf("  OK: Bitvectors of every length match.\n");
+        }
+    }
+
+    printf("Testing set padding bits and a wrong size => should fail...\n");
+    {
+        uint8_t padded[1] = {0x10};
+        ssz_bitfield_t bf;
+        bool ok = ssz_deserialize_bitfield_vector(padded, sizeof(padded), 4, &bf) == SSZ_ERROR_DESERIALIZATION &&
+                  ssz_deserialize_bitfield_vector(padded, sizeof(padded), 9, &bf) == SSZ_ERROR_DESERIALIZATION;
+        if (ok)
+        {
+            printf("  OK: Invalid bitvectors rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: An invalid bitvector was accepted.\n");
+        }
+    }
+}
+
+int main(void)
+{
+    test_bitfield_list();
+    test_bitfield_vector();
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_bits.h"
+#include "ssz_types.h"
+
+#define MAX_BITS 1100
+
+static void reference_pack(const bool *bits, size_t num_bits, uint8_t *out_bytes)
+{
+    memset(out_bytes, 0, (num_bits + 7) / 8);
+    for (size_t i = 0; i < num_bits; i++)
+    {
+        out_bytes[i / 8] |= (uint8_t)(bits[i] << (i % 8));
+    }
+}
+
+static void test_bits_backends(void)
+{
+    printf("\n--- Testing ssz_bits_pack / ssz_bits_unpack backends ---\n");
+    static bool bits[MAX_BITS];
+    static bool unpacked[MAX_BITS + 1];
+    static uint8_t expected[MAX_BITS / 8 + 2];
+    static uint8_t packed[MAX_BITS / 8 + 2];
+    uint32_t seed = 1;
+    for (size_t i = 0; i < MAX_BITS; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        bits[i] = (seed >> 16) & 1;
+    }
+
+    ssz_bits_backend_t selected = ssz_bits_get_backend();
+    for (int b = 0; b < SSZ_BITS_BACKEND_COUNT; b++)
+    {
+        if (ssz_bits_set_backend((ssz_bits_backend_t)b) != SSZ_SUCCESS)
+        {
+            printf("Skipping backend %s (not available)\n", ssz_bits_backend_name((ssz_bits_backend_t)b));
+            continue;
+        }
+        printf("Testing backend %s against a bit-by-bit reference for lengths 0..%d...\n",
+               ssz_bits_backend_name((ssz_bits_backend_t)b), MAX_BITS);
+        bool ok = true;
+        for (size_t n = 0; n <= MAX_BITS && ok; n++)
+        {
+            size_t byte_count = (n + 7) / 8;
+            reference_pack(bits, n, expected);
+            memset(packed, 0xAA, sizeof(packed));
+            ssz_bits_pack(bits, n, packed);
+            ok = memcmp(packed, expected, byte_count) == 0 && packed[byte_count] == 0xAA;
+
+            memset(unpacked, 0xAA, sizeof(unpacked));
+            expected[byte_count] = 0xFF;
+            ssz_bits_unpack(expected, n, unpacked);
+            ok = ok && memcmp(unpacked, bits, n * sizeof(bool)) == 0 && ((uint8_t *)unpacked)[n] == 0xAA;
+            if (!ok)
+            {
+                printf("  FAIL: Mismatch for %zu bits.\n", n);
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Packed and unpacked bits match.\n");
+        }
+    }
+    ssz_bits_set_backend(selected);
+
+    printf("Testing unavailable backend => should fail...\n");
+    if (ssz_bits_set_backend(SSZ_BITS_BACKEND_COUNT) == SSZ_ERROR_OUT_OF_RANGE && ssz_bits_get_backend() == selected)
+    {
+        printf("  OK: Invalid backend rejected.\n");
+    }
+    else
+    {
+        printf("  FAIL: Invalid backend accepted.\n");
+    }
+}
+
+static size_t make_bitlist(uint8_t *out, size_t num_bits, uint32_t seed, unsigned int density)
+{
+    bool bits[MAX_BITS];
+    for (size_t i = 0; i < num_bits; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        bits[i] = ((seed >> 16) % 16) < density;
+    }
+    size_t byte_count = num_bits / 8 + 1;
+    memset(out, 0, byte_count);
+    reference_pack(bits, num_bits, out);
+    out[num_bits / 8] |= (uint8_t)(1u << (num_bits % 8));
+    return byte_count;
+}
+
+static void test_bitlist_ops(void)
+{
+    printf("\n--- Testing ssz_bitlist_union / _intersects / _is_subset / _popcount ---\n");
+    static const size_t lengths[] = {0, 1, 7, 8, 9, 63, 64, 100, 127, 128, 129, 255, 256, 300, 1000, 1024};
+    ssz_bits_backend_t selected = ssz_bits_get_backend();
+    for (int backend = 0; backend < SSZ_BITS_BACKEND_COUNT; backend++)
+    {
+        if (ssz_bits_set_backend((ssz_bits_backend_t)backend) != SSZ_SUCCESS)
+        {
+            continue;
+        }
+        printf("Testing backend %s against bool-array results...\n", ssz_bits_backend_name((ssz_bits_backend_t)backend));
+        bool ok = true;
+        for (size_t t = 0; t < sizeof(lengths) / sizeof(lengths[0]) && ok; t++)
+        {
+            size_t n = lengths[t];
+            for (unsigned int density = 0; density <= 16 && ok; density += 4)
+            {
+                uint8_t a[MAX_BITS / 8 + 1];
+                uint8_t b[MAX_BITS / 8 + 1];
+                uint8_t u[MAX_BITS / 8 + 1];
+                size_t byte_count = make_bitlist(a, n, (uint32_t)(n + density), density);
+                make_bitlist(b, n, (uint32_t)(n * 3 + density + 1), density / 2);
+                bool overlap = false;
+                bool subset = true;
+                size_t count = 0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    bool bit_a = (a[i / 8] >> (i % 8)) & 1;
+                    bool bit_b = (b[i / 8] >> (i % 8)) & 1;
+                    overlap = overlap || (bit_a && bit_b);
+                    subset = subset && (!bit_a || bit_b);
+                    count += bit_a;
+                }
+                bool got_overlap, got_subset, got_superset;
+                size_t got_count, union_count;
+                ok = ssz_bitlist_union(a, b, byte_count, u) == SSZ_SUCCESS &&
+                     ssz_bitlist_intersects(a, b, byte_count, &got_overlap) == SSZ_SUCCESS &&
+                     ssz_bitlist_is_subset(a, b, byte_count, &got_subset) == SSZ_SUCCESS &&
+                     ssz_bitlist_is_subset(a, u, byte_count, &got_superset) == SSZ_SUCCESS &&
+                     ssz_bitlist_popcount(a, byte_count, &got_count) == SSZ_SUCCESS &&
+                     ssz_bitlist_popcount(u, byte_count, &union_count) == SSZ_SUCCESS;
+                for (size_t i = 0; i < byte_count && ok; i++)
+                {
+                    ok = u[i] == (a[i] | b[i]);
+                }
+                uint8_t in_place[MAX_BITS / 8 + 1];
+                memcpy(in_place, b, byte_count);
+                ok = ok && ssz_bitlist_union(a, in_place, byte_count, in_place) == SSZ_SUCCESS &&
+                     memcmp(in_place, u, byte_count) == 0;
+                ok = ok && got_overlap == overlap && got_subset == subset && got_superset &&
+                     got_count == count && union_count >= count;
+                if (!ok)
+                {
+                    printf("  FAIL: Mismatch for a bitlist of %zu bits.\n", n);
+                }
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Union, overlap, subset and popcount match.\n");
+        }
+    }
+    ssz_bits_set_backend(selected);
+
+    printf("Testing missing delimiter and different lengths => should fail...\n");
+    {
+        uint8_t a[2] = {0xFF, 0x01};
+        uint8_t b[2] = {0xFF, 0x02};
+        uint8_t no_delimiter[2] = {0xFF, 0x00};
+        uint8_t out[2];
+        bool result;
+        size_t count;
+        bool ok = ssz_bitlist_union(a, b, 2, out) == SSZ_ERROR_OUT_OF_RANGE &&
+                  ssz_bitlist_intersects(a, b, 2, &result) == SSZ_ERROR_OUT_OF_RANGE &&
+                  ssz_bitlist_is_subset(a, no_delimiter, 2, &result) == SSZ_ERROR_DESERIALIZATION &&
+                  ssz_bitlist_popcount(no_delimiter, 2, &count) == SSZ_ERROR_DESERIALIZATION &&
+                  ssz_bitlist_popcount(a, 0, &count) == SSZ_ERROR_DESERIALIZATION;
+        if (ok)
+        {
+            printf("  OK: Invalid bitlists rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: An invalid bitlist was accepted.\n");
+        }
+    }
+}
+
+int main(void)
+{
+    test_bits_backends();
+    test_bitlist_ops();
+
+    return 0;
+}
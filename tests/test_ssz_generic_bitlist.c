@@ -331,6 +331,20 @@ void process_serialized_file(const char *folder_name, const char *folder_path, c
         return;
     }
 
+    uint8_t packed_root[SSZ_BYTES_PER_CHUNK];
+    size_t packed_bit_count = 0;
+    if (ssz_hash_tree_root_bitlist(expected_data, dec_size, max_bits, packed_root, &packed_bit_count) != SSZ_SUCCESS ||
+        packed_bit_count != actual_bit_count || memcmp(yaml_data, packed_root, SSZ_BYTES_PER_CHUNK) != 0)
+    {
+        valid_failed++;
+        record_failure(folder_name, folder_path, "Root from serialized bytes does not match meta.yaml");
+        free(yaml_data);
+        free(out_buf);
+        free(expected_data);
+        free(in_mem);
+        return;
+    }
+
     valid_passed++;
     free(yaml_data);
     free(out_buf);
@@ -379,11 +393,17 @@ void process_invalid_serialized_file(const char *folder_name, const char *folder
 
     size_t bit_count = 0;
     ssz_error_t des_err = ssz_deserialize_bitlist(decoded_data, dec_size, max_allowed, in_mem, &bit_count);
+    uint8_t packed_root[SSZ_BYTES_PER_CHUNK];
     if (des_err == SSZ_SUCCESS)
     {
         invalid_failed++;
         record_failure(folder_name, folder_path, "Unexpected success: deserialization did not fail as expected");
     }
+    else if (ssz_hash_tree_root_bitlist(decoded_data, dec_size, max_allowed, packed_root, NULL) == SSZ_SUCCESS)
+    {
+        invalid_failed++;
+        record_failure(folder_name, folder_path, "Unexpected success: root from serialized bytes did not fail as expected");
+    }
     else
     {
         invalid_passed++;
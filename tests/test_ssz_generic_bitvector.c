@@ -287,6 +287,20 @@ void process_serialized_file(const char *folder_name, const char *folder_path, c
         free(in_mem);
         return;
     }
+    uint8_t packed_root[SSZ_BYTES_PER_CHUNK];
+    if (ssz_hash_tree_root_bitvector(expected_data, max_bits, packed_root) != SSZ_SUCCESS ||
+        memcmp(yaml_data, packed_root, SSZ_BYTES_PER_CHUNK) != 0)
+    {
+        valid_failed++;
+        char msg[256];
+        snprintf(msg, sizeof(msg), "Root from packed bytes does not match meta.yaml for folder %s", folder_name);
+        record_failure(folder_name, folder_path, msg);
+        free(yaml_data);
+        free(out_buf);
+        free(expected_data);
+        free(in_mem);
+        return;
+    }
     free(yaml_data);
     free(out_buf);
     free(expected_data);
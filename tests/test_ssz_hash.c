@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "snappy_decode.h"
+#include "ssz_constants.h"
+#include "ssz_hash.h"
+#include "ssz_merkle.h"
+
+#ifndef TESTS_DIR
+#define TESTS_DIR "tests/fixtures"
+#endif
+
+int corpus_files = 0;
+int corpus_passed = 0;
+int corpus_failed = 0;
+
+unsigned char *read_file(const char *filepath, size_t *size_out)
+{
+    FILE *fp = fopen(filepath, "rb");
+    if (!fp)
+        return NULL;
+    if (fseek(fp, 0, SEEK_END) != 0)
+    {
+        fclose(fp);
+        return NULL;
+    }
+    long filesize = ftell(fp);
+    if (filesize < 0)
+    {
+        fclose(fp);
+        return NULL;
+    }
+    rewind(fp);
+    unsigned char *buffer = malloc(filesize ? filesize : 1);
+    if (!buffer)
+    {
+        fclose(fp);
+        return NULL;
+    }
+    size_t read_bytes = fread(buffer, 1, filesize, fp);
+    if (read_bytes != (size_t)filesize)
+    {
+        free(buffer);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    *size_out = (size_t)filesize;
+    return buffer;
+}
+
+unsigned char *snappy_decode(const unsigned char *compressed_data, size_t compressed_size, size_t *decoded_size)
+{
+    size_t uncompressed_length;
+    if (snappy_uncompressed_length((const char *)compressed_data, compressed_size, &uncompressed_length) != SNAPPY_OK)
+    {
+        return NULL;
+    }
+    unsigned char *decoded = malloc(uncompressed_length ? uncompressed_length : 1);
+    if (!decoded)
+    {
+        return NULL;
+    }
+    if (snappy_uncompress((const char *)compressed_data, compressed_size, (char *)decoded, &uncompressed_length) != SNAPPY_OK)
+    {
+        free(decoded);
+        return NULL;
+    }
+    *decoded_size = uncompressed_length;
+    return decoded;
+}
+
+static void print_hex(const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+        printf("%02x", data[i]);
+    printf("\n");
+}
+
+static bool compute_root(ssz_hash_backend_t backend, const uint8_t *data, size_t data_size, uint8_t *out_root)
+{
+    size_t chunk_count = 0;
+    uint8_t *chunks = malloc(data_size + SSZ_BYTES_PER_CHUNK);
+    if (!chunks)
+    {
+        return false;
+    }
+    ssz_hash_set_backend(backend);
+    bool ok = ssz_pack(data, 1, data_size, chunks, &chunk_count) == SSZ_SUCCESS &&
+              ssz_merkleize(chunks, chunk_count, 0, out_root) == SSZ_SUCCESS;
+    free(chunks);
+    return ok;
+}
+
+static void check_corpus_file(const char *path)
+{
+    size_t comp_size = 0, data_size = 0;
+    unsigned char *comp = read_file(path, &comp_size);
+    if (!comp)
+    {
+        return;
+    }
+    unsigned char *data = snappy_decode(comp, comp_size, &data_size);
+    free(comp);
+    if (!data)
+    {
+        return;
+    }
+    corpus_files++;
+    uint8_t expected_root[SSZ_BYTES_PER_CHUNK], expected_digest[SSZ_BYTES_PER_CHUNK];
+    bool ok = compute_root(SSZ_HASH_BACKEND_GENERIC, data, data_size, expected_root);
+    ssz_sha256(data, data_size, expected_digest);
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT && ok; b++)
+    {
+        if (b == SSZ_HASH_BACKEND_GENERIC || !ssz_hash_backend_available((ssz_hash_backend_t)b))
+        {
+            continue;
+        }
+        uint8_t root[SSZ_BYTES_PER_CHUNK], digest[SSZ_BYTES_PER_CHUNK];
+        ok = compute_root((ssz_hash_backend_t)b, data, data_size, root);
+        ssz_sha256(data, data_size, digest);
+        if (!ok || memcmp(root, expected_root, SSZ_BYTES_PER_CHUNK) != 0 ||
+            memcmp(digest, expected_digest, SSZ_BYTES_PER_CHUNK) != 0)
+        {
+            printf("  FAIL: %s disagrees with generic for %s\n", ssz_hash_backend_name((ssz_hash_backend_t)b), path);
+            ok = false;
+        }
+    }
+    if (ok)
+        corpus_passed++;
+    else
+        corpus_failed++;
+    free(data);
+}
+
+static void walk_corpus(const char *dir_path)
+{
+    DIR *dir = opendir(dir_path);
+    if (!dir)
+    {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir_path, entry->d_name);
+        struct stat st;
+        if (stat(path, &st) == -1)
+            continue;
+        if (S_ISDIR(st.st_mode))
+        {
+            walk_corpus(path);
+        }
+        else if (strcmp(entry->d_name, "serialized.ssz_snappy") == 0)
+        {
+            check_corpus_file(path);
+        }
+    }
+    closedir(dir);
+}
+
+static void test_known_digests(void)
+{
+    printf("\n--- Testing ssz_sha256 known digests ---\n");
+    static const uint8_t abc_digest[32] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    uint8_t buf[200];
+    for (size_t i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t)(i * 7 + 3);
+
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT; b++)
+    {
+        if (!ssz_hash_backend_available((ssz_hash_backend_t)b))
+        {
+            printf("Skipping backend %s (not available)\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+            continue;
+        }
+        printf("Testing backend %s...\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        uint8_t digest[32];
+        ssz_hash_set_backend((ssz_hash_backend_t)b);
+        ssz_sha256((const uint8_t *)"abc", 3, digest);
+        bool ok = memcmp(digest, abc_digest, sizeof(abc_digest)) == 0;
+        for (size_t len = 0; len <= sizeof(buf) && ok; len++)
+        {
+            uint8_t expected[32];
+            ssz_hash_set_backend(SSZ_HASH_BACKEND_GENERIC);
+            ssz_sha256(buf, len, expected);
+            ssz_hash_set_backend((ssz_hash_backend_t)b);
+            ssz_sha256(buf, len, digest);
+            ok = memcmp(digest, expected, sizeof(expected)) == 0;
+        }
+        if (ok)
+        {
+            printf("  OK: %s digests match for all lengths 0-%zu.\n", ssz_hash_backend_name((ssz_hash_backend_t)b), sizeof(buf));
+        }
+        else
+        {
+            printf("  FAIL: %s digest mismatch: ", ssz_hash_backend_name((ssz_hash_backend_t)b));
+            print_hex(digest, sizeof(digest));
+        }
+    }
+}
+
+static void test_batch_digests(void)
+{
+    printf("\n--- Testing ssz_sha256_64B_xN ---\n");
+    uint8_t in[40 * 64], buf[40 * 64], expected[40 * 32];
+    for (size_t i = 0; i < sizeof(in); i++)
+        in[i] = (uint8_t)(i * 13 + 5);
+    ssz_hash_set_backend(SSZ_HASH_BACKEND_GENERIC);
+    for (size_t i = 0; i < 40; i++)
+        ssz_sha256(in + 64 * i, 64, expected + 32 * i);
+
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT; b++)
+    {
+        if (!ssz_hash_backend_available((ssz_hash_backend_t)b))
+        {
+            continue;
+        }
+        printf("Testing backend %s, separate and in-place output...\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        ssz_hash_set_backend((ssz_hash_backend_t)b);
+        bool ok = true;
+        for (size_t count = 0; count <= 40 && ok; count++)
+        {
+            uint8_t out[40 * 32];
+            ssz_sha256_64B_xN(in, count, out);
+            memcpy(buf, in, sizeof(buf));
+            ssz_sha256_64B_xN(buf, count, buf);
+            ok = memcmp(out, expected, count * 32) == 0 && memcmp(buf, expected, count * 32) == 0;
+        }
+        if (ok)
+        {
+            printf("  OK: %s batch digests match for 0-40 messages.\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        }
+        else
+        {
+            printf("  FAIL: %s batch digest mismatch.\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        }
+    }
+}
+
+static void test_hash_pair(void)
+{
+    printf("\n--- Testing ssz_hash_pair ---\n");
+    uint8_t nodes[64 * 64];
+    uint8_t expected[64 * 32];
+    for (size_t i = 0; i < sizeof(nodes); i++)
+        nodes[i] = (uint8_t)(i * 29 + 11);
+    ssz_hash_set_backend(SSZ_HASH_BACKEND_GENERIC);
+    for (size_t i = 0; i < 64; i++)
+        ssz_sha256(nodes + 64 * i, 64, expected + 32 * i);
+
+    for (int b = 0; b < SSZ_HASH_BACKEND_COUNT; b++)
+    {
+        if (!ssz_hash_backend_available((ssz_hash_backend_t)b))
+        {
+            continue;
+        }
+        printf("Testing backend %s, including output aliasing either input...\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        ssz_hash_set_backend((ssz_hash_backend_t)b);
+        bool ok = true;
+        for (size_t i = 0; i < 64 && ok; i++)
+        {
+            uint8_t out[32], left[32], right[32];
+            ssz_hash_pair(nodes + 64 * i, nodes + 64 * i + 32, out);
+            ok = memcmp(out, expected + 32 * i, 32) == 0;
+            memcpy(left, nodes + 64 * i, 32);
+            memcpy(right, nodes + 64 * i + 32, 32);
+            ssz_hash_pair(left, right, left);
+            ssz_hash_pair(nodes + 64 * i, right, right);
+            ok = ok && memcmp(left, expected + 32 * i, 32) == 0 && memcmp(right, expected + 32 * i, 32) == 0;
+        }
+        if (ok)
+        {
+            printf("  OK: %s pair digests match ssz_sha256.\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        }
+        else
+        {
+            printf("  FAIL: %s pair digest mismatch.\n", ssz_hash_backend_name((ssz_hash_backend_t)b));
+        }
+    }
+}
+
+int main(void)
+{
+    ssz_hash_backend_t selected = ssz_hash_get_backend();
+    printf("Selected backend at startup: %s\n", ssz_hash_backend_name(selected));
+
+    test_known_digests();
+    test_batch_digests();
+    test_hash_pair();
+
+    printf("\n--- Testing backend roots on the fixture corpus ---\n");
+    walk_corpus(TESTS_DIR);
+    ssz_hash_set_backend(selected);
+
+    printf("\nSummary:\n");
+    printf("Corpus files: %d passed, %d failed, out of %d\n", corpus_passed, corpus_failed, corpus_files);
+    return corpus_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
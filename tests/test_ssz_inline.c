@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_inline.h"
+#include "ssz_serialize.h"
+#include "ssz_deserialize.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+typedef struct
+{
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t u64;
+    bool flag;
+} BasicFields;
+
+static void test_load_store(void)
+{
+    printf("\n--- Testing ssz_load_le* / ssz_store_le* ---\n");
+
+    printf("Testing stores against the library serializers...\n");
+    {
+        bool ok = true;
+        uint64_t seed = 0x0123456789ABCDEFull;
+        for (int i = 0; i < 1000 && ok; i++)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            uint16_t v16 = (uint16_t)seed;
+            uint32_t v32 = (uint32_t)seed;
+            uint64_t v64 = seed;
+            uint8_t expected[SSZ_BYTE_SIZE_OF_UINT64];
+            uint8_t actual[SSZ_BYTE_SIZE_OF_UINT64 + 1];
+            size_t size;
+
+            size = sizeof(expected);
+            ssz_serialize_uint16(&v16, expected, &size);
+            ssz_store_le16(actual + 1, v16);
+            ok = memcmp(actual + 1, expected, SSZ_BYTE_SIZE_OF_UINT16) == 0 && ssz_load_le16(actual + 1) == v16;
+
+            size = sizeof(expected);
+            ssz_serialize_uint32(&v32, expected, &size);
+            ssz_store_le32(actual + 1, v32);
+            ok = ok && memcmp(actual + 1, expected, SSZ_BYTE_SIZE_OF_UINT32) == 0 && ssz_load_le32(actual + 1) == v32;
+
+            size = sizeof(expected);
+            ssz_serialize_uint64(&v64, expected, &size);
+            ssz_store_le64(actual + 1, v64);
+            ok = ok && memcmp(actual + 1, expected, SSZ_BYTE_SIZE_OF_UINT64) == 0 && ssz_load_le64(actual + 1) == v64;
+        }
+        if (ok)
+        {
+            printf("  OK: Unaligned loads and stores match the library encoding.\n");
+        }
+        else
+        {
+            printf("  FAIL: Inline encoding differs from the library encoding.\n");
+        }
+    }
+
+    printf("Testing the byte order of a known value...\n");
+    {
+        uint8_t out[SSZ_BYTE_SIZE_OF_UINT64];
+        const uint8_t expected[SSZ_BYTE_SIZE_OF_UINT64] = {0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01};
+        ssz_store_le64(out, 0x0102030405060708ull);
+        if (memcmp(out, expected, sizeof(out)) == 0 && ssz_load_le32(expected) == 0x05060708u)
+        {
+            printf("  OK: Values are stored least significant byte first.\n");
+        }
+        else
+        {
+            printf("  FAIL: Values are not stored little-endian.\n");
+        }
+    }
+}
+
+/* A codec that stores a uint64_t field in four bytes, as a container with a narrowed field would. */
+static ssz_error_t serialize_uint64_as_uint32(const uint64_t *value, uint8_t *out_buf, size_t *out_size)
+{
+    uint32_t narrow = (uint32_t)*value;
+    return ssz_serialize_uint32(&narrow, out_buf, out_size);
+}
+
+static ssz_error_t deserialize_uint64_from_uint32(const uint8_t *buffer, size_t buffer_size, uint64_t *out_value)
+{
+    uint32_t narrow;
+    ssz_error_t err = ssz_deserialize_uint32(buffer, buffer_size, &narrow);
+    *out_value = narrow;
+    return err;
+}
+
+static void test_dispatch(void)
+{
+    printf("\n--- Testing SSZ_INLINE_SERIALIZER / SSZ_INLINE_DESERIALIZER ---\n");
+
+    printf("Testing round trip of every basic field type...\n");
+    {
+        BasicFields in = {0xAB, 0xBEEF, 0xDEADBEEFu, 0x0102030405060708ull, true};
+        BasicFields back;
+        memset(&back, 0, sizeof(back));
+        uint8_t buf[SSZ_BYTE_SIZE_OF_UINT64];
+        bool ok = true;
+
+#define ROUND_TRIP(field, ser_func, deser_func)                                                          \
+        do                                                                                               \
+        {                                                                                                \
+            size_t size = sizeof(buf);                                                                   \
+            ok = ok && SSZ_INLINE_SERIALIZER(in.field, ser_func)(&in.field, buf, &size) == SSZ_SUCCESS && \
+                 size == sizeof(in.field) &&                                                             \
+                 SSZ_INLINE_DESERIALIZER(back.field, deser_func)(buf, size, &back.field) == SSZ_SUCCESS && \
+                 back.field == in.field;                                                                 \
+        } while (0)
+
+        ROUND_TRIP(u8, ssz_serialize_uint8, ssz_deserialize_uint8);
+        ROUND_TRIP(u16, ssz_serialize_uint16, ssz_deserialize_uint16);
+        ROUND_TRIP(u32, ssz_serialize_uint32, ssz_deserialize_uint32);
+        ROUND_TRIP(u64, ssz_serialize_uint64, ssz_deserialize_uint64);
+        ROUND_TRIP(flag, ssz_serialize_boolean, ssz_deserialize_boolean);
+#undef ROUND_TRIP
+
+        if (ok)
+        {
+            printf("  OK: Every basic field round-trips.\n");
+        }
+        else
+        {
+            printf("  FAIL: A basic field did not round-trip.\n");
+        }
+    }
+
+    printf("Testing a codec other than the library function is called as given...\n");
+    {
+        uint64_t value = 0x0102030405060708ull;
+        uint64_t back = 0;
+        uint8_t buf[SSZ_BYTE_SIZE_OF_UINT64] = {0};
+        size_t size = SSZ_BYTE_SIZE_OF_UINT32;
+        bool ok = SSZ_INLINE_SERIALIZE(value, serialize_uint64_as_uint32, buf, &size) == SSZ_SUCCESS &&
+                  size == SSZ_BYTE_SIZE_OF_UINT32 && buf[0] == 0x08 && buf[3] == 0x05 && buf[4] == 0 &&
+                  SSZ_INLINE_DESERIALIZE(buf, size, back, deserialize_uint64_from_uint32) == SSZ_SUCCESS &&
+                  back == 0x05060708ull;
+        if (ok)
+        {
+            printf("  OK: The four-byte codec was used for a uint64_t field.\n");
+        }
+        else
+        {
+            printf("  FAIL: The inline codec replaced the caller's codec.\n");
+        }
+    }
+
+    printf("Testing short buffers and an invalid boolean => should fail...\n");
+    {
+        uint64_t value = 1;
+        uint8_t buf[SSZ_BYTE_SIZE_OF_UINT64] = {0x02};
+        size_t size = SSZ_BYTE_SIZE_OF_UINT32;
+        bool flag;
+        bool ok = ssz_inline_serialize_uint64(&value, buf, &size) == SSZ_ERROR_SERIALIZATION &&
+                  ssz_inline_deserialize_uint64(buf, SSZ_BYTE_SIZE_OF_UINT32, &value) == SSZ_ERROR_DESERIALIZATION &&
+                  ssz_inline_deserialize_boolean(buf, SSZ_BYTE_SIZE_OF_BOOL, &flag) == SSZ_ERROR_DESERIALIZATION;
+        if (ok)
+        {
+            printf("  OK: Invalid input rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Invalid input accepted.\n");
+        }
+    }
+}
+
+int main(void)
+{
+    test_load_store();
+    test_dispatch();
+
+    return 0;
+}
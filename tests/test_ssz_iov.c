@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_iov.h"
+#include "ssz_generator.h"
+#include "ssz_serialize.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+#define SIZE_ROOT 32
+#define ROOT_COUNT 64
+#define GATHER_ENTRIES 3000
+
+typedef struct
+{
+    uint64_t length;
+    uint64_t *data;
+} Balances;
+
+typedef struct
+{
+    uint64_t slot;
+    uint8_t roots[ROOT_COUNT][SIZE_ROOT];
+    Balances balances;
+    uint64_t weights[4];
+} History;
+
+#define SIZE_HISTORY_FIXED (SSZ_BYTE_SIZE_OF_UINT64 + ROOT_COUNT * SIZE_ROOT + SSZ_BYTES_PER_LENGTH_OFFSET + \
+                            4 * SSZ_BYTE_SIZE_OF_UINT64)
+
+#define SERIALIZE_HISTORY_FIELDS                                                                                   \
+    uint32_t variable_offset = SIZE_HISTORY_FIXED;                                                                 \
+    uint32_t balances_offset;                                                                                      \
+    SERIALIZE_BASIC_FIELD(obj, offset, slot, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);                       \
+    SERIALIZE_VECTOR_ARRAY_FIELD(obj, offset, roots, SIZE_ROOT, ROOT_COUNT, ssz_serialize_vector_uint8);           \
+    SERIALIZE_OFFSET_FIELD(balances_offset, variable_offset, offset, obj->balances.length * SSZ_BYTE_SIZE_OF_UINT64); \
+    SERIALIZE_VECTOR_FIELD(obj, offset, weights, 4 * SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_vector_uint64);       \
+    SERIALIZE_LIST_FIELD(obj, offset, balances, SSZ_BYTE_SIZE_OF_UINT64);
+DEFINE_SERIALIZE_CONTAINER(History, SERIALIZE_HISTORY_FIELDS);
+
+#define EMIT_HISTORY_FIELDS                                                             \
+    uint32_t variable_offset = SIZE_HISTORY_FIXED;                                      \
+    EMIT_BASIC_FIELD(obj, slot, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);         \
+    EMIT_VECTOR_FIELD(obj, roots, 1);                                                   \
+    EMIT_OFFSET_FIELD(variable_offset, obj->balances.length * SSZ_BYTE_SIZE_OF_UINT64); \
+    EMIT_VECTOR_FIELD(obj, weights, SSZ_BYTE_SIZE_OF_UINT64);                           \
+    EMIT_LIST_FIELD(obj, balances, SSZ_BYTE_SIZE_OF_UINT64);
+DEFINE_SERIALIZE_IOV(History, EMIT_HISTORY_FIELDS);
+
+static bool iov_equals(const ssz_iov_t *iov, const uint8_t *expected, size_t size)
+{
+    uint8_t *out = malloc(size + 1);
+    size_t out_size = size;
+    bool ok = out != NULL && iov->size == size && ssz_iov_copy(iov, out, &out_size) == SSZ_SUCCESS &&
+              out_size == size && memcmp(out, expected, size) == 0;
+    free(out);
+    return ok;
+}
+
+static void test_iov_entries(void)
+{
+    printf("\n--- Testing ssz_iov_t entries ---\n");
+    ssz_arena_t arena;
+    ssz_arena_init(&arena, 4096);
+
+    printf("Testing adjacent references and scratch pieces are merged...\n");
+    {
+        static uint8_t bytes[256];
+        for (size_t i = 0; i < sizeof(bytes); i++)
+        {
+            bytes[i] = (uint8_t)i;
+        }
+        uint8_t expected[256 + 12];
+        ssz_iov_t iov;
+        ssz_iov_init(&iov, &arena, 0);
+        bool ok = ssz_iov_append_ref(&iov, bytes, 100) == SSZ_SUCCESS &&
+                  ssz_iov_append_ref(&iov, bytes + 100, 156) == SSZ_SUCCESS &&
+                  ssz_iov_append_ref(&iov, bytes, 0) == SSZ_SUCCESS;
+        memcpy(expected, bytes, 256);
+        for (uint32_t i = 0; i < 3 && ok; i++)
+        {
+            ok = ssz_iov_put_uint32(&iov, 0x01020304u * (i + 1)) == SSZ_SUCCESS;
+            ssz_store_le32(expected + 256 + 4 * i, 0x01020304u * (i + 1));
+        }
+        ok = ok && iov.count == 2 && iov.entries[0].iov_base == (void *)bytes &&
+             iov.entries[0].iov_len == 256 && iov.entries[1].iov_len == 12 &&
+             iov_equals(&iov, expected, sizeof(expected));
+        if (ok)
+        {
+            printf("  OK: 256 referenced bytes and three offsets in 2 entries.\n");
+        }
+        else
+        {
+            printf("  FAIL: Entries were not merged as expected.\n");
+        }
+    }
+
+    printf("Testing integer arrays are referenced in place on little-endian hosts...\n");
+    {
+        uint64_t values[5] = {1, 0x0102030405060708ull, UINT64_MAX, 0, 42};
+        uint8_t expected[sizeof(values)];
+        for (size_t i = 0; i < 5; i++)
+        {
+            ssz_store_le64(expected + 8 * i, values[i]);
+        }
+        ssz_iov_t iov;
+        ssz_iov_init(&iov, &arena, 0);
+        bool ok = ssz_iov_append_le(&iov, values, 5, sizeof(uint64_t)) == SSZ_SUCCESS &&
+                  iov.count == 1 && iov_equals(&iov, expected, sizeof(expected)) &&
+                  (iov.entries[0].iov_base == (void *)values) == (bool)SSZ_HOST_LITTLE_ENDIAN;
+        if (ok)
+        {
+            printf("  OK: Values emitted in little-endian order.\n");
+        }
+        else
+        {
+            printf("  FAIL: Values differ or were copied on a little-endian host.\n");
+        }
+    }
+
+    printf("Testing scratch pieces spanning several scratch regions...\n");
+    {
+        uint8_t expected[5 * 40];
+        ssz_iov_t iov;
+        ssz_iov_init(&iov, &arena, 16);
+        bool ok = true;
+        for (size_t i = 0; i < 40 && ok; i++)
+        {
+            uint8_t *p = ssz_iov_reserve(&iov, 5);
+            ok = p != NULL;
+            if (ok)
+            {
+                memset(p, (int)i, 5);
+                memset(expected + 5 * i, (int)i, 5);
+                ok = ssz_iov_advance(&iov, 5) == SSZ_SUCCESS;
+            }
+        }
+        uint8_t small[8];
+        size_t small_size = sizeof(small);
+        ok = ok && iov_equals(&iov, expected, sizeof(expected)) && iov.count > 1 &&
+             ssz_iov_copy(&iov, small, &small_size) == SSZ_ERROR_SERIALIZATION;
+        if (ok)
+        {
+            printf("  OK: %zu entries hold the output and a short buffer is rejected.\n", iov.count);
+        }
+        else
+        {
+            printf("  FAIL: Scratch output differs.\n");
+        }
+    }
+    ssz_arena_free(&arena);
+}
+
+static void test_iov_container(void)
+{
+    printf("\n--- Testing generated scatter-gather serializers ---\n");
+
+    printf("Testing serialize_<Type>_to_iov matches serialize_<Type>...\n");
+    static History history;
+    uint64_t balances[7];
+    history.slot = 123456789;
+    for (size_t i = 0; i < ROOT_COUNT; i++)
+    {
+        memset(history.roots[i], (int)(i * 3), SIZE_ROOT);
+    }
+    for (size_t i = 0; i < 7; i++)
+    {
+        balances[i] = 32000000000ull + i;
+    }
+    for (size_t i = 0; i < 4; i++)
+    {
+        history.weights[i] = i << 40;
+    }
+    history.balances.length = 7;
+    history.balances.data = balances;
+
+    static uint8_t expected[SIZE_HISTORY_FIXED + sizeof(balances)];
+    size_t expected_size = sizeof(expected);
+    ssz_arena_t arena;
+    ssz_arena_init(&arena, 4096);
+    ssz_iov_t iov;
+    ssz_iov_init(&iov, &arena, 0);
+    bool ok = serialize_History(&history, expected, &expected_size) == SSZ_SUCCESS &&
+              expected_size == sizeof(expected) &&
+              serialize_History_to_iov(&history, &iov) == SSZ_SUCCESS &&
+              iov_equals(&iov, expected, expected_size) &&
+              iov.entries[1].iov_base == (void *)history.roots;
+    ssz_arena_free(&arena);
+    if (ok)
+    {
+        printf("  OK: %zu bytes in %zu entries, roots referenced in place.\n", expected_size, iov.count);
+    }
+    else
+    {
+        printf("  FAIL: Scatter-gather output differs.\n");
+    }
+}
+
+static void test_iov_writev(void)
+{
+    printf("\n--- Testing ssz_iov_writev ---\n");
+
+    printf("Testing a list longer than IOV_MAX is written in order...\n");
+    static uint8_t source[2 * GATHER_ENTRIES];
+    static uint8_t expected[GATHER_ENTRIES];
+    static uint8_t readback[GATHER_ENTRIES + 1];
+    for (size_t i = 0; i < GATHER_ENTRIES; i++)
+    {
+        source[2 * i] = (uint8_t)(i * 7 + 1);
+        expected[i] = source[2 * i];
+    }
+    ssz_arena_t arena;
+    ssz_arena_init(&arena, 4096);
+    ssz_iov_t iov;
+    ssz_iov_init(&iov, &arena, 0);
+    bool ok = true;
+    for (size_t i = 0; i < GATHER_ENTRIES && ok; i++)
+    {
+        ok = ssz_iov_append_ref(&iov, &source[2 * i], 1) == SSZ_SUCCESS;
+    }
+    FILE *fp = tmpfile();
+    ok = ok && fp != NULL && iov.count == GATHER_ENTRIES && ssz_iov_writev(&iov, fileno(fp)) == SSZ_SUCCESS;
+    if (ok)
+    {
+        rewind(fp);
+        ok = fread(readback, 1, sizeof(readback), fp) == GATHER_ENTRIES &&
+             memcmp(readback, expected, GATHER_ENTRIES) == 0 &&
+             iov.entries[GATHER_ENTRIES - 1].iov_base == (void *)&source[2 * (GATHER_ENTRIES - 1)];
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    ssz_arena_free(&arena);
+    if (ok)
+    {
+        printf("  OK: %d entries written and left unchanged.\n", GATHER_ENTRIES);
+    }
+    else
+    {
+        printf("  FAIL: writev output differs.\n");
+    }
+}
+
+int main(void)
+{
+    test_iov_entries();
+    test_iov_container();
+    test_iov_writev();
+
+    return 0;
+}
@@ -0,0 +1,668 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "mincrypt/sha256.h"
+#include "ssz_merkle.h"
+#include "ssz_constants.h"
+#include "ssz_utils.h"
+#include "ssz_types.h"
+
+static void fill_chunks(uint8_t *chunks, size_t chunk_count, uint8_t seed)
+{
+    for (size_t i = 0; i < chunk_count * SSZ_BYTES_PER_CHUNK; i++)
+    {
+        chunks[i] = (uint8_t)(seed + i * 31);
+    }
+}
+
+static void reference_merkleize(const uint8_t *chunks, size_t chunk_count, size_t padded, uint8_t *out_root)
+{
+    uint8_t *nodes = calloc(padded, SSZ_BYTES_PER_CHUNK);
+    memcpy(nodes, chunks, chunk_count * SSZ_BYTES_PER_CHUNK);
+    for (size_t num = padded; num > 1; num >>= 1)
+    {
+        for (size_t i = 0; i < num / 2; i++)
+        {
+            SHA256_hash(nodes + 2 * i * SSZ_BYTES_PER_CHUNK, 2 * SSZ_BYTES_PER_CHUNK, nodes + i * SSZ_BYTES_PER_CHUNK);
+        }
+    }
+    memcpy(out_root, nodes, SSZ_BYTES_PER_CHUNK);
+    free(nodes);
+}
+
+static void test_zero_hash_table(void)
+{
+    printf("\n--- Testing zero_hash_table ---\n");
+
+    printf("Testing every depth is the hash of two copies of the previous depth...\n");
+    {
+        bool ok = is_zero(zero_hash_table[0], SSZ_BYTES_PER_CHUNK);
+        for (int d = 1; d <= SSZ_MAX_MERKLE_DEPTH && ok; d++)
+        {
+            uint8_t pair[2 * SSZ_BYTES_PER_CHUNK];
+            uint8_t digest[SSZ_BYTES_PER_CHUNK];
+            memcpy(pair, zero_hash_table[d - 1], SSZ_BYTES_PER_CHUNK);
+            memcpy(pair + SSZ_BYTES_PER_CHUNK, zero_hash_table[d - 1], SSZ_BYTES_PER_CHUNK);
+            SHA256_hash(pair, sizeof(pair), digest);
+            ok = memcmp(digest, zero_hash_table[d], SSZ_BYTES_PER_CHUNK) == 0;
+        }
+        if (ok)
+        {
+            printf("  OK: zero_hash_table is consistent for all depths.\n");
+        }
+        else
+        {
+            printf("  FAIL: zero_hash_table is inconsistent.\n");
+        }
+    }
+}
+
+static void test_merkleize(void)
+{
+    printf("\n--- Testing ssz_merkleize ---\n");
+    uint8_t chunks[64 * SSZ_BYTES_PER_CHUNK];
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t expected[SSZ_BYTES_PER_CHUNK];
+    ssz_error_t err;
+
+    printf("Testing partial trees against a fully padded reference...\n");
+    {
+        bool ok = true;
+        fill_chunks(chunks, 64, 0x11);
+        for (size_t count = 1; count <= 64 && ok; count++)
+        {
+            size_t limits[3] = {count, 64, 1024};
+            for (size_t j = 0; j < 3 && ok; j++)
+            {
+                size_t padded = 1;
+                while (padded < limits[j])
+                {
+                    padded <<= 1;
+                }
+                reference_merkleize(chunks, count, padded, expected);
+                err = ssz_merkleize(chunks, count, limits[j], root);
+                ok = err == SSZ_SUCCESS && memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Partial trees match the reference.\n");
+        }
+        else
+        {
+            printf("  FAIL: Partial tree root mismatch.\n");
+        }
+    }
+
+    printf("Testing empty list against VALIDATOR_REGISTRY_LIMIT (2^40)...\n");
+    {
+        err = ssz_merkleize(chunks, 0, (size_t)1 << 40, root);
+        if (err == SSZ_SUCCESS && memcmp(root, zero_hash_table[40], SSZ_BYTES_PER_CHUNK) == 0)
+        {
+            printf("  OK: Empty list root equals the depth-40 zero hash.\n");
+        }
+        else
+        {
+            printf("  FAIL: Empty list root is wrong.\n");
+        }
+    }
+
+    printf("Testing three chunks against a 2^40 limit...\n");
+    {
+        uint8_t pair[2 * SSZ_BYTES_PER_CHUNK];
+        fill_chunks(chunks, 3, 0x5A);
+        reference_merkleize(chunks, 3, 4, expected);
+        for (int d = 2; d < 40; d++)
+        {
+            memcpy(pair, expected, SSZ_BYTES_PER_CHUNK);
+            memcpy(pair + SSZ_BYTES_PER_CHUNK, zero_hash_table[d], SSZ_BYTES_PER_CHUNK);
+            SHA256_hash(pair, sizeof(pair), expected);
+        }
+        err = ssz_merkleize(chunks, 3, (size_t)1 << 40, root);
+        if (err == SSZ_SUCCESS && memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0)
+        {
+            printf("  OK: Sparse root over a 2^40 limit computed correctly.\n");
+        }
+        else
+        {
+            printf("  FAIL: Sparse root over a 2^40 limit is wrong.\n");
+        }
+    }
+
+    printf("Testing chunk_count above limit => should fail...\n");
+    {
+        err = ssz_merkleize(chunks, 5, 4, root);
+        if (err == SSZ_ERROR_SERIALIZATION)
+        {
+            printf("  OK: chunk_count above limit rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: chunk_count above limit was not rejected.\n");
+        }
+    }
+}
+
+static void test_merkleize_parallel(void)
+{
+    printf("\n--- Testing ssz_merkleize_parallel ---\n");
+    size_t max_chunks = 70000;
+    uint8_t *chunks = malloc(max_chunks * SSZ_BYTES_PER_CHUNK);
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t expected[SSZ_BYTES_PER_CHUNK];
+
+    printf("Testing roots match ssz_merkleize across sizes, limits and thread counts...\n");
+    {
+        bool ok = chunks != NULL;
+        if (ok)
+        {
+            fill_chunks(chunks, max_chunks, 0x3C);
+        }
+        size_t counts[6] = {0, 1, 2047, 8192, 9000, 70000};
+        unsigned int threads[5] = {0, 1, 2, 3, 8};
+        for (size_t i = 0; i < 6 && ok; i++)
+        {
+            size_t limits[3] = {0, counts[i], (size_t)1 << 40};
+            for (size_t j = 0; j < 3 && ok; j++)
+            {
+                ok = ssz_merkleize(chunks, counts[i], limits[j], expected) == SSZ_SUCCESS;
+                for (size_t k = 0; k < 5 && ok; k++)
+                {
+                    ok = ssz_merkleize_parallel(chunks, counts[i], limits[j], threads[k], root) == SSZ_SUCCESS &&
+                         memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+                }
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Parallel roots match ssz_merkleize.\n");
+        }
+        else
+        {
+            printf("  FAIL: Parallel root mismatch.\n");
+        }
+    }
+
+    printf("Testing chunk_count above limit => should fail...\n");
+    {
+        if (ssz_merkleize_parallel(chunks, 9000, 8192, 4, root) == SSZ_ERROR_SERIALIZATION)
+        {
+            printf("  OK: chunk_count above limit rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: chunk_count above limit was not rejected.\n");
+        }
+    }
+    free(chunks);
+}
+
+static void test_merkleizer(void)
+{
+    printf("\n--- Testing ssz_merkleizer ---\n");
+    uint8_t chunks[64 * SSZ_BYTES_PER_CHUNK];
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t expected[SSZ_BYTES_PER_CHUNK];
+    ssz_merkleizer_t m;
+    ssz_error_t err;
+
+    printf("Testing chunk-by-chunk pushes against ssz_merkleize...\n");
+    {
+        bool ok = true;
+        fill_chunks(chunks, 64, 0x23);
+        for (size_t count = 0; count <= 64 && ok; count++)
+        {
+            size_t limits[4] = {0, count, 64, (size_t)1 << 40};
+            for (size_t j = 0; j < 4 && ok; j++)
+            {
+                ssz_merkleizer_init(&m, limits[j]);
+                for (size_t i = 0; i < count && ok; i++)
+                {
+                    ok = ssz_merkleizer_push_chunk(&m, chunks + i * SSZ_BYTES_PER_CHUNK) == SSZ_SUCCESS;
+                }
+                ok = ok && ssz_merkleize(chunks, count, limits[j], expected) == SSZ_SUCCESS;
+                ok = ok && ssz_merkleizer_finalize(&m, root) == SSZ_SUCCESS;
+                ok = ok && memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Streamed roots match ssz_merkleize.\n");
+        }
+        else
+        {
+            printf("  FAIL: Streamed root mismatch.\n");
+        }
+    }
+
+    printf("Testing batched pushes of uneven sizes against ssz_merkleize...\n");
+    {
+        bool ok = true;
+        fill_chunks(chunks, 64, 0x77);
+        for (size_t count = 0; count <= 64 && ok; count++)
+        {
+            ssz_merkleizer_init(&m, 128);
+            size_t pushed = 0, batch = 1;
+            while (pushed < count && ok)
+            {
+                size_t n = batch < count - pushed ? batch : count - pushed;
+                ok = ssz_merkleizer_push_chunks(&m, chunks + pushed * SSZ_BYTES_PER_CHUNK, n) == SSZ_SUCCESS;
+                pushed += n;
+                batch = batch % 5 + 1;
+            }
+            ok = ok && ssz_merkleize(chunks, count, 128, expected) == SSZ_SUCCESS;
+            ok = ok && ssz_merkleizer_finalize(&m, root) == SSZ_SUCCESS;
+            ok = ok && memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+        }
+        if (ok)
+        {
+            printf("  OK: Batched roots match ssz_merkleize.\n");
+        }
+        else
+        {
+            printf("  FAIL: Batched root mismatch.\n");
+        }
+    }
+
+    printf("Testing push beyond limit => should fail...\n");
+    {
+        ssz_merkleizer_init(&m, 2);
+        ssz_merkleizer_push_chunks(&m, chunks, 2);
+        err = ssz_merkleizer_push_chunk(&m, chunks);
+        ssz_error_t err_batch = ssz_merkleizer_push_chunks(&m, chunks, 1);
+        if (err == SSZ_ERROR_SERIALIZATION && err_batch == SSZ_ERROR_SERIALIZATION && m.count == 2)
+        {
+            printf("  OK: Push beyond limit rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Push beyond limit was not rejected.\n");
+        }
+    }
+}
+
+static void test_generate_proof(void)
+{
+    printf("\n--- Testing ssz_generate_proof / ssz_verify_proof ---\n");
+    uint8_t chunks[40 * SSZ_BYTES_PER_CHUNK];
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    ssz_merkle_proof_t proof;
+    fill_chunks(chunks, 40, 0x5A);
+
+    printf("Testing proofs for every node against ssz_merkleize roots...\n");
+    {
+        bool ok = true;
+        for (size_t count = 0; count <= 40 && ok; count++)
+        {
+            size_t limits[3] = {0, 64, (size_t)1 << 40};
+            for (size_t j = 0; j < 3 && ok; j++)
+            {
+                unsigned int depth = ceil_log2(limits[j] != 0 ? limits[j] : count);
+                ok = ssz_merkleize(chunks, count, limits[j], root) == SSZ_SUCCESS;
+                for (unsigned int d = 0; d <= depth && ok; d++)
+                {
+                    uint64_t first = (uint64_t)1 << d;
+                    uint64_t width = d == depth ? 48 : 8;
+                    for (uint64_t g = first; g < first + width && g < 2 * first && ok; g++)
+                    {
+                        ok = ssz_generate_proof(chunks, count, limits[j], g, &proof) == SSZ_SUCCESS &&
+                             proof.depth == d && proof.gindex == g &&
+                             ssz_verify_proof(proof.leaf, &proof.branch[0][0], proof.depth, g, root);
+                        if (ok && d == depth)
+                        {
+                            uint64_t i = g - first;
+                            ok = i < count ? memcmp(proof.leaf, chunks + i * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK) == 0
+                                           : memcmp(proof.leaf, zero_hash_table[0], SSZ_BYTES_PER_CHUNK) == 0;
+                        }
+                    }
+                }
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Proofs verify against the root for every count and limit.\n");
+        }
+        else
+        {
+            printf("  FAIL: Proof did not verify.\n");
+        }
+    }
+
+    printf("Testing tampered leaf, branch and gindex => should fail...\n");
+    {
+        ssz_merkleize(chunks, 40, 0, root);
+        ssz_generate_proof(chunks, 40, 0, 64 + 37, &proof);
+        uint8_t leaf[SSZ_BYTES_PER_CHUNK];
+        memcpy(leaf, proof.leaf, SSZ_BYTES_PER_CHUNK);
+        leaf[0] ^= 1;
+        bool bad_leaf = ssz_verify_proof(leaf, &proof.branch[0][0], proof.depth, proof.gindex, root);
+        bool bad_gindex = ssz_verify_proof(proof.leaf, &proof.branch[0][0], proof.depth, proof.gindex ^ 1, root);
+        bool bad_depth = ssz_verify_proof(proof.leaf, &proof.branch[0][0], proof.depth - 1, proof.gindex, root);
+        proof.branch[3][7] ^= 0x80;
+        bool bad_branch = ssz_verify_proof(proof.leaf, &proof.branch[0][0], proof.depth, proof.gindex, root);
+        if (!bad_leaf && !bad_gindex && !bad_depth && !bad_branch)
+        {
+            printf("  OK: Tampered proofs rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Tampered proof was accepted.\n");
+        }
+    }
+
+    printf("Testing gindex below the leaf level or zero => should fail...\n");
+    {
+        ssz_error_t deep = ssz_generate_proof(chunks, 40, 64, 128, &proof);
+        ssz_error_t zero = ssz_generate_proof(chunks, 40, 64, 0, &proof);
+        if (deep == SSZ_ERROR_OUT_OF_RANGE && zero != SSZ_SUCCESS)
+        {
+            printf("  OK: Invalid gindex rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Invalid gindex was not rejected.\n");
+        }
+    }
+}
+
+static void test_multiproof(void)
+{
+    printf("\n--- Testing ssz_generate_multiproof / ssz_verify_multiproof ---\n");
+    uint8_t chunks[100 * SSZ_BYTES_PER_CHUNK];
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint64_t gindices[16];
+    uint64_t helper_indices[16 * SSZ_MAX_MERKLE_DEPTH];
+    uint8_t leaves[16 * SSZ_BYTES_PER_CHUNK];
+    uint8_t helpers[16 * SSZ_MAX_MERKLE_DEPTH * SSZ_BYTES_PER_CHUNK];
+    fill_chunks(chunks, 100, 0x77);
+
+    printf("Testing helper indices for a known case...\n");
+    {
+        /* Leaves 8 and 9 share every ancestor, so only 5 and 3 are needed besides each other. */
+        uint64_t known[2] = {9, 8};
+        size_t helper_count = 16;
+        if (ssz_get_helper_indices(known, 2, helper_indices, &helper_count) == SSZ_SUCCESS &&
+            helper_count == 2 && helper_indices[0] == 5 && helper_indices[1] == 3)
+        {
+            printf("  OK: Helper indices are {5, 3}.\n");
+        }
+        else
+        {
+            printf("  FAIL: Unexpected helper indices.\n");
+        }
+    }
+
+    printf("Testing random index sets against ssz_merkleize roots...\n");
+    {
+        bool ok = true;
+        uint32_t state = 777;
+        for (int round = 0; round < 300 && ok; round++)
+        {
+            state = state * 1103515245u + 12345u;
+            size_t count = (state >> 8) % 101;
+            size_t limit = round % 3 == 0 ? 0 : (round % 3 == 1 ? 128 : (size_t)1 << 40);
+            unsigned int depth = ceil_log2(limit != 0 ? limit : count);
+            size_t gindex_count = 1 + (state >> 20) % 16;
+            for (size_t i = 0; i < gindex_count; i++)
+            {
+                state = state * 1103515245u + 12345u;
+                unsigned int d = (state >> 4) % 4 == 0 ? (state >> 8) % (depth + 1) : depth;
+                uint64_t width = (uint64_t)1 << d;
+                uint64_t offset = (state >> 12) % (width < 128 ? width : 128);
+                gindices[i] = width + offset;
+            }
+            size_t helper_count = sizeof(helper_indices) / sizeof(helper_indices[0]);
+            ok = ssz_merkleize(chunks, count, limit, root) == SSZ_SUCCESS &&
+                 ssz_get_helper_indices(gindices, gindex_count, helper_indices, &helper_count) == SSZ_SUCCESS &&
+                 ssz_generate_multiproof(chunks, count, limit, gindices, gindex_count, helper_indices, helper_count,
+                                         leaves, helpers) == SSZ_SUCCESS &&
+                 ssz_verify_multiproof(leaves, gindices, gindex_count, helpers, helper_count, root);
+            for (size_t i = 0; i < gindex_count && ok; i++)
+            {
+                ssz_merkle_proof_t proof;
+                ok = ssz_generate_proof(chunks, count, limit, gindices[i], &proof) == SSZ_SUCCESS &&
+                     memcmp(proof.leaf, leaves + i * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK) == 0;
+            }
+            if (ok && helper_count != 0)
+            {
+                helpers[(round % helper_count) * SSZ_BYTES_PER_CHUNK] ^= 1;
+                ok = !ssz_verify_multiproof(leaves, gindices, gindex_count, helpers, helper_count, root);
+                helpers[(round % helper_count) * SSZ_BYTES_PER_CHUNK] ^= 1;
+                ok = ok && !ssz_verify_multiproof(leaves, gindices, gindex_count, helpers, helper_count - 1, root);
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Multiproofs verify and match single proofs; tampered ones are rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Multiproof mismatch.\n");
+        }
+    }
+
+    printf("Testing helper capacity too small => should fail...\n");
+    {
+        uint64_t known[2] = {16, 31};
+        size_t helper_count = 3;
+        ssz_error_t err = ssz_get_helper_indices(known, 2, helper_indices, &helper_count);
+        if (err != SSZ_SUCCESS && helper_count == 6)
+        {
+            printf("  OK: Small capacity rejected with the required count.\n");
+        }
+        else
+        {
+            printf("  FAIL: Small capacity was not rejected.\n");
+        }
+    }
+}
+
+static void test_verify_proofs_batch(void)
+{
+    printf("\n--- Testing ssz_verify_proofs_batch ---\n");
+    size_t chunk_counts[3] = {1000, 37, 1};
+    size_t limits[3] = {1024, (size_t)1 << 40, 0};
+    size_t item_count = 400;
+    uint8_t *chunks = malloc(1000 * SSZ_BYTES_PER_CHUNK);
+    ssz_merkle_proof_t *proofs = malloc(item_count * sizeof(ssz_merkle_proof_t));
+    ssz_proof_batch_item_t *items = malloc(item_count * sizeof(ssz_proof_batch_item_t));
+    bool *valid = malloc(item_count * sizeof(bool));
+    uint8_t roots[3][SSZ_BYTES_PER_CHUNK];
+
+    printf("Testing mixed valid and tampered proofs against ssz_verify_proof...\n");
+    {
+        bool ok = chunks && proofs && items && valid;
+        if (ok)
+        {
+            fill_chunks(chunks, 1000, 0x21);
+        }
+        for (size_t t = 0; t < 3 && ok; t++)
+        {
+            ok = ssz_merkleize(chunks, chunk_counts[t], limits[t], roots[t]) == SSZ_SUCCESS;
+        }
+        uint32_t state = 4242;
+        size_t tampered = 0;
+        for (size_t j = 0; j < item_count && ok; j++)
+        {
+            state = state * 1103515245u + 12345u;
+            size_t t = (state >> 8) % 3;
+            unsigned int depth = ceil_log2(limits[t] != 0 ? limits[t] : chunk_counts[t]);
+            unsigned int d = (state >> 12) % 5 == 0 ? (state >> 16) % (depth + 1) : depth;
+            uint64_t width = (uint64_t)1 << d;
+            /* Cluster the indices so neighbouring proofs share their upper branches. */
+            uint64_t g = width + (state >> 20) % (width < 64 ? width : 64);
+            ok = ssz_generate_proof(chunks, chunk_counts[t], limits[t], g, &proofs[j]) == SSZ_SUCCESS;
+            items[j].leaf = proofs[j].leaf;
+            items[j].branch = &proofs[j].branch[0][0];
+            items[j].depth = proofs[j].depth;
+            items[j].gindex = proofs[j].gindex;
+            items[j].root = roots[t];
+            switch (j % 10)
+            {
+            case 3:
+                proofs[j].leaf[5] ^= 0x10;
+                tampered++;
+                break;
+            case 6:
+                if (proofs[j].depth > 0)
+                {
+                    proofs[j].branch[proofs[j].depth - 1][0] ^= 1;
+                    tampered++;
+                }
+                break;
+            case 8:
+                items[j].root = roots[(t + 1) % 3];
+                tampered++;
+                break;
+            case 9:
+                items[j].depth = proofs[j].depth + 1;
+                tampered++;
+                break;
+            }
+        }
+        ok = ok && ssz_verify_proofs_batch(items, item_count, valid) == SSZ_SUCCESS;
+        size_t rejected = 0;
+        for (size_t j = 0; j < item_count && ok; j++)
+        {
+            ok = valid[j] == ssz_verify_proof(items[j].leaf, items[j].branch, items[j].depth, items[j].gindex, items[j].root);
+            rejected += !valid[j];
+        }
+        if (ok && rejected == tampered)
+        {
+            printf("  OK: Batch verdicts match ssz_verify_proof (%zu of %zu rejected).\n", rejected, item_count);
+        }
+        else
+        {
+            printf("  FAIL: Batch verdict mismatch.\n");
+        }
+    }
+
+    printf("Testing empty batch...\n");
+    {
+        if (ssz_verify_proofs_batch(NULL, 0, NULL) == SSZ_SUCCESS)
+        {
+            printf("  OK: Empty batch accepted.\n");
+        }
+        else
+        {
+            printf("  FAIL: Empty batch rejected.\n");
+        }
+    }
+    free(chunks);
+    free(proofs);
+    free(items);
+    free(valid);
+}
+
+static void test_hash_tree_root_basic(void)
+{
+    printf("\n--- Testing ssz_hash_tree_root_basic_vector / ssz_hash_tree_root_basic_list ---\n");
+    size_t max_bytes = 700 * SSZ_BYTES_PER_CHUNK;
+    uint8_t *values = malloc(max_bytes);
+    uint8_t *chunks = malloc(max_bytes + SSZ_BYTES_PER_CHUNK);
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t expected[SSZ_BYTES_PER_CHUNK];
+
+    printf("Testing roots match ssz_pack + ssz_merkleize (+ ssz_mix_in_length)...\n");
+    {
+        bool ok = values && chunks;
+        if (ok)
+        {
+            fill_chunks(values, 700, 0x19);
+        }
+        size_t sizes[6] = {1, 2, 4, 8, 16, 32};
+        size_t counts[8] = {0, 1, 3, 31, 64, 65, 257, 700};
+        for (size_t i = 0; i < 6 && ok; i++)
+        {
+            for (size_t j = 0; j < 8 && ok; j++)
+            {
+                size_t count = counts[j] * SSZ_BYTES_PER_CHUNK / sizes[i] / 4 + counts[j] % 3;
+                size_t chunk_count = 0;
+                ok = ssz_pack(values, sizes[i], count, chunks, &chunk_count) == SSZ_SUCCESS;
+                if (ok && count != 0)
+                {
+                    ok = ssz_merkleize(chunks, chunk_count, 0, expected) == SSZ_SUCCESS &&
+                         ssz_hash_tree_root_basic_vector(values, sizes[i], count, root) == SSZ_SUCCESS &&
+                         memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+                }
+                size_t limits[3] = {0, count + 5, (size_t)1 << 30};
+                for (size_t k = 0; k < 3 && ok; k++)
+                {
+                    size_t chunk_limit = (limits[k] * sizes[i] + SSZ_BYTES_PER_CHUNK - 1) / SSZ_BYTES_PER_CHUNK;
+                    ok = ssz_merkleize(chunks, chunk_count, chunk_limit, expected) == SSZ_SUCCESS &&
+                         ssz_mix_in_length(expected, count, expected) == SSZ_SUCCESS &&
+                         ssz_hash_tree_root_basic_list(values, sizes[i], count, limits[k], root) == SSZ_SUCCESS &&
+                         memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+                }
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Fused roots match the pack-and-merkleize path.\n");
+        }
+        else
+        {
+            printf("  FAIL: Fused root mismatch.\n");
+        }
+    }
+
+    printf("Testing invalid value size, empty vector and count above limit => should fail...\n");
+    {
+        if (ssz_hash_tree_root_basic_vector(values, 3, 10, root) != SSZ_SUCCESS &&
+            ssz_hash_tree_root_basic_vector(values, 8, 0, root) != SSZ_SUCCESS &&
+            ssz_hash_tree_root_basic_list(values, 8, 10, 9, root) == SSZ_ERROR_SERIALIZATION)
+        {
+            printf("  OK: Invalid arguments rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Invalid arguments were not rejected.\n");
+        }
+    }
+
+    printf("Testing uneven ssz_merkleizer_push_chunks splits over many blocks...\n");
+    {
+        bool ok = values != NULL;
+        size_t splits[5] = {1, 3, 63, 64, 130};
+        for (size_t i = 0; i < 5 && ok; i++)
+        {
+            ssz_merkleizer_t m;
+            ssz_merkleizer_init(&m, 1024);
+            for (size_t first = 0; first < 700 && ok; first += splits[i])
+            {
+                size_t n = 700 - first < splits[i] ? 700 - first : splits[i];
+                ok = ssz_merkleizer_push_chunks(&m, values + first * SSZ_BYTES_PER_CHUNK, n) == SSZ_SUCCESS;
+            }
+            ok = ok && ssz_merkleizer_finalize(&m, root) == SSZ_SUCCESS &&
+                 ssz_merkleize(values, 700, 1024, expected) == SSZ_SUCCESS &&
+                 memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+        }
+        if (ok)
+        {
+            printf("  OK: Streaming roots match ssz_merkleize for every split.\n");
+        }
+        else
+        {
+            printf("  FAIL: Streaming root mismatch.\n");
+        }
+    }
+    free(values);
+    free(chunks);
+}
+
+int main(void)
+{
+    test_zero_hash_table();
+    test_merkleize();
+    test_merkleize_parallel();
+    test_merkleizer();
+    test_hash_tree_root_basic();
+    test_generate_proof();
+    test_multiproof();
+    test_verify_proofs_batch();
+
+    return 0;
+}
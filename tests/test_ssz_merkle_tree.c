@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "ssz_merkle.h"
+#include "ssz_merkle_tree.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+static void fill_chunks(uint8_t *chunks, size_t chunk_count, uint8_t seed)
+{
+    for (size_t i = 0; i < chunk_count * SSZ_BYTES_PER_CHUNK; i++)
+    {
+        chunks[i] = (uint8_t)(seed + i * 31);
+    }
+}
+
+static bool root_matches(ssz_merkle_tree_t *tree, const uint8_t *chunks, size_t chunk_count, size_t limit)
+{
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t expected[SSZ_BYTES_PER_CHUNK];
+    return ssz_merkle_tree_root(tree, root) == SSZ_SUCCESS &&
+           ssz_merkleize(chunks, chunk_count, limit, expected) == SSZ_SUCCESS &&
+           memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0;
+}
+
+static void test_merkle_tree_init(void)
+{
+    printf("\n--- Testing ssz_merkle_tree_init ---\n");
+    uint8_t chunks[100 * SSZ_BYTES_PER_CHUNK];
+    fill_chunks(chunks, 100, 0x42);
+
+    printf("Testing initial roots match ssz_merkleize...\n");
+    {
+        bool ok = true;
+        for (size_t count = 0; count <= 100 && ok; count++)
+        {
+            size_t limits[3] = {0, 128, (size_t)1 << 40};
+            for (size_t j = 0; j < 3 && ok; j++)
+            {
+                ssz_merkle_tree_t tree;
+                ok = ssz_merkle_tree_init(&tree, chunks, count, limits[j]) == SSZ_SUCCESS &&
+                     root_matches(&tree, chunks, count, limits[j]);
+                ssz_merkle_tree_free(&tree);
+            }
+        }
+        if (ok)
+        {
+            printf("  OK: Initial roots match ssz_merkleize.\n");
+        }
+        else
+        {
+            printf("  FAIL: Initial root mismatch.\n");
+        }
+    }
+
+    printf("Testing chunk_count above limit => should fail...\n");
+    {
+        ssz_merkle_tree_t tree;
+        if (ssz_merkle_tree_init(&tree, chunks, 5, 4) == SSZ_ERROR_SERIALIZATION)
+        {
+            printf("  OK: chunk_count above limit rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: chunk_count above limit was not rejected.\n");
+            ssz_merkle_tree_free(&tree);
+        }
+    }
+}
+
+static void test_merkle_tree_set_chunk(void)
+{
+    printf("\n--- Testing ssz_merkle_tree_set_chunk ---\n");
+    size_t count = 1000;
+    uint8_t *chunks = malloc(count * SSZ_BYTES_PER_CHUNK);
+    fill_chunks(chunks, count, 0x10);
+
+    printf("Testing sparse updates between roots...\n");
+    {
+        ssz_merkle_tree_t tree;
+        bool ok = ssz_merkle_tree_init(&tree, chunks, count, (size_t)1 << 40) == SSZ_SUCCESS;
+        uint32_t state = 12345;
+        for (int round = 0; round < 50 && ok; round++)
+        {
+            int updates = round % 7 + 1;
+            for (int u = 0; u < updates && ok; u++)
+            {
+                state = state * 1103515245u + 12345u;
+                size_t index = state % count;
+                memset(chunks + index * SSZ_BYTES_PER_CHUNK, (int)(state >> 16), SSZ_BYTES_PER_CHUNK);
+                ok = ssz_merkle_tree_set_chunk(&tree, index, chunks + index * SSZ_BYTES_PER_CHUNK) == SSZ_SUCCESS;
+            }
+            ok = ok && root_matches(&tree, chunks, count, (size_t)1 << 40);
+        }
+        ssz_merkle_tree_free(&tree);
+        if (ok)
+        {
+            printf("  OK: Incremental roots match ssz_merkleize.\n");
+        }
+        else
+        {
+            printf("  FAIL: Incremental root mismatch.\n");
+        }
+    }
+
+    printf("Testing appends that grow the tree...\n");
+    {
+        ssz_merkle_tree_t tree;
+        bool ok = ssz_merkle_tree_init(&tree, NULL, 0, 0) == SSZ_SUCCESS;
+        for (size_t i = 0; i < 300 && ok; i++)
+        {
+            ok = ssz_merkle_tree_set_chunk(&tree, i, chunks + i * SSZ_BYTES_PER_CHUNK) == SSZ_SUCCESS;
+            if (i % 3 == 0)
+            {
+                ok = ok && root_matches(&tree, chunks, i + 1, 0);
+            }
+        }
+        ok = ok && root_matches(&tree, chunks, 300, 0);
+        ok = ok && ssz_merkle_tree_get_chunk(&tree, 299) != NULL &&
+             memcmp(ssz_merkle_tree_get_chunk(&tree, 299), chunks + 299 * SSZ_BYTES_PER_CHUNK, SSZ_BYTES_PER_CHUNK) == 0;
+        ssz_merkle_tree_free(&tree);
+        if (ok)
+        {
+            printf("  OK: Appended roots match ssz_merkleize.\n");
+        }
+        else
+        {
+            printf("  FAIL: Appended root mismatch.\n");
+        }
+    }
+
+    printf("Testing index past the end or the limit => should fail...\n");
+    {
+        ssz_merkle_tree_t tree;
+        ssz_merkle_tree_init(&tree, chunks, 4, 4);
+        ssz_error_t past_end = ssz_merkle_tree_set_chunk(&tree, 5, chunks);
+        ssz_error_t past_limit = ssz_merkle_tree_set_chunk(&tree, 4, chunks);
+        if (past_end == SSZ_ERROR_OUT_OF_RANGE && past_limit == SSZ_ERROR_OUT_OF_RANGE &&
+            ssz_merkle_tree_get_chunk(&tree, 4) == NULL)
+        {
+            printf("  OK: Out-of-range indices rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Out-of-range index was not rejected.\n");
+        }
+        ssz_merkle_tree_free(&tree);
+    }
+    free(chunks);
+}
+
+typedef struct
+{
+    size_t indices[64];
+    size_t count;
+    bool ascending;
+} diff_result_t;
+
+static void collect_diff(size_t chunk_index, void *user_data)
+{
+    diff_result_t *result = user_data;
+    if (result->count > 0 && chunk_index <= result->indices[result->count - 1])
+    {
+        result->ascending = false;
+    }
+    if (result->count < 64)
+    {
+        result->indices[result->count] = chunk_index;
+    }
+    result->count++;
+}
+
+static bool diff_matches(ssz_merkle_tree_t *a, ssz_merkle_tree_t *b, const uint8_t *chunks_a, size_t count_a,
+                         const uint8_t *chunks_b, size_t count_b)
+{
+    static const uint8_t zero_chunk[SSZ_BYTES_PER_CHUNK] = {0};
+    diff_result_t result = {{0}, 0, true};
+    if (ssz_merkle_tree_diff(a, b, collect_diff, &result) != SSZ_SUCCESS || !result.ascending)
+    {
+        return false;
+    }
+    size_t expected = 0;
+    size_t count = count_a > count_b ? count_a : count_b;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t *chunk_a = i < count_a ? chunks_a + i * SSZ_BYTES_PER_CHUNK : zero_chunk;
+        const uint8_t *chunk_b = i < count_b ? chunks_b + i * SSZ_BYTES_PER_CHUNK : zero_chunk;
+        if (memcmp(chunk_a, chunk_b, SSZ_BYTES_PER_CHUNK) != 0)
+        {
+            if (expected >= result.count || expected >= 64 || result.indices[expected] != i)
+            {
+                return false;
+            }
+            expected++;
+        }
+    }
+    return expected == result.count;
+}
+
+static void test_merkle_tree_diff(void)
+{
+    printf("\n--- Testing ssz_merkle_tree_diff ---\n");
+    size_t count = 1000;
+    uint8_t *chunks_a = malloc(count * SSZ_BYTES_PER_CHUNK);
+    uint8_t *chunks_b = malloc(count * SSZ_BYTES_PER_CHUNK);
+    fill_chunks(chunks_a, count, 0x21);
+    memcpy(chunks_b, chunks_a, count * SSZ_BYTES_PER_CHUNK);
+
+    printf("Testing sparse changes between two trees...\n");
+    {
+        ssz_merkle_tree_t a, b;
+        ssz_merkle_tree_init(&a, chunks_a, count, (size_t)1 << 40);
+        ssz_merkle_tree_init(&b, chunks_b, count, (size_t)1 << 40);
+        bool ok = diff_matches(&a, &b, chunks_a, count, chunks_b, count);
+        uint32_t state = 777;
+        for (int round = 0; round < 20 && ok; round++)
+        {
+            for (int u = 0; u < round % 5 + 1; u++)
+            {
+                state = state * 1103515245u + 12345u;
+                size_t index = state % count;
+                chunks_b[index * SSZ_BYTES_PER_CHUNK] ^= (uint8_t)(state >> 16) | 1;
+                ssz_merkle_tree_set_chunk(&b, index, chunks_b + index * SSZ_BYTES_PER_CHUNK);
+            }
+            ok = diff_matches(&a, &b, chunks_a, count, chunks_b, count);
+        }
+        ssz_merkle_tree_free(&a);
+        ssz_merkle_tree_free(&b);
+        if (ok)
+        {
+            printf("  OK: Reported indices match a full comparison.\n");
+        }
+        else
+        {
+            printf("  FAIL: Reported indices differ from a full comparison.\n");
+        }
+    }
+
+    printf("Testing trees of different sizes...\n");
+    {
+        uint8_t zeros[8 * SSZ_BYTES_PER_CHUNK] = {0};
+        ssz_merkle_tree_t a, b, z;
+        ssz_merkle_tree_init(&a, chunks_a, 2, 0);
+        ssz_merkle_tree_init(&b, chunks_a, 37, 0);
+        ssz_merkle_tree_init(&z, zeros, 8, 0);
+        bool ok = diff_matches(&a, &b, chunks_a, 2, chunks_a, 37) &&
+                  diff_matches(&b, &a, chunks_a, 37, chunks_a, 2) &&
+                  diff_matches(&a, &z, chunks_a, 2, zeros, 8);
+        ssz_merkle_tree_free(&a);
+        ssz_merkle_tree_free(&b);
+        ssz_merkle_tree_free(&z);
+        if (ok)
+        {
+            printf("  OK: Appended chunks reported.\n");
+        }
+        else
+        {
+            printf("  FAIL: Appended chunks not reported correctly.\n");
+        }
+    }
+    free(chunks_a);
+    free(chunks_b);
+}
+
+int main(void)
+{
+    test_merkle_tree_init();
+    test_merkle_tree_set_chunk();
+    test_merkle_tree_diff();
+
+    return 0;
+}
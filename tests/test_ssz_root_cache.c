@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_root_cache.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+#define KEY_SIZE 121
+
+static void make_key(uint8_t *key, uint32_t id)
+{
+    memset(key, 0x77, KEY_SIZE);
+    key[0] = (uint8_t)id;
+    key[1] = (uint8_t)(id >> 8);
+    key[KEY_SIZE - 1] = (uint8_t)(id >> 16);
+}
+
+static void make_root(uint8_t *root, uint32_t id)
+{
+    for (size_t i = 0; i < SSZ_BYTES_PER_CHUNK; i++)
+    {
+        root[i] = (uint8_t)(id * 13 + i);
+    }
+}
+
+static void test_root_cache_lookup(void)
+{
+    printf("\n--- Testing ssz_root_cache_lookup / ssz_root_cache_insert ---\n");
+    ssz_root_cache_t cache;
+    if (ssz_root_cache_init(&cache, KEY_SIZE, 1 << 13) != SSZ_SUCCESS)
+    {
+        printf("  FAIL: ssz_root_cache_init failed.\n");
+        return;
+    }
+    uint8_t key[KEY_SIZE];
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t found[SSZ_BYTES_PER_CHUNK];
+
+    printf("Testing miss, insert, then hit...\n");
+    {
+        bool ok = true;
+        for (uint32_t id = 0; id < 500 && ok; id++)
+        {
+            make_key(key, id);
+            make_root(root, id);
+            ok = !ssz_root_cache_lookup(&cache, key, found);
+            ssz_root_cache_insert(&cache, key, root);
+        }
+        for (uint32_t id = 0; id < 500 && ok; id++)
+        {
+            make_key(key, id);
+            make_root(root, id);
+            ok = ssz_root_cache_lookup(&cache, key, found) && memcmp(found, root, SSZ_BYTES_PER_CHUNK) == 0;
+        }
+        uint64_t hits, misses;
+        size_t entries;
+        ssz_root_cache_stats(&cache, &hits, &misses, &entries);
+        if (ok && hits == 500 && misses == 500 && entries == 500)
+        {
+            printf("  OK: Cached roots returned and counters correct.\n");
+        }
+        else
+        {
+            printf("  FAIL: Wrong root or counters (hits %llu, misses %llu, entries %zu).\n",
+                   (unsigned long long)hits, (unsigned long long)misses, entries);
+        }
+    }
+
+    printf("Testing re-insert of an existing key...\n");
+    {
+        make_key(key, 7);
+        make_root(root, 9999);
+        ssz_root_cache_insert(&cache, key, root);
+        size_t entries;
+        ssz_root_cache_stats(&cache, NULL, NULL, &entries);
+        if (ssz_root_cache_lookup(&cache, key, found) && memcmp(found, root, SSZ_BYTES_PER_CHUNK) == 0 && entries == 500)
+        {
+            printf("  OK: Entry updated in place.\n");
+        }
+        else
+        {
+            printf("  FAIL: Entry not updated in place.\n");
+        }
+    }
+
+    printf("Testing clear...\n");
+    {
+        ssz_root_cache_clear(&cache);
+        make_key(key, 1);
+        uint64_t hits, misses;
+        size_t entries;
+        bool hit = ssz_root_cache_lookup(&cache, key, found);
+        ssz_root_cache_stats(&cache, &hits, &misses, &entries);
+        if (!hit && hits == 0 && misses == 1 && entries == 0)
+        {
+            printf("  OK: Cache emptied and counters reset.\n");
+        }
+        else
+        {
+            printf("  FAIL: Cache not cleared.\n");
+        }
+    }
+    ssz_root_cache_free(&cache);
+}
+
+static void test_root_cache_eviction(void)
+{
+    printf("\n--- Testing ssz_root_cache eviction ---\n");
+    ssz_root_cache_t cache;
+    ssz_root_cache_init(&cache, KEY_SIZE, 16);
+    uint8_t key[KEY_SIZE];
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    uint8_t found[SSZ_BYTES_PER_CHUNK];
+
+    printf("Testing many more keys than slots...\n");
+    {
+        for (uint32_t id = 0; id < 2000; id++)
+        {
+            make_key(key, id);
+            make_root(root, id);
+            ssz_root_cache_insert(&cache, key, root);
+        }
+        bool ok = true;
+        size_t hits = 0;
+        for (uint32_t id = 0; id < 2000 && ok; id++)
+        {
+            make_key(key, id);
+            make_root(root, id);
+            if (ssz_root_cache_lookup(&cache, key, found))
+            {
+                ok = memcmp(found, root, SSZ_BYTES_PER_CHUNK) == 0;
+                hits++;
+            }
+        }
+        if (ok && hits > 0 && hits <= cache.capacity && cache.entries <= cache.capacity)
+        {
+            printf("  OK: Only correct roots returned, %zu of 2000 still cached.\n", hits);
+        }
+        else
+        {
+            printf("  FAIL: Wrong root returned or table overfilled.\n");
+        }
+    }
+    ssz_root_cache_free(&cache);
+}
+
+int main(void)
+{
+    test_root_cache_lookup();
+    test_root_cache_eviction();
+
+    return 0;
+}
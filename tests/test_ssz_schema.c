@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_schema.h"
+#include "ssz_merkle.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+static const ssz_type_desc_t bytes32_type = {SSZ_TYPE_VECTOR, 0, 32, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t uint16_list_type = {SSZ_TYPE_LIST, 0, 40, &ssz_type_uint16, NULL};
+static const ssz_type_desc_t byte_list_type = {SSZ_TYPE_LIST, 0, 10, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t nested_list_type = {SSZ_TYPE_LIST, 0, 4, &byte_list_type, NULL};
+static const ssz_type_desc_t bitlist_type = {SSZ_TYPE_BITLIST, 0, 20, NULL, NULL};
+
+/* Sample { a: uint64, b: List[uint16, 40], c: Bytes32, d: List[List[uint8, 10], 4], e: Bitlist[20], f: boolean } */
+static const ssz_type_desc_t *const sample_fields[] = {
+    &ssz_type_uint64, &uint16_list_type, &bytes32_type, &nested_list_type, &bitlist_type, &ssz_type_boolean};
+static const ssz_type_desc_t sample_type = {SSZ_TYPE_CONTAINER, 0, 6, NULL, sample_fields};
+
+static void put_offset(uint8_t *p, size_t offset)
+{
+    p[0] = (uint8_t)offset;
+    p[1] = (uint8_t)(offset >> 8);
+    p[2] = (uint8_t)(offset >> 16);
+    p[3] = (uint8_t)(offset >> 24);
+}
+
+/**
+ * Serializes a fixed Sample value by hand and computes its root field by field with the
+ * existing merkleization functions.
+ */
+static size_t build_sample(uint8_t *buf, uint8_t *expected_root)
+{
+    static const uint8_t inner_lengths[3] = {3, 0, 10};
+    uint8_t a[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint16_t b_values[7];
+    uint8_t b[7 * 2];
+    uint8_t c[32];
+    uint8_t bits[3] = {0xA5, 0x3C, 0x05};
+    uint8_t inner[10];
+    for (size_t i = 0; i < 7; i++)
+    {
+        b_values[i] = (uint16_t)(i * 0x1234 + 1);
+        b[2 * i] = (uint8_t)b_values[i];
+        b[2 * i + 1] = (uint8_t)(b_values[i] >> 8);
+    }
+    for (size_t i = 0; i < sizeof(c); i++)
+    {
+        c[i] = (uint8_t)(0xC0 + i);
+    }
+    for (size_t i = 0; i < sizeof(inner); i++)
+    {
+        inner[i] = (uint8_t)(0x50 + i);
+    }
+
+    size_t pos = 0;
+    memcpy(buf + pos, a, 8);
+    pos += 8;
+    size_t b_offset_pos = pos;
+    pos += 4;
+    memcpy(buf + pos, c, 32);
+    pos += 32;
+    size_t d_offset_pos = pos;
+    pos += 4;
+    size_t e_offset_pos = pos;
+    pos += 4;
+    buf[pos++] = 1;
+
+    put_offset(buf + b_offset_pos, pos);
+    memcpy(buf + pos, b, sizeof(b));
+    pos += sizeof(b);
+    put_offset(buf + d_offset_pos, pos);
+    size_t d_start = pos;
+    size_t inner_pos = 3 * SSZ_BYTES_PER_LENGTH_OFFSET;
+    for (size_t i = 0; i < 3; i++)
+    {
+        put_offset(buf + d_start + i * SSZ_BYTES_PER_LENGTH_OFFSET, inner_pos);
+        memcpy(buf + d_start + inner_pos, inner, inner_lengths[i]);
+        inner_pos += inner_lengths[i];
+    }
+    pos = d_start + inner_pos;
+    put_offset(buf + e_offset_pos, pos);
+    memcpy(buf + pos, bits, sizeof(bits));
+    pos += sizeof(bits);
+
+    uint8_t leaves[6 * SSZ_BYTES_PER_CHUNK] = {0};
+    memcpy(leaves, a, 8);
+    ssz_hash_tree_root_basic_list(b_values, sizeof(uint16_t), 7, 40, leaves + SSZ_BYTES_PER_CHUNK);
+    memcpy(leaves + 2 * SSZ_BYTES_PER_CHUNK, c, 32);
+    {
+        uint8_t inner_roots[3 * SSZ_BYTES_PER_CHUNK];
+        for (size_t i = 0; i < 3; i++)
+        {
+            ssz_hash_tree_root_basic_list(inner, 1, inner_lengths[i], 10, inner_roots + i * SSZ_BYTES_PER_CHUNK);
+        }
+        ssz_merkleize(inner_roots, 3, 4, leaves + 3 * SSZ_BYTES_PER_CHUNK);
+        ssz_mix_in_length(leaves + 3 * SSZ_BYTES_PER_CHUNK, 3, leaves + 3 * SSZ_BYTES_PER_CHUNK);
+    }
+    ssz_hash_tree_root_bitlist(bits, sizeof(bits), 20, leaves + 4 * SSZ_BYTES_PER_CHUNK, NULL);
+    leaves[5 * SSZ_BYTES_PER_CHUNK] = 1;
+    ssz_merkleize(leaves, 6, 6, expected_root);
+    return pos;
+}
+
+static void test_type_fixed_size(void)
+{
+    printf("\n--- Testing ssz_type_fixed_size ---\n");
+    static const ssz_type_desc_t *const checkpoint_fields[] = {&ssz_type_uint64, &bytes32_type};
+    static const ssz_type_desc_t checkpoint_type = {SSZ_TYPE_CONTAINER, 0, 2, NULL, checkpoint_fields};
+    static const ssz_type_desc_t bitvector_type = {SSZ_TYPE_BITVECTOR, 0, 12, NULL, NULL};
+    if (ssz_type_fixed_size(&checkpoint_type) == 40 && ssz_type_fixed_size(&bitvector_type) == 2 &&
+        ssz_type_fixed_size(&bytes32_type) == 32 && ssz_type_fixed_size(&sample_type) == 0 &&
+        ssz_type_fixed_size(&bitlist_type) == 0)
+    {
+        printf("  OK: Fixed sizes are correct.\n");
+    }
+    else
+    {
+        printf("  FAIL: Wrong fixed size.\n");
+    }
+}
+
+static void test_hash_tree_root_serialized(void)
+{
+    printf("\n--- Testing ssz_hash_tree_root_serialized ---\n");
+    uint8_t buf[256];
+    uint8_t expected[SSZ_BYTES_PER_CHUNK];
+    size_t len = build_sample(buf, expected);
+
+    printf("Testing a container with nested variable-size fields...\n");
+    {
+        uint8_t root[SSZ_BYTES_PER_CHUNK];
+        if (ssz_hash_tree_root_serialized(&sample_type, buf, len, root) == SSZ_SUCCESS &&
+            memcmp(root, expected, SSZ_BYTES_PER_CHUNK) == 0)
+        {
+            printf("  OK: Root matches field-by-field merkleization.\n");
+        }
+        else
+        {
+            printf("  FAIL: Root mismatch.\n");
+        }
+    }
+
+    printf("Testing a list of uint64...\n");
+    {
+        static const ssz_type_desc_t uint64_list_type = {SSZ_TYPE_LIST, 0, 100, &ssz_type_uint64, NULL};
+        uint64_t values[5] = {1, 2, 3, 0x0102030405060708ULL, UINT64_MAX};
+        uint8_t encoded[sizeof(values)];
+        for (size_t i = 0; i < 5; i++)
+        {
+            for (size_t b = 0; b < 8; b++)
+            {
+                encoded[i * 8 + b] = (uint8_t)(values[i] >> (8 * b));
+            }
+        }
+        uint8_t root[SSZ_BYTES_PER_CHUNK];
+        uint8_t list_expected[SSZ_BYTES_PER_CHUNK];
+        ssz_hash_tree_root_basic_list(values, sizeof(uint64_t), 5, 100, list_expected);
+        if (ssz_hash_tree_root_serialized(&uint64_list_type, encoded, sizeof(encoded), root) == SSZ_SUCCESS &&
+            memcmp(root, list_expected, SSZ_BYTES_PER_CHUNK) == 0)
+        {
+            printf("  OK: Root matches ssz_hash_tree_root_basic_list.\n");
+        }
+        else
+        {
+            printf("  FAIL: Root mismatch.\n");
+        }
+    }
+
+    printf("Testing malformed encodings => should fail...\n");
+    {
+        uint8_t bad[256];
+        uint8_t root[SSZ_BYTES_PER_CHUNK];
+        bool ok = true;
+
+        memcpy(bad, buf, len);
+        put_offset(bad + 8, 10);
+        ok = ok && ssz_hash_tree_root_serialized(&sample_type, bad, len, root) == SSZ_ERROR_INVALID_OFFSET;
+
+        memcpy(bad, buf, len);
+        put_offset(bad + 8 + 4 + 32, len + 1);
+        ok = ok && ssz_hash_tree_root_serialized(&sample_type, bad, len, root) == SSZ_ERROR_INVALID_OFFSET;
+
+        memcpy(bad, buf, len);
+        bad[8 + 4 + 32 + 4 + 4] = 2;
+        ok = ok && ssz_hash_tree_root_serialized(&sample_type, bad, len, root) == SSZ_ERROR_DESERIALIZATION;
+
+        memcpy(bad, buf, len);
+        bad[len - 1] = 0;
+        ok = ok && ssz_hash_tree_root_serialized(&sample_type, bad, len, root) == SSZ_ERROR_DESERIALIZATION;
+
+        ok = ok && ssz_hash_tree_root_serialized(&bytes32_type, buf, 31, root) == SSZ_ERROR_DESERIALIZATION;
+        ok = ok && ssz_hash_tree_root_serialized(&sample_type, buf, 20, root) == SSZ_ERROR_DESERIALIZATION;
+        if (ok)
+        {
+            printf("  OK: Malformed encodings rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Malformed encoding was not rejected.\n");
+        }
+    }
+}
+
+int main(void)
+{
+    test_type_fixed_size();
+    test_hash_tree_root_serialized();
+
+    return 0;
+}
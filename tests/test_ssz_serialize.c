@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include "ssz_serialize.h"
 #include "ssz_types.h"
+#include "ssz_generator.h"
 
 static void test_serialize_uintN(void)
 {
@@ -1286,6 +1287,88 @@ static void test_serialize_list_bool(void)
     }
 }
 
+#define PARALLEL_ELEMENT_SIZE (SSZ_BYTE_SIZE_OF_UINT64 + 1 + 32)
+#define PARALLEL_ELEMENT_COUNT 20011
+
+typedef struct
+{
+    uint64_t balance;
+    bool slashed;
+    uint8_t root[32];
+} ParallelElement;
+
+typedef struct
+{
+    uint64_t length;
+    ParallelElement *data;
+} ParallelElements;
+
+#define SERIALIZE_PARALLEL_ELEMENT_FIELDS                                                          \
+    SERIALIZE_BASIC_FIELD(obj, offset, balance, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64); \
+    SERIALIZE_BASIC_FIELD(obj, offset, slashed, 1, ssz_serialize_boolean);                      \
+    SERIALIZE_VECTOR_FIELD(obj, offset, root, 32, ssz_serialize_vector_uint8);
+DEFINE_SERIALIZE_CONTAINER(ParallelElement, SERIALIZE_PARALLEL_ELEMENT_FIELDS);
+DEFINE_SERIALIZE_LIST(ParallelElements, ParallelElement, PARALLEL_ELEMENT_SIZE, serialize_ParallelElement);
+DEFINE_SERIALIZE_LIST_PARALLEL(ParallelElements, ParallelElement, PARALLEL_ELEMENT_SIZE, serialize_ParallelElement);
+
+static void test_serialize_list_parallel(void)
+{
+    printf("\n--- Testing parallel serialization of fixed-size lists ---\n");
+    size_t total = (size_t)PARALLEL_ELEMENT_COUNT * PARALLEL_ELEMENT_SIZE;
+    ParallelElements list;
+    list.length = PARALLEL_ELEMENT_COUNT;
+    list.data = malloc(PARALLEL_ELEMENT_COUNT * sizeof(ParallelElement));
+    uint8_t *expected = malloc(total);
+    uint8_t *actual = malloc(total);
+    if (list.data == NULL || expected == NULL || actual == NULL)
+    {
+        printf("  FAIL: Could not allocate %d elements.\n", PARALLEL_ELEMENT_COUNT);
+        free(list.data);
+        free(expected);
+        free(actual);
+        return;
+    }
+    for (size_t i = 0; i < PARALLEL_ELEMENT_COUNT; i++)
+    {
+        list.data[i].balance = 32000000000ull + i * 977;
+        list.data[i].slashed = i % 7 == 0;
+        memset(list.data[i].root, (int)(i * 13), sizeof(list.data[i].root));
+    }
+    size_t expected_size = total;
+    bool ok = serialize_ParallelElements(&list, expected, &expected_size) == SSZ_SUCCESS && expected_size == total;
+
+    static const unsigned int thread_counts[] = {0, 1, 2, 3, 7, 100};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++)
+    {
+        printf("Testing %d elements with %u threads...\n", PARALLEL_ELEMENT_COUNT, thread_counts[t]);
+        memset(actual, 0xEE, total);
+        size_t actual_size = total;
+        if (ok && serialize_ParallelElements_parallel(&list, thread_counts[t], actual, &actual_size) == SSZ_SUCCESS &&
+            actual_size == total && memcmp(actual, expected, total) == 0)
+        {
+            printf("  OK: Output matches serialize_ParallelElements.\n");
+        }
+        else
+        {
+            printf("  FAIL: Parallel output differs from serialize_ParallelElements.\n");
+        }
+    }
+
+    printf("Testing a short output buffer is rejected...\n");
+    size_t short_size = total - 1;
+    if (serialize_ParallelElements_parallel(&list, 4, actual, &short_size) == SSZ_ERROR_SERIALIZATION)
+    {
+        printf("  OK: Short buffer rejected.\n");
+    }
+    else
+    {
+        printf("  FAIL: Short buffer accepted.\n");
+    }
+    free(list.data);
+    free(expected);
+    free(actual);
+}
+
 int main(void)
 {
     test_serialize_uintN();
@@ -1307,6 +1390,7 @@ int main(void)
     test_serialize_list_uint128();
     test_serialize_list_uint256();
     test_serialize_list_bool();
+    test_serialize_list_parallel();
 
     return 0;
 }
\ No newline at end of file
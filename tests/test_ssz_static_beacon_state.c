@@ -12,6 +12,7 @@
 #include "ssz_constants.h"
 #include "ssz_generator.h"
 #include "ssz_merkle.h"
+#include "ssz_schema.h"
 #include "yaml_parser.h"
 
 #ifndef TESTS_DIR
@@ -77,7 +78,7 @@
 #define JUSTIFICATION_BITS_LENGTH 4
 #define SLOTS_PER_EPOCH 32
 #define EPOCHS_PER_ETH1_VOTING_PERIOD 64
-#define MAX_VALIDATORS_PER_COMMITTEE 128
+#define MAX_VALIDATORS_PER_COMMITTEE 2048
 #if SIZE_MAX < 1099511627776ULL
   #define VALIDATOR_REGISTRY_LIMIT SIZE_MAX
 #else
@@ -151,11 +152,7 @@ typedef struct
     uint8_t root[SIZE_ROOT];
 } Checkpoint;
 
-typedef struct
-{
-    uint64_t length;
-    bool *data;
-} AggregationBits;
+typedef ssz_bitfield_t AggregationBits;
 
 typedef struct
 {
@@ -217,6 +214,12 @@ DEFINE_SERIALIZE_CONTAINER(Fork, SERIALIZE_FORK_FIELDS);
     DESERIALIZE_BASIC_FIELD(obj, offset, epoch, ssz_deserialize_uint64);
 DEFINE_DESERIALIZE_CONTAINER(Fork, DESERIALIZE_FORK_FIELDS);
 
+#define HTR_FORK_FIELDS \
+    HTR_VECTOR_FIELD(obj, leaf, previous_version, 1); \
+    HTR_VECTOR_FIELD(obj, leaf, current_version, 1); \
+    HTR_BASIC_FIELD(obj, leaf, epoch);
+DEFINE_HASH_TREE_ROOT_CONTAINER(Fork, 3, HTR_FORK_FIELDS);
+
 #define SERIALIZE_BEACON_BLOCK_HEADER_FIELDS                                                           \
     SERIALIZE_BASIC_FIELD(obj, offset, slot, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);           \
     SERIALIZE_BASIC_FIELD(obj, offset, proposer_index, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64); \
@@ -233,6 +236,14 @@ DEFINE_SERIALIZE_CONTAINER(BeaconBlockHeader, SERIALIZE_BEACON_BLOCK_HEADER_FIEL
     DESERIALIZE_VECTOR_FIELD(obj, offset, body_root, ssz_deserialize_vector_uint8);
 DEFINE_DESERIALIZE_CONTAINER(BeaconBlockHeader, DESERIALIZE_BEACON_BLOCK_HEADER_FIELDS);
 
+#define HTR_BEACON_BLOCK_HEADER_FIELDS \
+    HTR_BASIC_FIELD(obj, leaf, slot); \
+    HTR_BASIC_FIELD(obj, leaf, proposer_index); \
+    HTR_VECTOR_FIELD(obj, leaf, parent_root, 1); \
+    HTR_VECTOR_FIELD(obj, leaf, state_root, 1); \
+    HTR_VECTOR_FIELD(obj, leaf, body_root, 1);
+DEFINE_HASH_TREE_ROOT_CONTAINER(BeaconBlockHeader, 5, HTR_BEACON_BLOCK_HEADER_FIELDS);
+
 #define SERIALIZE_ETH1DATA_FIELD                                                                      \
     SERIALIZE_VECTOR_FIELD(obj, offset, deposit_root, SIZE_ROOT, ssz_serialize_vector_uint8);         \
     SERIALIZE_BASIC_FIELD(obj, offset, deposit_count, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64); \
@@ -247,6 +258,12 @@ DEFINE_SERIALIZE_LIST(Eth1DataVotes, Eth1Data, SIZE_ETH1_DATA, serialize_Eth1Dat
 DEFINE_DESERIALIZE_CONTAINER(Eth1Data, DESERIALIZE_ETH1DATA_FIELD);
 DEFINE_DESERIALIZE_LIST(Eth1DataVotes, Eth1Data, SIZE_ETH1_DATA, deserialize_Eth1Data);
 
+#define HTR_ETH1DATA_FIELD \
+    HTR_VECTOR_FIELD(obj, leaf, deposit_root, 1); \
+    HTR_BASIC_FIELD(obj, leaf, deposit_count); \
+    HTR_VECTOR_FIELD(obj, leaf, block_hash, 1);
+DEFINE_HASH_TREE_ROOT_CONTAINER(Eth1Data, 3, HTR_ETH1DATA_FIELD);
+
 #define SERIALIZE_VALIDATOR_FIELD                                                                                    \
     SERIALIZE_VECTOR_FIELD(obj, offset, pubkey, SIZE_BLS_PUBKEY, ssz_serialize_vector_uint8);                        \
     SERIALIZE_VECTOR_FIELD(obj, offset, withdrawal_credentials, SIZE_ROOT, ssz_serialize_vector_uint8);              \
@@ -271,6 +288,17 @@ DEFINE_SERIALIZE_LIST(Validators, Validator, SIZE_VALIDATOR, serialize_Validator
 DEFINE_DESERIALIZE_CONTAINER(Validator, DESERIALIZE_VALIDATOR_FIELD);
 DEFINE_DESERIALIZE_LIST(Validators, Validator, SIZE_VALIDATOR, deserialize_Validator);
 
+#define HTR_VALIDATOR_FIELD \
+    HTR_VECTOR_FIELD(obj, leaf, pubkey, 1); \
+    HTR_VECTOR_FIELD(obj, leaf, withdrawal_credentials, 1); \
+    HTR_BASIC_FIELD(obj, leaf, effective_balance); \
+    HTR_BASIC_FIELD(obj, leaf, slashed); \
+    HTR_BASIC_FIELD(obj, leaf, activation_eligibility_epoch); \
+    HTR_BASIC_FIELD(obj, leaf, activation_epoch); \
+    HTR_BASIC_FIELD(obj, leaf, exit_epoch); \
+    HTR_BASIC_FIELD(obj, leaf, withdrawable_epoch);
+DEFINE_HASH_TREE_ROOT_CONTAINER(Validator, 8, HTR_VALIDATOR_FIELD);
+
 #define SERIALIZE_CHECKPOINT_FIELD                                                            \
     SERIALIZE_BASIC_FIELD(obj, offset, epoch, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64); \
     SERIALIZE_VECTOR_FIELD(obj, offset, root, SIZE_ROOT, ssz_serialize_vector_uint8);
@@ -281,6 +309,11 @@ DEFINE_SERIALIZE_CONTAINER(Checkpoint, SERIALIZE_CHECKPOINT_FIELD);
     DESERIALIZE_VECTOR_FIELD(obj, offset, root, ssz_deserialize_vector_uint8);
 DEFINE_DESERIALIZE_CONTAINER(Checkpoint, DESERIALIZE_CHECKPOINT_FIELD);
 
+#define HTR_CHECKPOINT_FIELD \
+    HTR_BASIC_FIELD(obj, leaf, epoch); \
+    HTR_VECTOR_FIELD(obj, leaf, root, 1);
+DEFINE_HASH_TREE_ROOT_CONTAINER(Checkpoint, 2, HTR_CHECKPOINT_FIELD);
+
 #define SERIALIZE_ATTESTATION_DATA_FIELD                                                           \
     SERIALIZE_BASIC_FIELD(obj, offset, slot, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);       \
     SERIALIZE_BASIC_FIELD(obj, offset, index, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);      \
@@ -297,6 +330,14 @@ DEFINE_SERIALIZE_CONTAINER(AttestationData, SERIALIZE_ATTESTATION_DATA_FIELD);
     DESERIALIZE_CONTAINER_FIELD(obj, offset, target, deserialize_Checkpoint, SIZE_CHECKPOINT);
 DEFINE_DESERIALIZE_CONTAINER(AttestationData, DESERIALIZE_ATTESTATION_DATA_FIELD);
 
+#define HTR_ATTESTATION_DATA_FIELD \
+    HTR_BASIC_FIELD(obj, leaf, slot); \
+    HTR_BASIC_FIELD(obj, leaf, index); \
+    HTR_VECTOR_FIELD(obj, leaf, beacon_block_root, 1); \
+    HTR_CONTAINER_FIELD(obj, leaf, source, hash_tree_root_Checkpoint); \
+    HTR_CONTAINER_FIELD(obj, leaf, target, hash_tree_root_Checkpoint);
+DEFINE_HASH_TREE_ROOT_CONTAINER(AttestationData, 5, HTR_ATTESTATION_DATA_FIELD);
+
 #define SERIALIZE_PENDING_ATTESTATION_FIELD                                                                  \
     do                                                                                                       \
     {                                                                                                        \
@@ -307,7 +348,7 @@ DEFINE_DESERIALIZE_CONTAINER(AttestationData, DESERIALIZE_ATTESTATION_DATA_FIELD
         SERIALIZE_CONTAINER_FIELD(obj, offset, data, serialize_AttestationData, SIZE_ATTESTATION_DATA);      \
         SERIALIZE_BASIC_FIELD(obj, offset, inclusion_delay, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);  \
         SERIALIZE_BASIC_FIELD(obj, offset, proposer_index, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);   \
-        SERIALIZE_BITLIST_FIELD(obj, offset, aggregation_bits, MAX_VALIDATORS_PER_COMMITTEE);                \
+        SERIALIZE_BITFIELD_LIST_FIELD(obj, offset, aggregation_bits, MAX_VALIDATORS_PER_COMMITTEE);          \
     } while (0);
 DEFINE_SERIALIZE_CONTAINER(PendingAttestation, SERIALIZE_PENDING_ATTESTATION_FIELD);
 
@@ -318,9 +359,162 @@ DEFINE_SERIALIZE_CONTAINER(PendingAttestation, SERIALIZE_PENDING_ATTESTATION_FIE
     DESERIALIZE_BASIC_FIELD(obj, offset, inclusion_delay, ssz_deserialize_uint64);                      \
     DESERIALIZE_BASIC_FIELD(obj, offset, proposer_index, ssz_deserialize_uint64);                       \
     size_t agg_bits_size = data_size - agg_bits_offset;                                                 \
-    DESERIALIZE_BITLIST_FIELD(obj, agg_bits_offset, agg_bits_size, aggregation_bits, MAX_VALIDATORS_PER_COMMITTEE);
+    DESERIALIZE_BITFIELD_LIST_FIELD(obj, agg_bits_offset, agg_bits_size, aggregation_bits, MAX_VALIDATORS_PER_COMMITTEE);
 DEFINE_DESERIALIZE_CONTAINER(PendingAttestation, DESERIALIZE_PENDING_ATTESTATION_FIELD);
 
+#define HTR_PENDING_ATTESTATION_FIELD \
+    HTR_BITFIELD_LIST_FIELD(obj, leaf, aggregation_bits, MAX_VALIDATORS_PER_COMMITTEE); \
+    HTR_CONTAINER_FIELD(obj, leaf, data, hash_tree_root_AttestationData); \
+    HTR_BASIC_FIELD(obj, leaf, inclusion_delay); \
+    HTR_BASIC_FIELD(obj, leaf, proposer_index);
+DEFINE_HASH_TREE_ROOT_CONTAINER(PendingAttestation, 4, HTR_PENDING_ATTESTATION_FIELD);
+
+#define SIZE_PENDING_ATTESTATION_FIELDS \
+    SIZE_BITLIST_FIELD(obj, size, aggregation_bits);
+DEFINE_SSZ_SIZE_CONTAINER(PendingAttestation, SIZE_PENDING_ATTESTATION_FIXED, SIZE_PENDING_ATTESTATION_FIELDS);
+
+#define SIZE_BEACON_STATE_FIELDS                                                                             \
+    SIZE_LIST_FIELD(obj, size, historical_roots, SIZE_ROOT);                                                 \
+    SIZE_LIST_FIELD(obj, size, eth1_data_votes, SIZE_ETH1_DATA);                                             \
+    SIZE_LIST_FIELD(obj, size, validators, SIZE_VALIDATOR);                                                  \
+    SIZE_LIST_FIELD(obj, size, balances, SIZE_GWEI);                                                         \
+    SIZE_LIST_VARIABLE_CONTAINER_FIELD(obj, size, previous_epoch_attestations, ssz_size_PendingAttestation); \
+    SIZE_LIST_VARIABLE_CONTAINER_FIELD(obj, size, current_epoch_attestations, ssz_size_PendingAttestation);
+DEFINE_SSZ_SIZE_CONTAINER(BeaconState, SIZE_BEACON_STATE, SIZE_BEACON_STATE_FIELDS);
+
+ssz_error_t serialize_BeaconState_object(const BeaconState *state, unsigned char *out_buf, size_t *out_size);
+DEFINE_SERIALIZE_WRITER(BeaconState, serialize_BeaconState_object, ssz_size_BeaconState);
+
+#define EMIT_BEACON_STATE_FIELDS                                                                           \
+    uint32_t variable_offset = SIZE_BEACON_STATE;                                                          \
+    size_t previous_epoch_attestations_size = 0;                                                           \
+    size_t current_epoch_attestations_size = 0;                                                            \
+    SIZE_LIST_VARIABLE_CONTAINER_FIELD(obj, previous_epoch_attestations_size, previous_epoch_attestations, \
+                                       ssz_size_PendingAttestation);                                       \
+    SIZE_LIST_VARIABLE_CONTAINER_FIELD(obj, current_epoch_attestations_size, current_epoch_attestations,   \
+                                       ssz_size_PendingAttestation);                                       \
+    EMIT_BASIC_FIELD(obj, genesis_time, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);                    \
+    EMIT_VECTOR_FIELD(obj, genesis_validators_root, 1);                                                    \
+    EMIT_BASIC_FIELD(obj, slot, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);                            \
+    EMIT_CONTAINER_FIELD(obj, fork, serialize_Fork, SIZE_FORK);                                            \
+    EMIT_CONTAINER_FIELD(obj, latest_block_header, serialize_BeaconBlockHeader, SIZE_BEACON_BLOCK_HEADER); \
+    EMIT_VECTOR_FIELD(obj, block_roots, 1);                                                                \
+    EMIT_VECTOR_FIELD(obj, state_roots, 1);                                                                \
+    EMIT_OFFSET_FIELD(variable_offset, obj->historical_roots.length * SIZE_ROOT);                          \
+    EMIT_CONTAINER_FIELD(obj, eth1_data, serialize_Eth1Data, SIZE_ETH1_DATA);                              \
+    EMIT_OFFSET_FIELD(variable_offset, obj->eth1_data_votes.length * SIZE_ETH1_DATA);                      \
+    EMIT_BASIC_FIELD(obj, eth1_deposit_index, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64);              \
+    EMIT_OFFSET_FIELD(variable_offset, obj->validators.length * SIZE_VALIDATOR);                           \
+    EMIT_OFFSET_FIELD(variable_offset, obj->balances.length * SIZE_GWEI);                                  \
+    EMIT_VECTOR_FIELD(obj, randao_mixes, 1);                                                               \
+    EMIT_VECTOR_FIELD(obj, slashings, SSZ_BYTE_SIZE_OF_UINT64);                                            \
+    EMIT_OFFSET_FIELD(variable_offset, previous_epoch_attestations_size);                                  \
+    EMIT_OFFSET_FIELD(variable_offset, current_epoch_attestations_size);                                   \
+    EMIT_BITVECTOR_FIELD(obj, justification_bits, JUSTIFICATION_BITS_LENGTH);                              \
+    EMIT_CONTAINER_FIELD(obj, previous_justified_checkpoint, serialize_Checkpoint, SIZE_CHECKPOINT);       \
+    EMIT_CONTAINER_FIELD(obj, current_justified_checkpoint, serialize_Checkpoint, SIZE_CHECKPOINT);        \
+    EMIT_CONTAINER_FIELD(obj, finalized_checkpoint, serialize_Checkpoint, SIZE_CHECKPOINT);                \
+    EMIT_LIST_FIELD(obj, historical_roots, SIZE_ROOT);                                                     \
+    EMIT_LIST_CONTAINER_FIELD(obj, eth1_data_votes, serialize_Eth1Data, SIZE_ETH1_DATA);                   \
+    EMIT_LIST_CONTAINER_FIELD(obj, validators, serialize_Validator, SIZE_VALIDATOR);                       \
+    EMIT_LIST_FIELD(obj, balances, SIZE_GWEI);                                                             \
+    EMIT_LIST_VARIABLE_CONTAINER_FIELD(obj, previous_epoch_attestations, serialize_PendingAttestation,     \
+                                      ssz_size_PendingAttestation);                                        \
+    EMIT_LIST_VARIABLE_CONTAINER_FIELD(obj, current_epoch_attestations, serialize_PendingAttestation,      \
+                                      ssz_size_PendingAttestation);
+DEFINE_SERIALIZE_IOV(BeaconState, EMIT_BEACON_STATE_FIELDS);
+DEFINE_SERIALIZE_STREAM(BeaconState, EMIT_BEACON_STATE_FIELDS);
+
+typedef struct
+{
+    const unsigned char *expected;
+    size_t expected_size;
+    size_t position;
+    size_t largest_write;
+} StreamCheck;
+
+static ssz_error_t check_stream_write(void *ctx, const uint8_t *bytes, size_t len)
+{
+    StreamCheck *check = ctx;
+    if (len > check->expected_size - check->position ||
+        memcmp(bytes, check->expected + check->position, len) != 0)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    check->position += len;
+    check->largest_write = len > check->largest_write ? len : check->largest_write;
+    return SSZ_SUCCESS;
+}
+
+static ssz_root_cache_t validator_root_cache;
+static ssz_arena_t writer_arena;
+
+#define HTR_BEACON_STATE_FIELDS \
+    HTR_BASIC_FIELD(obj, leaf, genesis_time); \
+    HTR_VECTOR_FIELD(obj, leaf, genesis_validators_root, 1); \
+    HTR_BASIC_FIELD(obj, leaf, slot); \
+    HTR_CONTAINER_FIELD(obj, leaf, fork, hash_tree_root_Fork); \
+    HTR_CONTAINER_FIELD(obj, leaf, latest_block_header, hash_tree_root_BeaconBlockHeader); \
+    HTR_VECTOR_FIELD(obj, leaf, block_roots, 1); \
+    HTR_VECTOR_FIELD(obj, leaf, state_roots, 1); \
+    HTR_LIST_FIELD(obj, leaf, historical_roots, SIZE_ROOT, HISTORICAL_ROOTS_LENGTH); \
+    HTR_CONTAINER_FIELD(obj, leaf, eth1_data, hash_tree_root_Eth1Data); \
+    HTR_LIST_CONTAINER_FIELD(obj, leaf, eth1_data_votes, hash_tree_root_Eth1Data, EPOCHS_PER_ETH1_VOTING_PERIOD * SLOTS_PER_EPOCH); \
+    HTR_BASIC_FIELD(obj, leaf, eth1_deposit_index); \
+    HTR_LIST_CONTAINER_FIELD_CACHED(obj, leaf, validators, hash_tree_root_Validator, serialize_Validator, SIZE_VALIDATOR, VALIDATOR_REGISTRY_LIMIT, &validator_root_cache); \
+    HTR_LIST_FIELD(obj, leaf, balances, SIZE_GWEI, VALIDATOR_REGISTRY_LIMIT); \
+    HTR_VECTOR_FIELD(obj, leaf, randao_mixes, 1); \
+    HTR_VECTOR_FIELD(obj, leaf, slashings, SIZE_GWEI); \
+    HTR_LIST_CONTAINER_FIELD(obj, leaf, previous_epoch_attestations, hash_tree_root_PendingAttestation, MAX_ATTESTATIONS * SLOTS_PER_EPOCH); \
+    HTR_LIST_CONTAINER_FIELD(obj, leaf, current_epoch_attestations, hash_tree_root_PendingAttestation, MAX_ATTESTATIONS * SLOTS_PER_EPOCH); \
+    HTR_BITVECTOR_FIELD(obj, leaf, justification_bits, JUSTIFICATION_BITS_LENGTH); \
+    HTR_CONTAINER_FIELD(obj, leaf, previous_justified_checkpoint, hash_tree_root_Checkpoint); \
+    HTR_CONTAINER_FIELD(obj, leaf, current_justified_checkpoint, hash_tree_root_Checkpoint); \
+    HTR_CONTAINER_FIELD(obj, leaf, finalized_checkpoint, hash_tree_root_Checkpoint);
+DEFINE_HASH_TREE_ROOT_CONTAINER(BeaconState, 21, HTR_BEACON_STATE_FIELDS);
+
+static const ssz_type_desc_t version_type = {SSZ_TYPE_VECTOR, 0, SIZE_VERSION, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t root_type = {SSZ_TYPE_VECTOR, 0, SIZE_ROOT, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t pubkey_type = {SSZ_TYPE_VECTOR, 0, SIZE_BLS_PUBKEY, &ssz_type_uint8, NULL};
+static const ssz_type_desc_t *const fork_fields[] = {&version_type, &version_type, &ssz_type_uint64};
+static const ssz_type_desc_t fork_type = {SSZ_TYPE_CONTAINER, 0, 3, NULL, fork_fields};
+static const ssz_type_desc_t *const beacon_block_header_fields[] = {
+    &ssz_type_uint64, &ssz_type_uint64, &root_type, &root_type, &root_type};
+static const ssz_type_desc_t beacon_block_header_type = {SSZ_TYPE_CONTAINER, 0, 5, NULL, beacon_block_header_fields};
+static const ssz_type_desc_t *const eth1_data_fields[] = {&root_type, &ssz_type_uint64, &root_type};
+static const ssz_type_desc_t eth1_data_type = {SSZ_TYPE_CONTAINER, 0, 3, NULL, eth1_data_fields};
+static const ssz_type_desc_t *const validator_fields[] = {
+    &pubkey_type, &root_type, &ssz_type_uint64, &ssz_type_boolean,
+    &ssz_type_uint64, &ssz_type_uint64, &ssz_type_uint64, &ssz_type_uint64};
+static const ssz_type_desc_t validator_type = {SSZ_TYPE_CONTAINER, 0, 8, NULL, validator_fields};
+static const ssz_type_desc_t *const checkpoint_fields[] = {&ssz_type_uint64, &root_type};
+static const ssz_type_desc_t checkpoint_type = {SSZ_TYPE_CONTAINER, 0, 2, NULL, checkpoint_fields};
+static const ssz_type_desc_t *const attestation_data_fields[] = {
+    &ssz_type_uint64, &ssz_type_uint64, &root_type, &checkpoint_type, &checkpoint_type};
+static const ssz_type_desc_t attestation_data_type = {SSZ_TYPE_CONTAINER, 0, 5, NULL, attestation_data_fields};
+static const ssz_type_desc_t aggregation_bits_type = {SSZ_TYPE_BITLIST, 0, MAX_VALIDATORS_PER_COMMITTEE, NULL, NULL};
+static const ssz_type_desc_t *const pending_attestation_fields[] = {
+    &aggregation_bits_type, &attestation_data_type, &ssz_type_uint64, &ssz_type_uint64};
+static const ssz_type_desc_t pending_attestation_type = {SSZ_TYPE_CONTAINER, 0, 4, NULL, pending_attestation_fields};
+static const ssz_type_desc_t slot_roots_type = {SSZ_TYPE_VECTOR, 0, SLOTS_PER_HISTORICAL_ROOT, &root_type, NULL};
+static const ssz_type_desc_t historical_roots_list_type = {SSZ_TYPE_LIST, 0, HISTORICAL_ROOTS_LENGTH, &root_type, NULL};
+static const ssz_type_desc_t eth1_data_votes_type = {
+    SSZ_TYPE_LIST, 0, EPOCHS_PER_ETH1_VOTING_PERIOD * SLOTS_PER_EPOCH, &eth1_data_type, NULL};
+static const ssz_type_desc_t validators_type = {SSZ_TYPE_LIST, 0, VALIDATOR_REGISTRY_LIMIT, &validator_type, NULL};
+static const ssz_type_desc_t balances_type = {SSZ_TYPE_LIST, 0, VALIDATOR_REGISTRY_LIMIT, &ssz_type_uint64, NULL};
+static const ssz_type_desc_t randao_mixes_type = {SSZ_TYPE_VECTOR, 0, EPOCHS_PER_HISTORICAL_VECTOR, &root_type, NULL};
+static const ssz_type_desc_t slashings_type = {SSZ_TYPE_VECTOR, 0, EPOCHS_PER_SLASHINGS_VECTOR, &ssz_type_uint64, NULL};
+static const ssz_type_desc_t epoch_attestations_type = {
+    SSZ_TYPE_LIST, 0, MAX_ATTESTATIONS * SLOTS_PER_EPOCH, &pending_attestation_type, NULL};
+static const ssz_type_desc_t justification_bits_type = {SSZ_TYPE_BITVECTOR, 0, JUSTIFICATION_BITS_LENGTH, NULL, NULL};
+static const ssz_type_desc_t *const beacon_state_fields[] = {
+    &ssz_type_uint64, &root_type, &ssz_type_uint64, &fork_type, &beacon_block_header_type,
+    &slot_roots_type, &slot_roots_type, &historical_roots_list_type, &eth1_data_type,
+    &eth1_data_votes_type, &ssz_type_uint64, &validators_type, &balances_type, &randao_mixes_type,
+    &slashings_type, &epoch_attestations_type, &epoch_attestations_type, &justification_bits_type,
+    &checkpoint_type, &checkpoint_type, &checkpoint_type};
+static const ssz_type_desc_t beacon_state_type = {SSZ_TYPE_CONTAINER, 0, 21, NULL, beacon_state_fields};
+
 typedef struct
 {
     char folder_name[256];
@@ -666,7 +860,18 @@ void process_serialized_file(const char *folder_name, const char *folder_path, c
         printf("Successfully deserialized BeaconState for folder %s\n", folder_path);
     }
 
-    unsigned char *serialized_data = malloc(data_size);
+    size_t exact_size = ssz_size_BeaconState(state);
+    if (exact_size != data_size)
+    {
+        printf("The computed serialized size %zu does not match %zu bytes for folder %s\n", exact_size, data_size, folder_path);
+    }
+    else
+    {
+        printf("The computed serialized size matches for folder %s\n", folder_path);
+    }
+
+    size_t alloc_size = exact_size > data_size ? exact_size : data_size;
+    unsigned char *serialized_data = malloc(alloc_size);
     if (!serialized_data)
     {
         fprintf(stderr, "Failed to allocate memory for serialized data\n");
@@ -674,7 +879,7 @@ void process_serialized_file(const char *folder_name, const char *folder_path, c
         return;
     }
 
-    size_t serialized_size;
+    size_t serialized_size = exact_size;
     ssz_error_t err2 = serialize_BeaconState_object(state, serialized_data, &serialized_size);
     if (err2 != SSZ_SUCCESS)
     {
@@ -685,7 +890,12 @@ void process_serialized_file(const char *folder_name, const char *folder_path, c
         printf("Successfully serialized BeaconState for folder %s\n", folder_path);
     }
 
-    if (memcmp(data, serialized_data, data_size) != 0)
+    if (err2 == SSZ_SUCCESS && serialized_size != data_size)
+    {
+        printf("The original serialized data and computed serialized data differ in size (%zu vs %zu) for folder %s\n",
+               data_size, serialized_size, folder_path);
+    }
+    else if (memcmp(data, serialized_data, data_size) != 0)
     {
         printf("The original serialized data and computed serialized data are not the same for folder %s\n", folder_path);
 
@@ -720,16 +930,134 @@ void process_serialized_file(const char *folder_name, const char *folder_path, c
         printf("The original serialized data and computed serialized data are the same for folder %s\n", folder_path);
     }
 
+    ssz_arena_reset(&writer_arena);
+    ssz_writer_t writer;
+    if (ssz_writer_init_chunked(&writer, &writer_arena, 1 << 16) == SSZ_SUCCESS &&
+        serialize_BeaconState_to_writer(state, &writer) == SSZ_SUCCESS &&
+        ssz_writer_size(&writer) == data_size)
+    {
+        size_t copied_size = alloc_size;
+        bool same = ssz_writer_copy(&writer, serialized_data, &copied_size) == SSZ_SUCCESS &&
+                    copied_size == data_size && memcmp(serialized_data, data, data_size) == 0;
+        printf("The data serialized through an ssz_writer_t is %s for folder %s\n",
+               same ? "the same" : "not the same", folder_path);
+    }
+    else
+    {
+        printf("Failed to serialize BeaconState through an ssz_writer_t for folder %s\n", folder_path);
+    }
+
+    ssz_arena_reset(&writer_arena);
+    ssz_iov_t iov;
+    ssz_iov_init(&iov, &writer_arena, 0);
+    if (serialize_BeaconState_to_iov(state, &iov) == SSZ_SUCCESS && iov.size == data_size)
+    {
+        bool referenced = false;
+        for (size_t i = 0; i < iov.count; i++)
+        {
+            if (iov.entries[i].iov_base == (void *)state->randao_mixes)
+            {
+                referenced = true;
+            }
+        }
+        size_t copied_size = alloc_size;
+        bool same = ssz_iov_copy(&iov, serialized_data, &copied_size) == SSZ_SUCCESS &&
+                    copied_size == data_size && memcmp(serialized_data, data, data_size) == 0;
+        printf("The data serialized through an ssz_iov_t (%zu entries, randao_mixes %s) is %s for folder %s\n",
+               iov.count, referenced ? "referenced in place" : "not referenced in place",
+               same && referenced ? "the same" : "not the same", folder_path);
+    }
+    else
+    {
+        printf("Failed to serialize BeaconState through an ssz_iov_t for folder %s\n", folder_path);
+    }
+
+    static uint8_t stream_buf[4096];
+    StreamCheck check = {data, data_size, 0, 0};
+    ssz_writer_init_stream(&writer, stream_buf, sizeof(stream_buf), check_stream_write, &check);
+    if (serialize_BeaconState_to_stream(state, &writer) == SSZ_SUCCESS && ssz_writer_flush(&writer) == SSZ_SUCCESS)
+    {
+        printf("The data streamed through a %zu-byte ssz_writer_t is %s for folder %s\n", sizeof(stream_buf),
+               check.position == data_size && check.largest_write <= sizeof(stream_buf) ? "the same" : "not the same",
+               folder_path);
+    }
+    else
+    {
+        printf("The data streamed through a %zu-byte ssz_writer_t is not the same from byte %zu for folder %s\n",
+               sizeof(stream_buf), check.position, folder_path);
+    }
+
+    char roots_yaml_path[1024];
+    snprintf(roots_yaml_path, sizeof(roots_yaml_path), "%s/roots.yaml", folder_path);
+    size_t expected_root_size = 0;
+    uint8_t *expected_root = read_yaml_field(roots_yaml_path, "root", &expected_root_size);
+    uint8_t root[SSZ_BYTES_PER_CHUNK];
+    if (err1 != SSZ_SUCCESS || !expected_root || expected_root_size != SSZ_BYTES_PER_CHUNK)
+    {
+        printf("Skipping hash_tree_root check for folder %s: no usable root in roots.yaml\n", folder_path);
+    }
+    else if (hash_tree_root_BeaconState(state, root) != SSZ_SUCCESS)
+    {
+        printf("Failed to compute hash_tree_root for folder %s\n", folder_path);
+    }
+    else if (memcmp(root, expected_root, SSZ_BYTES_PER_CHUNK) != 0)
+    {
+        printf("The computed hash_tree_root does not match roots.yaml for folder %s\n", folder_path);
+        printf("Expected root: ");
+        print_hex(expected_root, SSZ_BYTES_PER_CHUNK);
+        printf("Computed root: ");
+        print_hex(root, SSZ_BYTES_PER_CHUNK);
+    }
+    else
+    {
+        printf("The computed hash_tree_root matches roots.yaml for folder %s\n", folder_path);
+        uint64_t hits_before, hits_after;
+        uint8_t cached_root[SSZ_BYTES_PER_CHUNK];
+        ssz_root_cache_stats(&validator_root_cache, &hits_before, NULL, NULL);
+        ssz_error_t cached_err = hash_tree_root_BeaconState(state, cached_root);
+        ssz_root_cache_stats(&validator_root_cache, &hits_after, NULL, NULL);
+        if (cached_err == SSZ_SUCCESS && memcmp(cached_root, expected_root, SSZ_BYTES_PER_CHUNK) == 0 &&
+            hits_after - hits_before == state->validators.length)
+        {
+            printf("The hash_tree_root recomputed from cached validator roots matches for folder %s\n", folder_path);
+        }
+        else
+        {
+            printf("The hash_tree_root recomputed from cached validator roots does not match for folder %s\n", folder_path);
+        }
+    }
+    if (expected_root && expected_root_size == SSZ_BYTES_PER_CHUNK)
+    {
+        if (ssz_hash_tree_root_serialized(&beacon_state_type, data, data_size, root) == SSZ_SUCCESS &&
+            memcmp(root, expected_root, SSZ_BYTES_PER_CHUNK) == 0)
+        {
+            printf("The hash_tree_root of the serialized bytes matches roots.yaml for folder %s\n", folder_path);
+        }
+        else
+        {
+            printf("The hash_tree_root of the serialized bytes does not match roots.yaml for folder %s\n", folder_path);
+        }
+    }
+    free(expected_root);
+
     free(data);
     free(serialized_data);
 }
 
 int main(void)
 {
+    if (ssz_root_cache_init(&validator_root_cache, SIZE_VALIDATOR, 1 << 12) != SSZ_SUCCESS)
+    {
+        fprintf(stderr, "Failed to initialize the validator root cache\n");
+        return EXIT_FAILURE;
+    }
+    ssz_arena_init(&writer_arena, 1 << 20);
     DIR *dir = opendir(TESTS_DIR);
     if (!dir)
     {
         perror("opendir");
+        ssz_root_cache_free(&validator_root_cache);
+        ssz_arena_free(&writer_arena);
         return EXIT_FAILURE;
     }
     struct dirent *entry;
@@ -752,5 +1080,12 @@ int main(void)
         process_serialized_file(entry->d_name, folder_path, serialized_file_path, true);
     }
     closedir(dir);
+    uint64_t hits, misses;
+    size_t entries;
+    ssz_root_cache_stats(&validator_root_cache, &hits, &misses, &entries);
+    printf("Validator root cache: %llu hits, %llu misses, %zu entries\n",
+           (unsigned long long)hits, (unsigned long long)misses, entries);
+    ssz_root_cache_free(&validator_root_cache);
+    ssz_arena_free(&writer_arena);
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ssz_writer.h"
+#include "ssz_generator.h"
+#include "ssz_serialize.h"
+#include "ssz_constants.h"
+#include "ssz_types.h"
+
+#define SIZE_ROOT 32
+#define SIZE_CHECKPOINT (SSZ_BYTE_SIZE_OF_UINT64 + SIZE_ROOT)
+#define OUTPUT_SIZE 10000
+
+typedef struct
+{
+    uint64_t epoch;
+    uint8_t root[SIZE_ROOT];
+} Checkpoint;
+
+#define SERIALIZE_CHECKPOINT_FIELD                                                            \
+    SERIALIZE_BASIC_FIELD(obj, offset, epoch, SSZ_BYTE_SIZE_OF_UINT64, ssz_serialize_uint64); \
+    SERIALIZE_VECTOR_FIELD(obj, offset, root, SIZE_ROOT, ssz_serialize_vector_uint8);
+DEFINE_SERIALIZE_CONTAINER(Checkpoint, SERIALIZE_CHECKPOINT_FIELD);
+DEFINE_SSZ_SIZE_CONTAINER(Checkpoint, SIZE_CHECKPOINT, );
+DEFINE_SERIALIZE_WRITER(Checkpoint, serialize_Checkpoint, ssz_size_Checkpoint);
+
+static uint8_t expected[OUTPUT_SIZE];
+
+static void fill_expected(void)
+{
+    uint32_t seed = 7;
+    for (size_t i = 0; i < OUTPUT_SIZE; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        expected[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static bool write_in_pieces(ssz_writer_t *writer)
+{
+    size_t pos = 0;
+    size_t piece = 1;
+    while (pos < OUTPUT_SIZE)
+    {
+        size_t n = piece < OUTPUT_SIZE - pos ? piece : OUTPUT_SIZE - pos;
+        if (ssz_writer_write(writer, expected + pos, n) != SSZ_SUCCESS)
+        {
+            return false;
+        }
+        pos += n;
+        piece = piece * 3 % 257 + 1;
+    }
+    return ssz_writer_size(writer) == OUTPUT_SIZE;
+}
+
+static bool output_matches(const ssz_writer_t *writer)
+{
+    static uint8_t out[OUTPUT_SIZE];
+    size_t out_size = sizeof(out);
+    return ssz_writer_copy(writer, out, &out_size) == SSZ_SUCCESS && out_size == OUTPUT_SIZE &&
+           memcmp(out, expected, OUTPUT_SIZE) == 0;
+}
+
+static void test_writer_kinds(void)
+{
+    printf("\n--- Testing ssz_writer_t kinds ---\n");
+    ssz_arena_t arena;
+    ssz_arena_init(&arena, 4096);
+
+    printf("Testing a fixed writer fills its buffer and then fails...\n");
+    {
+        static uint8_t buf[OUTPUT_SIZE];
+        ssz_writer_t writer;
+        ssz_writer_init_fixed(&writer, buf, sizeof(buf));
+        bool ok = write_in_pieces(&writer) && output_matches(&writer) &&
+                  ssz_writer_data(&writer) == buf &&
+                  ssz_writer_put_uint32(&writer, 1) == SSZ_ERROR_SERIALIZATION &&
+                  ssz_writer_size(&writer) == OUTPUT_SIZE;
+        if (ok)
+        {
+            printf("  OK: Output written and overflow rejected.\n");
+        }
+        else
+        {
+            printf("  FAIL: Fixed writer misbehaved.\n");
+        }
+    }
+
+    printf("Testing a growable writer keeps its output contiguous...\n");
+    {
+        ssz_writer_t writer;
+        bool ok = ssz_writer_init_growable(&writer, &arena, 16) == SSZ_SUCCESS &&
+                  write_in_pieces(&writer) && output_matches(&writer) &&
+                  memcmp(ssz_writer_data(&writer), expected, OUTPUT_SIZE) == 0;
+        if (ok)
+        {
+            printf("  OK: Output grown and contiguous.\n");
+        }
+        else
+        {
+            printf("  FAIL: Growable writer output differs.\n");
+        }
+    }
+
+    printf("Testing a chunked writer and a patch across a chunk boundary...\n");
+    {
+        ssz_writer_t writer;
+        bool ok = ssz_writer_init_chunked(&writer, &arena, 100) == SSZ_SUCCESS &&
+                  write_in_pieces(&writer) && output_matches(&writer) &&
+                  ssz_writer_data(&writer) == NULL && writer.head != writer.tail;
+        if (ok)
+        {
+            const uint8_t patch[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+            size_t position = writer.head->length - 3;
+            ok = ssz_writer_patch(&writer, position, patch, sizeof(patch)) == SSZ_SUCCESS;
+            memcpy(expected + position, patch, sizeof(patch));
+            ok = ok && output_matches(&writer) &&
+                 ssz_writer_patch(&writer, OUTPUT_SIZE - 4, patch, sizeof(patch)) == SSZ_ERROR_OUT_OF_RANGE;
+            fill_expected();
+        }
+        if (ok)
+        {
+            printf("  OK: Chunked output and patch match.\n");
+        }
+        else
+        {
+            printf("  FAIL: Chunked writer output differs.\n");
+        }
+    }
+    ssz_arena_free(&arena);
+}
+
+typedef struct
+{
+    uint8_t out[OUTPUT_SIZE];
+    size_t length;
+    size_t calls;
+    size_t largest_write;
+} Collector;
+
+static ssz_error_t collect_write(void *ctx, const uint8_t *bytes, size_t len)
+{
+    Collector *collector = ctx;
+    if (len > OUTPUT_SIZE - collector->length)
+    {
+        return SSZ_ERROR_SERIALIZATION;
+    }
+    memcpy(collector->out + collector->length, bytes, len);
+    collector->length += len;
+    collector->calls++;
+    collector->largest_write = len > collector->largest_write ? len : collector->largest_write;
+    return SSZ_SUCCESS;
+}
+
+static void test_writer_stream(void)
+{
+    printf("\n--- Testing stream ssz_writer_t ---\n");
+
+    printf("Testing a stream writer passes its output on in bounded chunks...\n");
+    {
+        static Collector collector;
+        uint8_t buf[100];
+        ssz_writer_t writer;
+        ssz_writer_init_stream(&writer, buf, sizeof(buf), collect_write, &collector);
+        const uint8_t patch[4] = {9, 9, 9, 9};
+        bool ok = write_in_pieces(&writer) &&
+                  ssz_writer_patch(&writer, 0, patch, sizeof(patch)) == SSZ_ERROR_OUT_OF_RANGE &&
+                  ssz_writer_data(&writer) == NULL && ssz_writer_reserve(&writer, sizeof(buf) + 1) == NULL &&
+                  ssz_writer_flush(&writer) == SSZ_SUCCESS && collector.length == OUTPUT_SIZE &&
+                  collector.largest_write <= sizeof(buf) && memcmp(collector.out, expected, OUTPUT_SIZE) == 0;
+        if (ok)
+        {
+            printf("  OK: %zu bytes in %zu writes of at most %zu bytes.\n", collector.length, collector.calls,
+                   collector.largest_write);
+        }
+        else
+        {
+            printf("  FAIL: Streamed output differs.\n");
+        }
+    }
+
+    printf("Testing the file descriptor sink...\n");
+    {
+        static uint8_t readback[OUTPUT_SIZE + 1];
+        uint8_t buf[256];
+        FILE *fp = tmpfile();
+        int fd = fp != NULL ? fileno(fp) : -1;
+        ssz_writer_t writer;
+        ssz_writer_init_stream(&writer, buf, sizeof(buf), ssz_write_fd, &fd);
+        bool ok = fp != NULL && write_in_pieces(&writer) && ssz_writer_flush(&writer) == SSZ_SUCCESS;
+        if (ok)
+        {
+            rewind(fp);
+            ok = fread(readback, 1, sizeof(readback), fp) == OUTPUT_SIZE &&
+                 memcmp(readback, expected, OUTPUT_SIZE) == 0;
+        }
+        if (fp != NULL)
+        {
+            fclose(fp);
+        }
+        if (ok)
+        {
+            printf("  OK: File contents match.\n");
+        }
+        else
+        {
+            printf("  FAIL: File contents differ.\n");
+        }
+    }
+}
+
+static void test_writer_steady_state(void)
+{
+    printf("\n--- Testing generated writers on a reused arena ---\n");
+
+    printf("Testing repeated serialization allocates no new blocks...\n");
+    ssz_arena_t arena;
+    ssz_arena_init(&arena, 1024);
+    size_t blocks_after_first = 0;
+    bool ok = true;
+    for (int round = 0; round < 4 && ok; round++)
+    {
+        ssz_arena_reset(&arena);
+        ssz_writer_t writer;
+        ok = ssz_writer_init_growable(&writer, &arena, 64) == SSZ_SUCCESS;
+        for (uint64_t i = 0; i < 100 && ok; i++)
+        {
+            Checkpoint checkpoint;
+            checkpoint.epoch = i;
+            memset(checkpoint.root, (int)i, SIZE_ROOT);
+            ok = serialize_Checkpoint_to_writer(&checkpoint, &writer) == SSZ_SUCCESS;
+        }
+        const uint8_t *out = ssz_writer_data(&writer);
+        ok = ok && ssz_writer_size(&writer) == 100 * SIZE_CHECKPOINT &&
+             ssz_load_le64(out + 99 * SIZE_CHECKPOINT) == 99 && out[99 * SIZE_CHECKPOINT + 8] == 99;
+        if (round == 0)
+        {
+            blocks_after_first = arena.block_count;
+        }
+        ok = ok && arena.block_count == blocks_after_first;
+    }
+    ssz_arena_free(&arena);
+    if (ok)
+    {
+        printf("  OK: %zu blocks allocated in the first round and reused afterwards.\n", blocks_after_first);
+    }
+    else
+    {
+        printf("  FAIL: Generated writer output differs or the arena grew after the first round.\n");
+    }
+}
+
+int main(void)
+{
+    fill_expected();
+    test_writer_kinds();
+    test_writer_stream();
+    test_writer_steady_state();
+
+    return 0;
+}